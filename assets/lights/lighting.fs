@@ -4,20 +4,63 @@
 // ================================================
 #version 330
 
+// Variant defines (injected after #version by render/shaders.c):
+//   HIT_TINT         - multiply by the draw tint (colDiffuse), e.g. red on hit.
+//   UNLIT            - texture times vertex color (white unless lighting was
+//                      baked into the mesh), no lighting terms.
+//   N_POINT_LIGHTS n - number of point lights picked per object on the CPU
+//                      (see render/lights.c); 0 when not defined.
+#ifndef N_POINT_LIGHTS
+#define N_POINT_LIGHTS 0
+#endif
+
 in vec3 fragPosition;
 in vec3 fragNormal;
 in vec2 fragTexCoord;
+#ifdef UNLIT
+in vec4 fragColor;
+#endif
 
 out vec4 finalColor;
 
 uniform sampler2D texture0;
+#ifdef HIT_TINT
+uniform vec4 colDiffuse;
+#endif
+#ifndef UNLIT
 uniform vec4 ambient;
+uniform vec3 lightDirection;
+#endif
+#if N_POINT_LIGHTS > 0
+uniform vec4 pointLightPosition[N_POINT_LIGHTS]; // xyz position, w radius
+uniform vec4 pointLightColor[N_POINT_LIGHTS];    // rgb color * intensity
+#endif
 
 void main() {
+    vec4 texColor = texture(texture0, fragTexCoord);
+
+#ifdef UNLIT
+    finalColor = texColor * fragColor;
+#else
     vec3 norm = normalize(fragNormal);
-    vec3 lightDir = normalize(vec3(-0.5, -1.0, -0.3));
+    vec3 lightDir = normalize(lightDirection);
     float diff = max(dot(norm, -lightDir), 0.0);
 
-    vec4 texColor = texture(texture0, fragTexCoord);
-    finalColor = texColor * (ambient + vec4(vec3(diff), 1.0));
+    vec3 point = vec3(0.0);
+#if N_POINT_LIGHTS > 0
+    for (int i = 0; i < N_POINT_LIGHTS; i++) {
+        vec3 toLight = pointLightPosition[i].xyz - fragPosition;
+        float dist = length(toLight);
+        float falloff = clamp(1.0 - dist / pointLightPosition[i].w, 0.0, 1.0);
+        float lambert = max(dot(norm, toLight / max(dist, 1e-4)), 0.0);
+        point += pointLightColor[i].rgb * lambert * falloff * falloff;
+    }
+#endif
+
+    finalColor = texColor * (ambient + vec4(vec3(diff) + point, 1.0));
+#endif
+
+#ifdef HIT_TINT
+    finalColor *= colDiffuse;
+#endif
 }
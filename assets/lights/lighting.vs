@@ -1,20 +1,43 @@
-
 #version 330
 
+// Variant defines (injected after #version by render/shaders.c):
+//   INSTANCED - per-instance transform attribute instead of matModel.
+//   UNLIT     - pass vertex colors through (baked lighting, see models.c).
+
 in vec3 vertexPosition;
 in vec3 vertexNormal;
 in vec2 vertexTexCoord;
+#ifdef UNLIT
+in vec4 vertexColor;
+#endif
+#ifdef INSTANCED
+in mat4 instanceTransform;
+#endif
 
 out vec3 fragPosition;
 out vec3 fragNormal;
 out vec2 fragTexCoord;
+#ifdef UNLIT
+out vec4 fragColor;
+#endif
 
 uniform mat4 mvp;
+#ifndef INSTANCED
 uniform mat4 matModel;
+#endif
 
 void main() {
-    fragPosition = vec3(matModel * vec4(vertexPosition, 1.0));
-    fragNormal = mat3(transpose(inverse(matModel))) * vertexNormal;
-    fragTexCoord = vertexTexCoord;
+#ifdef INSTANCED
+    mat4 model = instanceTransform;
+    gl_Position = mvp * instanceTransform * vec4(vertexPosition, 1.0);
+#else
+    mat4 model = matModel;
     gl_Position = mvp * vec4(vertexPosition, 1.0);
+#endif
+    fragPosition = vec3(model * vec4(vertexPosition, 1.0));
+    fragNormal = mat3(transpose(inverse(model))) * vertexNormal;
+    fragTexCoord = vertexTexCoord;
+#ifdef UNLIT
+    fragColor = vertexColor;
+#endif
 }
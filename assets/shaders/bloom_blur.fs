@@ -0,0 +1,24 @@
+#version 330
+
+// One direction of a separable 9-tap gaussian blur. Taps are placed between
+// texels so bilinear filtering folds them into 5 fetches.
+
+in vec2 fragTexCoord;
+
+out vec4 finalColor;
+
+uniform sampler2D texture0;
+uniform vec2 direction; // texel size along the blur axis
+
+const float offsets[3] = float[](0.0, 1.3846153846, 3.2307692308);
+const float weights[3] = float[](0.2270270270, 0.3162162162, 0.0702702703);
+
+void main() {
+    vec3 color = texture(texture0, fragTexCoord).rgb * weights[0];
+    for (int i = 1; i < 3; i++) {
+        vec2 offset = direction * offsets[i];
+        color += texture(texture0, fragTexCoord + offset).rgb * weights[i];
+        color += texture(texture0, fragTexCoord - offset).rgb * weights[i];
+    }
+    finalColor = vec4(color, 1.0);
+}
@@ -0,0 +1,17 @@
+#version 330
+
+// Adds the accumulated bloom chain on top of the scene.
+
+in vec2 fragTexCoord;
+
+out vec4 finalColor;
+
+uniform sampler2D texture0;    // scene
+uniform sampler2D bloomTexture; // blurred highlights, same orientation
+uniform float intensity;
+
+void main() {
+    vec3 scene = texture(texture0, fragTexCoord).rgb;
+    vec3 bloom = texture(bloomTexture, fragTexCoord).rgb;
+    finalColor = vec4(scene + bloom * intensity, 1.0);
+}
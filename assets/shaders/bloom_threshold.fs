@@ -0,0 +1,21 @@
+#version 330
+
+// Bright pass: keeps the part of each pixel above the threshold, with a soft
+// knee so highlights fade in instead of popping.
+
+in vec2 fragTexCoord;
+
+out vec4 finalColor;
+
+uniform sampler2D texture0;
+uniform float threshold;
+uniform float knee;
+
+void main() {
+    vec3 color = texture(texture0, fragTexCoord).rgb;
+    float brightness = max(color.r, max(color.g, color.b));
+    float soft = clamp(brightness - threshold + knee, 0.0, 2.0 * knee);
+    soft = soft * soft / (4.0 * knee + 1e-4);
+    float contribution = max(soft, brightness - threshold) / max(brightness, 1e-4);
+    finalColor = vec4(color * contribution, 1.0);
+}
@@ -0,0 +1,54 @@
+#version 330
+
+// Effects composite: upsamples the reduced-resolution effects (colour in rgb,
+// transmittance of the scene behind in alpha) over the full-resolution scene.
+// Where the four effects pixels around a scene pixel lie at about its depth
+// they are filtered bilinearly; across a silhouette the one nearest in depth
+// is taken instead, so effects behind a ship do not bleed over its edge.
+
+out vec4 finalColor;
+
+uniform sampler2D sceneColor;
+uniform sampler2D sceneDepth;
+uniform sampler2D effectsColor;
+uniform sampler2D effectsDepth;
+uniform int blockSize;    // scene pixels per effects pixel, per axis
+uniform vec2 clipPlanes;  // near, far
+
+// Linear view depth of a [0, 1] depth buffer value
+float viewDepth(float d) {
+    return clipPlanes.x * clipPlanes.y /
+           (clipPlanes.y - d * (clipPlanes.y - clipPlanes.x));
+}
+
+void main() {
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    vec3 scene = texelFetch(sceneColor, pixel, 0).rgb;
+    float depth = viewDepth(texelFetch(sceneDepth, pixel, 0).r);
+
+    ivec2 size = textureSize(effectsColor, 0);
+    vec2 at = gl_FragCoord.xy / float(blockSize) - 0.5;
+    ivec2 i0 = clamp(ivec2(floor(at)), ivec2(0), size - 1);
+    ivec2 i1 = min(i0 + 1, size - 1);
+    vec2 f = clamp(at - floor(at), 0.0, 1.0);
+    ivec2 taps[4] = ivec2[4](i0, ivec2(i1.x, i0.y), ivec2(i0.x, i1.y), i1);
+    float weights[4] = float[4]((1.0 - f.x) * (1.0 - f.y), f.x * (1.0 - f.y),
+                                (1.0 - f.x) * f.y, f.x * f.y);
+
+    vec4 blended = vec4(0.0);
+    vec4 nearest = vec4(0.0, 0.0, 0.0, 1.0);
+    float best = 1e30;
+    float spread = 0.0;
+    for (int i = 0; i < 4; i++) {
+        vec4 fx = texelFetch(effectsColor, taps[i], 0);
+        float gap = abs(viewDepth(texelFetch(effectsDepth, taps[i], 0).r) - depth);
+        blended += fx * weights[i];
+        spread = max(spread, gap);
+        if (gap < best) {
+            best = gap;
+            nearest = fx;
+        }
+    }
+    vec4 fx = spread < 0.05 * depth ? blended : nearest;
+    finalColor = vec4(scene * fx.a + fx.rgb, 1.0);
+}
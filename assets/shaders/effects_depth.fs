@@ -0,0 +1,26 @@
+#version 330
+
+// Effects depth: each reduced-resolution pixel takes the farthest scene depth
+// of the block of full-resolution pixels it covers, so a particle is only
+// rejected where the whole block is hidden; the composite sorts out the
+// edges. Also clears the effects colour to "nothing drawn": black with full
+// transmittance.
+
+out vec4 finalColor;
+
+uniform sampler2D sceneDepth;
+uniform int blockSize; // scene pixels per effects pixel, per axis
+
+void main() {
+    ivec2 size = textureSize(sceneDepth, 0);
+    ivec2 base = ivec2(gl_FragCoord.xy) * blockSize;
+    float depth = 0.0;
+    for (int y = 0; y < blockSize; y++) {
+        for (int x = 0; x < blockSize; x++) {
+            ivec2 at = min(base + ivec2(x, y), size - 1);
+            depth = max(depth, texelFetch(sceneDepth, at, 0).r);
+        }
+    }
+    gl_FragDepth = depth;
+    finalColor = vec4(0.0, 0.0, 0.0, 1.0);
+}
@@ -0,0 +1,11 @@
+#version 330
+
+// Overdraw count: every fragment adds one layer to the red channel, whatever
+// its texture or colour. Drawn with additive blending into a half-float
+// target, so the result is the number of blended fragments per pixel.
+
+out vec4 finalColor;
+
+void main() {
+    finalColor = vec4(1.0, 0.0, 0.0, 1.0);
+}
@@ -0,0 +1,26 @@
+#version 330
+
+// Overdraw heat map: maps the layer count in the red channel to a colour
+// ramp, black (nothing drawn) through blue, cyan, green, yellow and red to
+// white at maxLayers and above.
+
+in vec2 fragTexCoord;
+
+out vec4 finalColor;
+
+uniform sampler2D texture0; // layer counts
+uniform float maxLayers;
+
+const vec3 RAMP[6] = vec3[6](vec3(0.0, 0.0, 0.0), vec3(0.0, 0.2, 1.0),
+                             vec3(0.0, 0.9, 0.9), vec3(0.1, 0.9, 0.1),
+                             vec3(1.0, 0.9, 0.0), vec3(1.0, 0.1, 0.0));
+
+void main() {
+    float layers = texture(texture0, fragTexCoord).r;
+    float t = clamp(layers / maxLayers, 0.0, 1.0) * 5.0;
+    int i = min(int(t), 4);
+    vec3 color = mix(RAMP[i], RAMP[i + 1], t - float(i));
+    // Past the end of the ramp the red fades to white
+    color = mix(color, vec3(1.0), clamp(layers / maxLayers - 1.0, 0.0, 1.0));
+    finalColor = vec4(color, 1.0);
+}
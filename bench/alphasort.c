@@ -0,0 +1,129 @@
+/**
+ * @file alphasort.c
+ * @brief Benchmark of the alpha particle depth sort (see alphaqueue.h).
+ */
+#include "bench.h"
+#include "../src/render/alphaqueue.h"
+#include "../src/utils/arena.h"
+#include "raylib.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// Sorts timed per benchmark size; the best run is reported.
+#define ALPHA_SORT_BENCH_RUNS 20
+
+/**
+ * @brief qsort comparator on the depth key, for the benchmark baseline.
+ */
+static int compareSortKeys(const void *a, const void *b)
+{
+  uint64_t ka = *(const uint64_t *)a >> 32;
+  uint64_t kb = *(const uint64_t *)b >> 32;
+  return (ka > kb) - (ka < kb);
+}
+
+/**
+ * @brief Times the depth sort at 10k and 100k particles against qsort and
+ * logs the results.
+ *
+ * The full sort (keys and radix passes) is timed through alphaQueueSort; the
+ * radix and qsort passes alone are timed on copies of the same keys in
+ * submission order.
+ *
+ * @return False when the buffers could not be allocated.
+ */
+bool benchAlphaSort(void)
+{
+  const size_t sizes[] = {10000, 100000};
+  const Camera3D camera = {.position = (Vector3){0.0f, 80.0f, 40.0f},
+                           .target = (Vector3){0.0f, 0.0f, 0.0f},
+                           .up = (Vector3){0.0f, 1.0f, 0.0f},
+                           .fovy = 45.0f,
+                           .projection = CAMERA_PERSPECTIVE};
+  srand(1);
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+  {
+    size_t n = sizes[s];
+    AlphaParticleQueue *queue = newAlphaParticleQueue(n);
+    uint64_t *keys = malloc(n * sizeof(uint64_t));
+    uint64_t *values = malloc(n * sizeof(uint64_t));
+    uint64_t *scratch = malloc(n * sizeof(uint64_t));
+    if (!queue || !keys || !values || !scratch)
+    {
+      destroyAlphaParticleQueue(queue);
+      free(keys);
+      free(values);
+      free(scratch);
+      TraceLog(LOG_ERROR, "[Bench] alpha sort out of memory");
+      return false;
+    }
+    alphaQueueBegin(queue, &camera);
+    for (size_t i = 0; i < n; i++)
+    {
+      Vector3 position = {(float)(rand() % 2000) / 10.0f - 100.0f,
+                          (float)(rand() % 400) / 10.0f - 40.0f,
+                          (float)(rand() % 2000) / 10.0f - 100.0f};
+      alphaQueuePush(queue, 0, position, (Vector2){1.0f, 1.0f}, 0.0f,
+                     (Rectangle){0, 0, 1, 1}, WHITE);
+    }
+
+    double full_ms = 0.0;
+    double radix_ms = 0.0;
+    double qsort_ms = 0.0;
+    for (int run = 0; run < ALPHA_SORT_BENCH_RUNS; run++)
+    {
+      // Every run is a frame: the key buffers come from the frame arena
+      frameArenaBegin();
+      double start = benchNowMs();
+      bool sorted = alphaQueueSort(queue);
+      double elapsed = benchNowMs() - start;
+      if (!sorted)
+      {
+        TraceLog(LOG_ERROR, "[Bench] frame arena too small for %zu keys", n);
+        destroyAlphaParticleQueue(queue);
+        free(keys);
+        free(values);
+        free(scratch);
+        return false;
+      }
+      full_ms = run == 0 || elapsed < full_ms ? elapsed : full_ms;
+
+      // Same keys back in submission order, sorted by each algorithm
+      for (size_t i = 0; i < n; i++)
+      {
+        keys[(uint32_t)queue->sort[i]] = queue->sort[i];
+      }
+      memcpy(values, keys, n * sizeof(uint64_t));
+      start = benchNowMs();
+      alphaQueueRadixSort(values, scratch, n);
+      elapsed = benchNowMs() - start;
+      radix_ms = run == 0 || elapsed < radix_ms ? elapsed : radix_ms;
+
+      memcpy(values, keys, n * sizeof(uint64_t));
+      start = benchNowMs();
+      qsort(values, n, sizeof(uint64_t), compareSortKeys);
+      elapsed = benchNowMs() - start;
+      qsort_ms = run == 0 || elapsed < qsort_ms ? elapsed : qsort_ms;
+    }
+    bool ordered = true;
+    for (size_t i = 1; i < n; i++)
+    {
+      if ((queue->sort[i - 1] >> 32) > (queue->sort[i] >> 32))
+      {
+        ordered = false;
+        break;
+      }
+    }
+    TraceLog(LOG_INFO,
+             "[Bench] %zu particles: sort with keys %.3f ms, radix %.3f ms, "
+             "qsort %.3f ms%s",
+             n, full_ms, radix_ms, qsort_ms,
+             ordered ? "" : " (radix order WRONG)");
+    destroyAlphaParticleQueue(queue);
+    free(keys);
+    free(values);
+    free(scratch);
+  }
+  return true;
+}
@@ -0,0 +1,83 @@
+#define _POSIX_C_SOURCE 200809L
+/**
+ * @file bench.c
+ * @brief Entry point of ceelaxy-bench: runs the benchmarks named on the
+ * command line, or all of them.
+ *
+ * Usage: ceelaxy-bench [alpha-sort] [particles] [units] [math]
+ */
+#include "bench.h"
+#include "../src/utils/arena.h"
+#include "raylib.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @brief A benchmark selectable by name.
+ */
+typedef struct BenchEntry
+{
+  const char *name;  /// Name given on the command line.
+  bool (*run)(void); /// Runner; false fails the whole run.
+} BenchEntry;
+
+/**
+ * @brief Returns a monotonic timestamp in milliseconds.
+ */
+double benchNowMs(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1.0e6;
+}
+
+/// Benchmarks in the order they run.
+static const BenchEntry BENCHES[] = {
+    {"alpha-sort", benchAlphaSort},
+    {"particles", benchParticles},
+    {"units", benchUnits},
+    {"math", benchMath},
+};
+
+/// Number of entries in BENCHES.
+#define BENCH_COUNT (sizeof(BENCHES) / sizeof(BENCHES[0]))
+
+int main(int argc, char *argv[])
+{
+  bool selected[BENCH_COUNT] = {false};
+  for (int i = 1; i < argc; i++)
+  {
+    bool known = false;
+    for (size_t b = 0; b < BENCH_COUNT; b++)
+    {
+      if (strcmp(argv[i], BENCHES[b].name) == 0)
+      {
+        selected[b] = true;
+        known = true;
+      }
+    }
+    if (!known)
+    {
+      TraceLog(LOG_ERROR,
+               "[Bench] unknown benchmark \"%s\" (alpha-sort, particles, "
+               "units, math)",
+               argv[i]);
+      return 2;
+    }
+  }
+
+  // The alpha sort takes its key buffers from the frame arena, as in game.
+  frameArenaInit(FRAME_ARENA_BUDGET, 1);
+  bool ok = true;
+  for (size_t b = 0; b < BENCH_COUNT; b++)
+  {
+    if (argc == 1 || selected[b])
+    {
+      ok = BENCHES[b].run() && ok;
+    }
+  }
+  frameArenaShutdown();
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,54 @@
+/**
+ * @file bench.h
+ * @brief Declares the micro-benchmarks and self-checks built into
+ * ceelaxy-bench (make bench).
+ *
+ * Each runner links the game modules it measures, needs no window and logs
+ * its results through TraceLog.
+ */
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdbool.h>
+
+/**
+ * @brief Returns a monotonic timestamp in milliseconds.
+ */
+double benchNowMs(void);
+
+/**
+ * @brief Times the alpha particle depth sort at 10k and 100k particles
+ * against qsort.
+ *
+ * @return False when the buffers could not be allocated.
+ */
+bool benchAlphaSort(void);
+
+/**
+ * @brief Simulates many simultaneous explosions and logs the particle
+ * memory footprint, update time and cache misses for the compact layout
+ * against the previous full-float one.
+ *
+ * @return False when the emitters could not be allocated.
+ */
+bool benchParticles(void);
+
+/**
+ * @brief Runs a collision-style pass over many units and logs the time per
+ * pass for the hot/cold split against the previous linked list of whole
+ * units.
+ *
+ * @return False when the unit tables could not be allocated.
+ */
+bool benchUnits(void);
+
+/**
+ * @brief Compares the vector math layer with raymath on random inputs, logs
+ * the largest errors and times the bounding box helper against the raymath
+ * version.
+ *
+ * @return True when every error is within tolerance.
+ */
+bool benchMath(void);
+
+#endif
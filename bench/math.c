@@ -0,0 +1,172 @@
+/**
+ * @file math.c
+ * @brief Self-check of the vector math layer (see vecmath.h) against
+ * raymath.
+ */
+#include "bench.h"
+#include "../src/utils/vecmath.h"
+#include "raylib.h"
+#include <raymath.h>
+#include <stdint.h>
+
+/// Random cases compared per function.
+#define VECMATH_CHECK_CASES 100000
+
+/// Largest error accepted, relative to the magnitude of the result.
+#define VECMATH_CHECK_TOLERANCE 1e-5f
+
+/**
+ * @brief Returns a value in [min, max) from a private generator, so the
+ * check never touches the game's random sequence.
+ */
+static float checkRandom(uint32_t *state, float min, float max)
+{
+  *state = *state * 1664525u + 1013904223u;
+  return min + (max - min) * (float)(*state >> 8) / 16777216.0f;
+}
+
+/**
+ * @brief Error of a against the reference b, relative to the magnitude of
+ * b (absolute below 1).
+ */
+static float checkError(Vector3 a, Vector3 b)
+{
+  float scale = fmaxf(1.0f, fmaxf(fabsf(b.x), fmaxf(fabsf(b.y), fabsf(b.z))));
+  float error =
+      fmaxf(fabsf(a.x - b.x), fmaxf(fabsf(a.y - b.y), fabsf(a.z - b.z)));
+  return error / scale;
+}
+
+/**
+ * @brief Box of eight transformed corners, as the game computed it with
+ * raymath.
+ */
+static BoundingBox checkCornerBox(Matrix m, Vector3 min, Vector3 max)
+{
+  BoundingBox box = {Vector3Transform(min, m), Vector3Transform(min, m)};
+  for (int i = 1; i < 8; i++)
+  {
+    Vector3 corner = {(i & 4) ? max.x : min.x, (i & 2) ? max.y : min.y,
+                      (i & 1) ? max.z : min.z};
+    Vector3 p = Vector3Transform(corner, m);
+    box.min = Vector3Min(box.min, p);
+    box.max = Vector3Max(box.max, p);
+  }
+  return box;
+}
+
+/**
+ * @brief Compares the layer with raymath on random inputs, logs the largest
+ * errors and times the bounding box helper against the raymath version.
+ *
+ * @return True when every error is within tolerance.
+ */
+bool benchMath(void)
+{
+  uint32_t seed = 12345u;
+  float err_point = 0.0f;
+  float err_compose = 0.0f;
+  float err_xyz = 0.0f;
+  float err_box = 0.0f;
+  float err_madd = 0.0f;
+  for (int i = 0; i < VECMATH_CHECK_CASES; i++)
+  {
+    float rx = checkRandom(&seed, -PI, PI);
+    float ry = checkRandom(&seed, -PI, PI);
+    float rz = checkRandom(&seed, -PI, PI);
+    Vector3 t = {checkRandom(&seed, -100, 100), checkRandom(&seed, -100, 100),
+                 checkRandom(&seed, -100, 100)};
+    Vector3 p = {checkRandom(&seed, -10, 10), checkRandom(&seed, -10, 10),
+                 checkRandom(&seed, -10, 10)};
+
+    // Unit bounding box chain: rotate X, then Z, then Y, then translate
+    Matrix ref = MatrixMultiply(
+        MatrixMultiply(MatrixMultiply(MatrixRotateX(rx), MatrixRotateZ(rz)),
+                       MatrixRotateY(ry)),
+        MatrixTranslate(t.x, t.y, t.z));
+    AffineMatrix rot_x = affineRotateX(rx);
+    AffineMatrix rot_z = affineRotateZ(rz);
+    AffineMatrix rot_y = affineRotateY(ry);
+    AffineMatrix move = affineTranslate(t);
+    AffineMatrix xz = affineThen(&rot_x, &rot_z);
+    AffineMatrix xzy = affineThen(&xz, &rot_y);
+    AffineMatrix m = affineThen(&xzy, &move);
+    Vector3 got;
+    affineTransformPoints(&m, &p, &got, 1);
+    Vector3 want = Vector3Transform(p, ref);
+    err_compose = fmaxf(err_compose, checkError(got, want));
+
+    affineTransformPoints(&rot_x, &p, &got, 1);
+    want = Vector3Transform(p, MatrixRotateX(rx));
+    err_point = fmaxf(err_point, checkError(got, want));
+
+    Vector3 angles = {rx, ry, rz};
+    AffineMatrix xyz = affineRotateXYZ(angles);
+    affineTransformPoints(&xyz, &p, &got, 1);
+    want = Vector3Transform(p, MatrixRotateXYZ(angles));
+    err_xyz = fmaxf(err_xyz, checkError(got, want));
+
+    Vector3 half = {checkRandom(&seed, 0.1f, 5), checkRandom(&seed, 0.1f, 5),
+                    checkRandom(&seed, 0.1f, 5)};
+    Vector3 lo = Vector3Negate(half);
+    BoundingBox box = affineTransformBox(&m, lo, half);
+    BoundingBox box_ref = checkCornerBox(ref, lo, half);
+    err_box = fmaxf(err_box, fmaxf(checkError(box.min, box_ref.min),
+                                   checkError(box.max, box_ref.max)));
+
+    float dt = checkRandom(&seed, 0.0f, 0.05f);
+    Vector3 sum = vec4ToVector3(vec4MulAdd(
+        vec4FromVector3(p, 0.0f), vec4Splat(dt), vec4FromVector3(t, 0.0f)));
+    err_madd = fmaxf(err_madd,
+                     checkError(sum, Vector3Add(t, Vector3Scale(p, dt))));
+  }
+
+  // Time the unit bounding box: eight raymath transforms against the helper
+  const int rounds = 1000000;
+  Vector3 lo = {-2.0f, -0.75f, -2.0f};
+  Vector3 hi = {2.0f, 0.75f, 2.0f};
+  float sink = 0.0f;
+  double start = benchNowMs();
+  for (int i = 0; i < rounds; i++)
+  {
+    float a = (float)i * 1e-4f;
+    Matrix ref = MatrixMultiply(
+        MatrixMultiply(MatrixMultiply(MatrixRotateX(a), MatrixRotateZ(a)),
+                       MatrixRotateY(a)),
+        MatrixTranslate(a, 0.0f, a));
+    sink += checkCornerBox(ref, lo, hi).max.x;
+  }
+  double raymath_ms = benchNowMs() - start;
+  start = benchNowMs();
+  for (int i = 0; i < rounds; i++)
+  {
+    float a = (float)i * 1e-4f;
+    AffineMatrix rot_x = affineRotateX(a);
+    AffineMatrix rot_z = affineRotateZ(a);
+    AffineMatrix rot_y = affineRotateY(a);
+    AffineMatrix move = affineTranslate((Vector3){a, 0.0f, a});
+    AffineMatrix xz = affineThen(&rot_x, &rot_z);
+    AffineMatrix xzy = affineThen(&xz, &rot_y);
+    AffineMatrix m = affineThen(&xzy, &move);
+    sink += affineTransformBox(&m, lo, hi).max.x;
+  }
+  double layer_ms = benchNowMs() - start;
+
+  bool ok = err_point <= VECMATH_CHECK_TOLERANCE &&
+            err_compose <= VECMATH_CHECK_TOLERANCE &&
+            err_xyz <= VECMATH_CHECK_TOLERANCE &&
+            err_box <= VECMATH_CHECK_TOLERANCE &&
+            err_madd <= VECMATH_CHECK_TOLERANCE;
+  TraceLog(LOG_INFO, "[Bench] %s layer, %d cases per function",
+           VECMATH_SIMD_NAME, VECMATH_CHECK_CASES);
+  TraceLog(LOG_INFO,
+           "[Bench] max relative error: point %.2e, compose %.2e, "
+           "rotateXYZ %.2e, box %.2e, mul-add %.2e",
+           err_point, err_compose, err_xyz, err_box, err_madd);
+  TraceLog(LOG_INFO,
+           "[Bench] unit bounding box: raymath %.1f ns, layer %.1f ns (%.3g)",
+           raymath_ms * 1.0e6 / rounds, layer_ms * 1.0e6 / rounds, sink);
+  TraceLog(ok ? LOG_INFO : LOG_ERROR, "[Bench] self-check %s",
+           ok ? "passed" : "FAILED");
+  return ok;
+}
@@ -0,0 +1,180 @@
+/**
+ * @file particles.c
+ * @brief Benchmark of the compact explosion particle layout (see
+ * explosion.h) against the full-float layout it replaced.
+ */
+#include "bench.h"
+#include "../src/render/particlelod.h"
+#include "../src/units/explosion.h"
+#include "../src/utils/packed.h"
+#include "../src/utils/profiler.h"
+#include "raylib.h"
+#include "raymath.h"
+#include <stdlib.h>
+
+/// Explosions burning at once in the benchmark.
+#define PARTICLE_BENCH_EXPLOSIONS 128
+
+/// Simulated frames per benchmark run (one second at 60 FPS, while the
+/// smoke of the bursts is still alive).
+#define PARTICLE_BENCH_FRAMES 60
+
+/**
+ * @brief Full-float particle layout the compact ExpParticle replaced (48
+ * bytes); kept as the benchmark baseline.
+ */
+typedef struct
+{
+  Vector3 pos, vel;
+  float size, rot;
+  float life, ttl;
+  ExpKind kind;
+  Color color;
+} ExpParticleFloat;
+
+/**
+ * @brief Baseline emitter holding full-float particles.
+ */
+typedef struct
+{
+  ExpParticleFloat p[EXP_MAX];
+  int count;
+} ExpFloatEmitter;
+
+/**
+ * @brief bulletExplosionUpdate on the full-float layout, same math.
+ *
+ * @param f Baseline particles.
+ * @param e Explosion supplying the simulation parameters.
+ * @param dt Time step in seconds.
+ * @param drift Scene back drift velocity.
+ */
+static void expFloatUpdate(ExpFloatEmitter *f, const BulletExplosion *e,
+                           float dt, Vector3 drift)
+{
+  int w = 0;
+  for (int r = 0; r < f->count; ++r)
+  {
+    ExpParticleFloat *q = &f->p[r];
+    q->vel.y += e->gravityY * dt;
+    q->vel = Vector3Scale(q->vel, e->damping);
+    q->vel = Vector3Add(q->vel, Vector3Scale(drift, dt));
+    q->pos = Vector3Add(q->pos, Vector3Scale(q->vel, dt));
+    if (q->kind == EXP_SMOKE)
+      q->size += 0.35f * dt;
+    if (q->kind == EXP_FIRE)
+      q->size -= 0.15f * dt;
+    q->life -= dt;
+    if (q->life > 0)
+    {
+      q->color = expParticleColor(q->kind, 1.0f - (q->life / q->ttl));
+      f->p[w++] = *q;
+    }
+  }
+  f->count = w;
+}
+
+/**
+ * @brief Simulates many simultaneous explosions without a window and logs
+ * the particle memory footprint, update time and cache misses for the
+ * compact layout against the previous full-float one.
+ *
+ * @return False when the emitters could not be allocated.
+ */
+bool benchParticles(void)
+{
+  const Camera3D camera = {.position = (Vector3){0.0f, 80.0f, 40.0f},
+                           .target = (Vector3){0.0f, 0.0f, 0.0f},
+                           .up = (Vector3){0.0f, 1.0f, 0.0f},
+                           .fovy = 45.0f,
+                           .projection = CAMERA_PERSPECTIVE};
+  const float dt = 1.0f / 60.0f;
+  BulletExplosion *compact =
+      calloc(PARTICLE_BENCH_EXPLOSIONS, sizeof(BulletExplosion));
+  ExpFloatEmitter *full =
+      calloc(PARTICLE_BENCH_EXPLOSIONS, sizeof(ExpFloatEmitter));
+  if (!compact || !full)
+  {
+    free(compact);
+    free(full);
+    TraceLog(LOG_ERROR, "[Bench] particles out of memory");
+    return false;
+  }
+
+  // Full bursts everywhere: the distance LOD would thin them out
+  bool lod = is_particle_lod_enabled;
+  is_particle_lod_enabled = false;
+  int particles = 0;
+  for (int i = 0; i < PARTICLE_BENCH_EXPLOSIONS; i++)
+  {
+    Vector3 origin = {(float)(i % 16) * 6.0f - 45.0f, 0.0f,
+                      (float)(i / 16) * 6.0f - 21.0f};
+    compact[i] = newBulletExplosion((Texture2D){0}, (Rectangle){0},
+                                    (Rectangle){0}, (Rectangle){0});
+    bulletExplosionSpawnAt(&compact[i], origin, &camera);
+    compact[i].active = true;
+    for (int k = 0; k < compact[i].count; k++)
+    {
+      const ExpParticle *q = &compact[i].p[k];
+      float motion[4];
+      halfToFloat4(q->motion, motion);
+      float ttl = halfToFloat(q->ttl);
+      ExpParticleFloat *f = &full[i].p[k];
+      f->pos = q->pos;
+      f->vel = (Vector3){motion[0], motion[1], motion[2]};
+      f->size = motion[3];
+      f->rot = unpackRotation(q->rot);
+      f->life = ttl;
+      f->ttl = ttl;
+      f->kind = (ExpKind)q->kind;
+      f->color = q->color;
+    }
+    full[i].count = compact[i].count;
+    particles += compact[i].count;
+  }
+  is_particle_lod_enabled = lod;
+
+  Vector3 forward =
+      Vector3Normalize(Vector3Subtract(camera.target, camera.position));
+  Vector3 drift = Vector3Scale(forward, compact[0].backDrift);
+
+  bool counted = profilerCacheMissesBegin();
+  double start = benchNowMs();
+  for (int frame = 0; frame < PARTICLE_BENCH_FRAMES; frame++)
+    for (int i = 0; i < PARTICLE_BENCH_EXPLOSIONS; i++)
+      bulletExplosionUpdate(&compact[i], compact[i].last_origin, dt, &camera);
+  double compact_ms = (benchNowMs() - start) / PARTICLE_BENCH_FRAMES;
+  long long compact_misses = counted ? profilerCacheMissesEnd() : -1;
+
+  counted = profilerCacheMissesBegin();
+  start = benchNowMs();
+  for (int frame = 0; frame < PARTICLE_BENCH_FRAMES; frame++)
+    for (int i = 0; i < PARTICLE_BENCH_EXPLOSIONS; i++)
+      expFloatUpdate(&full[i], &compact[i], dt, drift);
+  double full_ms = (benchNowMs() - start) / PARTICLE_BENCH_FRAMES;
+  long long full_misses = counted ? profilerCacheMissesEnd() : -1;
+
+  size_t slots = (size_t)PARTICLE_BENCH_EXPLOSIONS * EXP_MAX;
+  TraceLog(LOG_INFO,
+           "[Bench] %d explosions, %d particles, %d frames, half floats "
+           "via %s",
+           PARTICLE_BENCH_EXPLOSIONS, particles, PARTICLE_BENCH_FRAMES,
+           HALF_SIMD_NAME);
+  TraceLog(LOG_INFO,
+           "[Bench] compact: %zu B/particle, %zu KiB resident, %.3f "
+           "ms/frame, %lld cache misses",
+           sizeof(ExpParticle), slots * sizeof(ExpParticle) / 1024,
+           compact_ms, compact_misses);
+  TraceLog(LOG_INFO,
+           "[Bench] float:   %zu B/particle, %zu KiB resident, %.3f "
+           "ms/frame, %lld cache misses",
+           sizeof(ExpParticleFloat), slots * sizeof(ExpParticleFloat) / 1024,
+           full_ms, full_misses);
+  if (compact_misses < 0)
+  {
+    TraceLog(LOG_INFO, "[Bench] cache miss counter unavailable (-1)");
+  }
+  free(compact);
+  free(full);
+  return true;
+}
@@ -0,0 +1,215 @@
+/**
+ * @file units.c
+ * @brief Benchmark of the hot/cold unit tables (see unit.h) against the
+ * linked list of whole units they replaced.
+ */
+#include "bench.h"
+#include "../src/movement/movement.h"
+#include "../src/units/explosion.h"
+#include "../src/units/unit.h"
+#include "../src/utils/profiler.h"
+#include "raylib.h"
+#include "raymath.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+/// Units in the iteration benchmark.
+#define UNIT_BENCH_COUNT 10000
+
+/// Passes over all units per benchmark run.
+#define UNIT_BENCH_PASSES 200
+
+/// Width of a formation cell: unit width plus horizontal spacing.
+#define UNIT_BENCH_CELL 9.0f
+
+/**
+ * @brief Previous unit storage: one heap node per unit holding the whole
+ * unit, explosion particles included. Baseline of the benchmark.
+ */
+typedef struct UnitBenchNode
+{
+  struct UnitBenchNode *prev;
+  struct UnitBenchNode *next;
+  UnitType type;
+  UnitState state;
+  UnitPosition position;
+  UnitSize size;
+  MovementOffset *action; // Separate heap block, like the old action
+  uint32_t last_frame;
+  bool visible;
+  ShipModel *model;
+  SpriteAnimHandle explosion_effect;
+  BulletExplosion explosion_bullet;
+  SpriteAnimHandle hit;
+} UnitBenchNode;
+
+/**
+ * @brief Collision step of the benchmark: tests the unit box against the
+ * targets and applies one point of damage per hit.
+ *
+ * @param health Health of the unit.
+ * @param position Position of the unit.
+ * @param offset Movement offset of the unit.
+ * @param box Extents of the unit model.
+ * @param targets Boxes to test against.
+ * @param count Number of targets.
+ * @return Number of targets hit.
+ */
+static int unitBenchStep(uint8_t *health, const UnitPosition *position,
+                         const MovementOffset *offset,
+                         const ShipBoundingBox *box, const BoundingBox *targets,
+                         int count)
+{
+  Vector3 center = {position->x + offset->x, position->y + offset->y,
+                    position->z + position->z_offset + offset->z};
+  Vector3 half = {box->by_x / 2, box->by_y / 2, box->by_z / 2};
+  BoundingBox unit_box = {Vector3Subtract(center, half),
+                          Vector3Add(center, half)};
+  int hits = 0;
+  for (int i = 0; i < count; i++)
+  {
+    if (CheckCollisionBoxes(unit_box, targets[i]))
+    {
+      hits++;
+      if (*health > 0)
+      {
+        *health -= 1;
+      }
+    }
+  }
+  return hits;
+}
+
+/**
+ * @brief Runs a collision-style pass over many units without a window and
+ * logs the time per pass and cache misses for the hot/cold split against
+ * the previous linked list of whole units.
+ *
+ * @return False when the unit tables could not be allocated.
+ */
+bool benchUnits(void)
+{
+  const uint16_t max_col = 100;
+  ShipModel model = {0};
+  model.box = (ShipBoundingBox){4.0f, 1.5f, 4.0f};
+  UnitCold cold = {0};
+  cold.model = &model;
+  cold.explosion_effect = SPRITE_ANIM_NONE;
+  cold.hit = SPRITE_ANIM_NONE;
+  cold.explosion_bullet = newBulletExplosion((Texture2D){0}, (Rectangle){0},
+                                             (Rectangle){0}, (Rectangle){0});
+
+  UnitList *list = newUnitTables(UNIT_BENCH_COUNT);
+  if (!list)
+  {
+    TraceLog(LOG_ERROR, "[Bench] units out of memory");
+    return false;
+  }
+  float mid_x = (UNIT_BENCH_CELL * max_col) / 2.0f - UNIT_BENCH_CELL / 2.0f;
+  UnitBenchNode *head = NULL;
+  UnitBenchNode *tail = NULL;
+  for (int i = 0; i < UNIT_BENCH_COUNT; i++)
+  {
+    insertToUnitList(list, newUnit(UNIT_TYPE_ENEMY), cold, max_col, mid_x,
+                     40.0f);
+  }
+  // Same placement in the old layout, one allocation per unit
+  for (uint16_t i = 0; i < list->handles.used; i++)
+  {
+    UnitBenchNode *node = malloc(sizeof(UnitBenchNode));
+    MovementOffset *action = calloc(1, sizeof(MovementOffset));
+    if (!node || !action)
+    {
+      free(node);
+      free(action);
+      break;
+    }
+    node->prev = tail;
+    node->next = NULL;
+    node->type = UNIT_TYPE_ENEMY;
+    node->state = newUnitState();
+    node->position = list->units[i].render.position;
+    node->size = newUnitSize();
+    node->action = action;
+    node->last_frame = 0;
+    node->visible = true;
+    node->model = &model;
+    node->explosion_effect = SPRITE_ANIM_NONE;
+    node->explosion_bullet = cold.explosion_bullet;
+    node->hit = SPRITE_ANIM_NONE;
+    if (tail)
+    {
+      tail->next = node;
+    }
+    else
+    {
+      head = node;
+    }
+    tail = node;
+  }
+
+  // A few bullets scattered over the formation
+  BoundingBox targets[8];
+  for (int i = 0; i < 8; i++)
+  {
+    Vector3 at = {(float)(i * 97 % 800) - 400.0f, 0.0f,
+                  (float)(i * 151 % 1100) - 40.0f};
+    targets[i] = (BoundingBox){Vector3Subtract(at, (Vector3){1, 1, 1}),
+                               Vector3Add(at, (Vector3){1, 1, 1})};
+  }
+
+  bool counted = profilerCacheMissesBegin();
+  double start = benchNowMs();
+  long split_hits = 0;
+  for (int pass = 0; pass < UNIT_BENCH_PASSES; pass++)
+    for (uint16_t i = 0; i < list->handles.used; i++)
+    {
+      Unit *unit = &list->units[i];
+      if (unit->handle != ENTITY_NONE)
+      {
+        split_hits += unitBenchStep(
+            &unit->state.health, &unit->render.position, &unit->render.offset,
+            &list->cold[i].model->box, targets, 8);
+      }
+    }
+  double split_ms = (benchNowMs() - start) / UNIT_BENCH_PASSES;
+  long long split_misses = counted ? profilerCacheMissesEnd() : -1;
+
+  counted = profilerCacheMissesBegin();
+  start = benchNowMs();
+  long list_hits = 0;
+  for (int pass = 0; pass < UNIT_BENCH_PASSES; pass++)
+    for (UnitBenchNode *node = head; node; node = node->next)
+    {
+      list_hits += unitBenchStep(&node->state.health, &node->position,
+                                 node->action, &node->model->box, targets, 8);
+    }
+  double list_ms = (benchNowMs() - start) / UNIT_BENCH_PASSES;
+  long long list_misses = counted ? profilerCacheMissesEnd() : -1;
+
+  TraceLog(LOG_INFO, "[Bench] %u units, %d passes, %ld/%ld hits",
+           list->length, UNIT_BENCH_PASSES, split_hits, list_hits);
+  TraceLog(LOG_INFO,
+           "[Bench] hot/cold: %zu B hot + %zu B cold per unit, %.3f "
+           "ms/pass (%.1f M units/s), %lld cache misses",
+           sizeof(Unit), sizeof(UnitCold), split_ms,
+           list->length / split_ms / 1000.0, split_misses);
+  TraceLog(LOG_INFO,
+           "[Bench] linked:   %zu B per node, %.3f ms/pass (%.1f M "
+           "units/s), %lld cache misses",
+           sizeof(UnitBenchNode), list_ms, list->length / list_ms / 1000.0,
+           list_misses);
+  if (split_misses < 0)
+  {
+    TraceLog(LOG_INFO, "[Bench] cache miss counter unavailable (-1)");
+  }
+  while (head)
+  {
+    UnitBenchNode *next = head->next;
+    free(head->action);
+    free(head);
+    head = next;
+  }
+  destroyUnitList(list);
+  return true;
+}
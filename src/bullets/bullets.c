@@ -4,15 +4,25 @@
  * collision detection, and lifecycle management.
  */
 #include "bullets.h"
-#include "../game/stat.h"
+#include "../game/clock.h"
+#include "../game/events.h"
+#include "../render/debugdraw.h"
+#include "../render/fillrate.h"
+#include "../render/particlelod.h"
+#include "../utils/profiler.h"
 #include "../textures/textures.h"
 #include "raylib.h"
+#include <assert.h>
+#include <math.h>
 #include <raymath.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 
+/// Updates of motion shown by the debug velocity vector of a bullet.
+#define BULLET_DEBUG_VELOCITY_FRAMES 10.0f
+
 /**
  * @brief Creates and initializes a new BulletAreaFrame instance.
  *
@@ -154,12 +164,14 @@ Bullet newBullet(BulletMovementDirection direction, BulletPosition position,
   }
   Bullet bullet;
   bullet.movement = newBulletMovement(direction, acceleration, speed);
-  bullet.position = position;
+  bullet.trajectory.origin = position;
+  bullet.trajectory.spawn_tick = 0;
+  bullet.trajectory.exit_tick = BULLET_TICK_NEVER;
   bullet.params = params;
   bullet.size = size;
   bullet.alive = true;
   bullet.owner = owner;
-  bullet.trail = newTrailEmitter(tex_fire_soft->tex, true);
+  bullet.trail = newTrailEmitter(tex_fire_soft->tex, tex_fire_soft->src, true);
   return bullet;
 }
 
@@ -197,72 +209,152 @@ Bullet newBulletAimedAt(BulletPosition position, BulletSize size,
   Bullet bullet;
   bullet.movement =
       newBulletAimedMovement(position, target_x, target_z, acceleration, speed);
-  bullet.position = position;
+  bullet.trajectory.origin = position;
+  bullet.trajectory.spawn_tick = 0;
+  bullet.trajectory.exit_tick = BULLET_TICK_NEVER;
   bullet.params = params;
   bullet.size = size;
   bullet.alive = true;
   bullet.owner = owner;
-  bullet.trail = newTrailEmitter(tex_fire_soft->tex, true);
+  bullet.trail = newTrailEmitter(tex_fire_soft->tex, tex_fire_soft->src, true);
   return bullet;
 }
 
 /**
- * @brief Updates the position and state of a bullet based on its movement parameters.
+ * @brief Evaluates where a bullet is at a given list tick.
  *
- * This function modifies the bullet's position according to its speed and
- * acceleration. It also checks if the bullet has moved outside the defined
- * area frame, marking it as inactive if so. If a player-owned bullet goes
- * out of bounds, it increments the miss count in the provided game statistics.
+ * The bullet covers speed + k * acceleration during its k-th tick, so after
+ * n ticks it has moved n * speed + acceleration * n * (n + 1) / 2 along its
+ * direction.
  *
- * @param bullet A pointer to the Bullet instance to be updated.
- * @param frame A pointer to the BulletAreaFrame defining the valid area for bullets.
- * @param stat A pointer to the GameStat structure for tracking hits and misses.
+ * @param bullet A pointer to the Bullet instance.
+ * @param tick List tick to evaluate, not before the spawn tick.
+ * @return Position of the bullet.
  */
-void updateBullet(Bullet *bullet, BulletAreaFrame *frame, GameStat *stat)
+BulletPosition bulletPositionAt(const Bullet *bullet, uint32_t tick)
 {
-  if (!bullet || !bullet->alive)
-    return;
-
-  bullet->movement.speed += bullet->movement.acceleration;
+  const BulletTrajectory *trajectory = &bullet->trajectory;
+  double n = (double)(tick - trajectory->spawn_tick);
+  double distance = n * bullet->movement.speed +
+                    bullet->movement.acceleration * n * (n + 1.0) * 0.5;
+  BulletPosition position = trajectory->origin;
+  position.x += (float)(distance * bullet->movement.dir.x);
+  position.z += (float)(distance * bullet->movement.dir.z);
+  return position;
+}
 
-  bullet->position.x += bullet->movement.speed * bullet->movement.dir.x;
-  bullet->position.z += bullet->movement.speed * bullet->movement.dir.z;
+/**
+ * @brief Tests whether a bullet is outside the area frame at a given tick.
+ */
+static bool isBulletOutsideAt(const Bullet *bullet,
+                              const BulletAreaFrame *frame, uint32_t tick)
+{
+  float z = bulletPositionAt(bullet, tick).z;
+  return z < frame->top || z > frame->bottom;
+}
 
-  if (bullet->position.z < frame->top || bullet->position.z > frame->bottom)
+/**
+ * @brief Computes the first tick at which a bullet is outside the area
+ * frame.
+ *
+ * Solves the travel equation for the distance to the boundary ahead of the
+ * bullet, then settles the rounding with bulletPositionAt itself so the
+ * exit agrees with the positions the bullet is drawn and collided at: the
+ * bullet is outside at the exit tick and still inside the tick before
+ * (unless the exit is the first tick after the spawn).
+ *
+ * @param bullet A pointer to the Bullet instance, trajectory set.
+ * @param frame A pointer to the BulletAreaFrame defining the valid area.
+ * @return Exit tick, or BULLET_TICK_NEVER.
+ */
+static uint32_t bulletExitTick(const Bullet *bullet,
+                               const BulletAreaFrame *frame)
+{
+  const BulletTrajectory *trajectory = &bullet->trajectory;
+  double dz = bullet->movement.dir.z;
+  double a = bullet->movement.acceleration;
+  double v = bullet->movement.speed;
+  if (fabs(dz) < 1e-6)
   {
-    bullet->alive = false;
-    if (bullet->owner == BULLET_OWNER_PLAYER)
+    return BULLET_TICK_NEVER;
+  }
+  double boundary = dz < 0.0 ? frame->top : frame->bottom;
+  double distance = (boundary - trajectory->origin.z) / dz;
+  double n;
+  if (distance <= 0.0)
+  {
+    n = 1.0;
+  }
+  else if (a != 0.0)
+  {
+    // a / 2 * n^2 + (v + a / 2) * n = distance
+    double b = v + a * 0.5;
+    double disc = b * b + 2.0 * a * distance;
+    if (disc < 0.0)
     {
-      addMissIntoGameStat(stat);
+      return BULLET_TICK_NEVER;
     }
+    n = (-b + sqrt(disc)) / a;
+    if (n < 0.0)
+    {
+      return BULLET_TICK_NEVER;
+    }
+  }
+  else if (v > 0.0)
+  {
+    n = distance / v;
+  }
+  else
+  {
+    return BULLET_TICK_NEVER;
+  }
+  if (n > (double)(BULLET_TICK_NEVER - trajectory->spawn_tick - 2))
+  {
+    return BULLET_TICK_NEVER;
+  }
+  uint32_t first = trajectory->spawn_tick + 1;
+  uint32_t tick = trajectory->spawn_tick + (n < 1.0 ? 1u : (uint32_t)ceil(n));
+  // The root is off by the float rounding of the positions at most, so each
+  // walk takes a step or two; both stop at the ends of the tick range.
+  while (tick > first && isBulletOutsideAt(bullet, frame, tick - 1))
+  {
+    tick--;
+  }
+  while (tick < BULLET_TICK_NEVER - 1 &&
+         !isBulletOutsideAt(bullet, frame, tick))
+  {
+    tick++;
+  }
+  if (!isBulletOutsideAt(bullet, frame, tick))
+  {
+    return BULLET_TICK_NEVER;
   }
+  assert(tick == first || !isBulletOutsideAt(bullet, frame, tick - 1));
+  return tick;
 }
 
 /**
  * @brief Renders a bullet in the 3D world and updates its trail effect.
  *
  * This function draws the bullet as a cylinder with a nose cone, based on its
- * current position and size. It also updates and renders the bullet's trail
- * effect using the provided camera for proper 3D perspective. The bullet's
- * state is updated before rendering, and if it goes out of bounds, it is marked
- * as inactive and the miss count is updated in the game statistics.
+ * position and size. It also emits and updates the bullet's trail
+ * particles; the trail itself is rendered by drawBulletTrails in a shared
+ * pass.
  *
  * @param bullet A pointer to the Bullet instance to be drawn.
- * @param frame A pointer to the BulletAreaFrame defining the valid area for bullets.
+ * @param position Position of the bullet at the current list tick.
+ * @param ticks Ticks since the bullet was fired.
  * @param camera A pointer to the Camera3D used for rendering the scene.
- * @param stat A pointer to the GameStat structure for tracking hits and misses.
  */
-void drawBullet(Bullet *bullet, BulletAreaFrame *frame, Camera3D *camera,
-                GameStat *stat)
+static void drawBullet(Bullet *bullet, BulletPosition position, uint32_t ticks,
+                       Camera3D *camera)
 {
-  if (!bullet || !bullet->alive || !stat || !frame || !camera)
+  if (!bullet || !bullet->alive || !camera)
   {
     return;
   }
 
-  updateBullet(bullet, frame, stat);
-
-  Vector3 center = {bullet->position.x, bullet->position.y, bullet->position.z};
+  Vector3 center = {position.x, position.y, position.z};
 
   Vector3 axis = Vector3Normalize(
       (Vector3){bullet->movement.dir.x, 0.0f, bullet->movement.dir.z});
@@ -281,10 +373,25 @@ void drawBullet(Bullet *bullet, BulletAreaFrame *frame, Camera3D *camera,
   DrawCylinderEx(end, nose_end, bullet->size.radius_top, 0.0f,
                  bullet->size.slices, RED);
 
-  float dt = GetFrameTime();
-  trailEmit(&bullet->trail, start, axis, dt); // направление эффекта = ось
+  float dt = clockDelta();
+  ParticleLod lod = particleLodBegin(camera);
+  float rate = particleLodSpawnScale(&lod, start, bullet->trail.baseSize);
+  trailEmit(&bullet->trail, start, axis, dt, rate); // направление эффекта = ось
   trailUpdate(&bullet->trail, dt);
-  trailDraw(&bullet->trail, *camera);
+
+  if (debug_draw_layers != 0)
+  {
+    debugDrawBox(DEBUG_LAYER_AABB, getBulletBoundingBox(bullet, position),
+                 ORANGE);
+    // Distance covered over the next BULLET_DEBUG_VELOCITY_FRAMES updates
+    float speed =
+        bullet->movement.speed + bullet->movement.acceleration * (float)ticks;
+    debugDrawLine(DEBUG_LAYER_VELOCITY, center,
+                  Vector3Add(center,
+                             Vector3Scale(bullet->movement.dir,
+                                          speed * BULLET_DEBUG_VELOCITY_FRAMES)),
+                  SKYBLUE);
+  }
 }
 
 /**
@@ -295,16 +402,18 @@ void drawBullet(Bullet *bullet, BulletAreaFrame *frame, Camera3D *camera,
  * maximum corners in 3D space.
  *
  * @param bullet A pointer to the Bullet instance for which to compute the bounding box.
+ * @param position Position of the bullet (see bulletPositionAt).
  * @return A BoundingBox structure representing the AABB of the bullet.
  */
-BoundingBox getBulletBoundingBox(Bullet *bullet)
+BoundingBox getBulletBoundingBox(const Bullet *bullet,
+                                 BulletPosition position)
 {
-  return (BoundingBox){.min = {bullet->position.x - bullet->size.by_x / 2,
-                               bullet->position.y - bullet->size.by_y / 2,
-                               bullet->position.z - bullet->size.by_z / 2},
-                       .max = {bullet->position.x + bullet->size.by_x / 2,
-                               bullet->position.y + bullet->size.by_y / 2,
-                               bullet->position.z + bullet->size.by_z / 2}};
+  return (BoundingBox){.min = {position.x - bullet->size.by_x / 2,
+                               position.y - bullet->size.by_y / 2,
+                               position.z - bullet->size.by_z / 2},
+                       .max = {position.x + bullet->size.by_x / 2,
+                               position.y + bullet->size.by_y / 2,
+                               position.z + bullet->size.by_z / 2}};
 }
 
 /**
@@ -370,17 +479,101 @@ BulletList *newBulletList()
   list->tail = NULL;
   list->length = 0;
   list->idx = 0;
-  list->last_spawn = GetTime();
+  list->last_spawn = clockNow();
   list->frame = newBulletAreaFrame();
+  list->tick = 0;
+  list->expiry = NULL;
+  list->expiry_count = 0;
+  list->expiry_capacity = 0;
+  if (!entityTableInit(&list->handles))
+  {
+    free(list);
+    return NULL;
+  }
   return list;
 }
 
+/**
+ * @brief Adds an exit to the expiry heap.
+ *
+ * @param list A pointer to the BulletList owning the heap.
+ * @param expiry Exit to add.
+ * @return False when memory ran out.
+ */
+static bool pushBulletExpiry(BulletList *list, BulletExpiry expiry)
+{
+  if (list->expiry_count == list->expiry_capacity)
+  {
+    size_t capacity = list->expiry_capacity ? list->expiry_capacity * 2 : 64;
+    BulletExpiry *items =
+        realloc(list->expiry, capacity * sizeof(BulletExpiry));
+    if (!items)
+    {
+      return false;
+    }
+    list->expiry = items;
+    list->expiry_capacity = capacity;
+  }
+  size_t i = list->expiry_count++;
+  while (i > 0)
+  {
+    size_t parent = (i - 1) / 2;
+    if (list->expiry[parent].tick <= expiry.tick)
+    {
+      break;
+    }
+    list->expiry[i] = list->expiry[parent];
+    i = parent;
+  }
+  list->expiry[i] = expiry;
+  return true;
+}
+
+/**
+ * @brief Removes the earliest exit from the expiry heap.
+ *
+ * @param list A pointer to the BulletList owning a non-empty heap.
+ * @return The removed exit.
+ */
+static BulletExpiry popBulletExpiry(BulletList *list)
+{
+  BulletExpiry top = list->expiry[0];
+  BulletExpiry last = list->expiry[--list->expiry_count];
+  size_t i = 0;
+  for (;;)
+  {
+    size_t child = i * 2 + 1;
+    if (child >= list->expiry_count)
+    {
+      break;
+    }
+    if (child + 1 < list->expiry_count &&
+        list->expiry[child + 1].tick < list->expiry[child].tick)
+    {
+      child++;
+    }
+    if (last.tick <= list->expiry[child].tick)
+    {
+      break;
+    }
+    list->expiry[i] = list->expiry[child];
+    i = child;
+  }
+  if (list->expiry_count > 0)
+  {
+    list->expiry[i] = last;
+  }
+  return top;
+}
+
 /**
  * @brief Inserts a new bullet into the bullet list.
  *
  * This function creates a new BulletNode for the given bullet and
  * appends it to the end of the specified BulletList. It updates
- * the list's head, tail, length, and index accordingly.
+ * the list's head, tail, length, and index accordingly. The bullet's
+ * trajectory starts at the current list tick and its exit from the area
+ * frame is scheduled on the expiry heap.
  *
  * @param list A pointer to the BulletList where the bullet will be inserted.
  * @param bullet The Bullet instance to be added to the list.
@@ -392,11 +585,25 @@ void insertBulletIntoList(BulletList *list, Bullet bullet)
     return;
   }
   list->idx += 1;
+  bullet.trajectory.spawn_tick = list->tick;
+  bullet.trajectory.exit_tick = bulletExitTick(&bullet, &list->frame);
   BulletNode *node = newBulletNode(list->tail, bullet, list->idx);
   if (!node)
   {
     return;
   }
+  node->handle = entityAcquire(&list->handles, node);
+  if (node->handle == ENTITY_NONE)
+  {
+    destroyBulletNode(node);
+    return;
+  }
+  if (bullet.trajectory.exit_tick != BULLET_TICK_NEVER &&
+      !pushBulletExpiry(list, (BulletExpiry){bullet.trajectory.exit_tick,
+                                             node->handle}))
+  {
+    TraceLog(LOG_WARNING, "[Bullets] expiry heap is full, exit not tracked");
+  }
   if (!list->head)
   {
     list->head = node;
@@ -408,79 +615,188 @@ void insertBulletIntoList(BulletList *list, Bullet bullet)
     prev->next = node;
   }
   list->length += 1;
-  TraceLog(LOG_INFO, "[Bullets] bullet has been spawn: %f, %f, %f",
-           bullet.position.x, bullet.position.y, bullet.position.z);
+  gameEventEmit((GameEvent){
+      .type = GAME_EVENT_SPAWN,
+      .owner = (uint8_t)bullet.owner,
+      .subject = node->handle,
+      .position = (Vector3){bullet.trajectory.origin.x,
+                            bullet.trajectory.origin.y,
+                            bullet.trajectory.origin.z}});
 }
 
 /**
- * @brief Removes inactive bullets from the bullet list.
+ * @brief Marks a bullet as inactive and queues it for destruction.
  *
- * This function iterates through the BulletList and removes any bullets
- * that are marked as inactive (alive == false). It updates the list's
- * head, tail, and length accordingly, and frees the memory of removed nodes.
+ * The node stays linked until removeBullets runs at the end of the tick, so
+ * passes iterating the list in between only have to skip dead bullets.
  *
- * @param list A pointer to the BulletList from which inactive bullets will be removed.
+ * @param list A pointer to the BulletList owning the bullet.
+ * @param node A pointer to the node of the bullet.
+ */
+void destroyBulletLater(BulletList *list, BulletNode *node)
+{
+  if (!list || !node)
+  {
+    return;
+  }
+  node->self.alive = false;
+  entityDestroyLater(&list->handles, node->handle);
+}
+
+/**
+ * @brief Resolves a bullet handle.
+ *
+ * @param list A pointer to the BulletList that issued the handle.
+ * @param handle Handle of the bullet.
+ * @return The bullet node, or NULL once the bullet has been destroyed.
+ */
+BulletNode *resolveBullet(BulletList *list, EntityHandle handle)
+{
+  return list ? entityResolve(&list->handles, handle) : NULL;
+}
+
+/**
+ * @brief Destroys the bullets queued during the tick.
+ *
+ * Drains the destroy queue in one pass: each queued node is unlinked and
+ * freed and its handle slot released, without walking the rest of the list.
+ *
+ * @param list A pointer to the BulletList.
  */
 void removeBullets(BulletList *list)
 {
-  BulletNode *node = list->head;
-  while (node)
+  BulletNode *node;
+  while ((node = entityTakeDestroyed(&list->handles)))
   {
-    BulletNode *next = node->next;
+    if (node == list->head)
+    {
+      list->head = node->next;
+    }
 
-    if (!node->self.alive)
+    if (node == list->tail)
     {
-      if (node == list->head)
-      {
-        list->head = node->next;
-      }
+      list->tail = node->prev;
+    }
 
-      if (node == list->tail)
-      {
-        list->tail = node->prev;
-      }
+    if (node->prev)
+    {
+      node->prev->next = node->next;
+    }
+    if (node->next)
+    {
+      node->next->prev = node->prev;
+    }
 
-      if (node->prev)
-      {
-        node->prev->next = node->next;
-      }
-      if (node->next)
-      {
-        node->next->prev = node->prev;
-      }
+    destroyBulletNode(node);
+    list->length--;
 
-      destroyBulletNode(node);
-      list->length--;
+    TraceLog(LOG_INFO, "[Bullets] in list: %i", list->length);
+  }
+}
 
-      TraceLog(LOG_INFO, "[Bullets] in list: %i", list->length);
+/**
+ * @brief Advances the bullets by one tick.
+ *
+ * Pops the bullets whose exit tick came from the expiry heap: they are
+ * queued for destruction and, for player bullets, a GAME_EVENT_MISS is
+ * emitted. Entries of bullets that hit something earlier are stale and
+ * dropped. The other bullets are not visited: collision and drawing
+ * evaluate their positions at the new tick.
+ *
+ * @param list A pointer to the BulletList.
+ */
+void advanceBullets(BulletList *list)
+{
+  list->tick += 1;
+  while (list->expiry_count > 0 && list->expiry[0].tick <= list->tick)
+  {
+    BulletExpiry expiry = popBulletExpiry(list);
+    BulletNode *node = resolveBullet(list, expiry.handle);
+    if (!node || !node->self.alive)
+    {
+      continue;
     }
-
-    node = next;
+    Bullet *bullet = &node->self;
+    if (bullet->owner == BULLET_OWNER_PLAYER)
+    {
+      BulletPosition position = bulletPositionAt(bullet, expiry.tick);
+      gameEventEmit((GameEvent){
+          .type = GAME_EVENT_MISS,
+          .owner = (uint8_t)bullet->owner,
+          .subject = node->handle,
+          .position = (Vector3){position.x, position.y, position.z}});
+    }
+    destroyBulletLater(list, node);
   }
 }
 
 /**
- * @brief Updates and draws all bullets in the list, then removes inactive ones.
+ * @brief Draws all bullets in the list.
  *
- * This function iterates through the BulletList, updating and rendering
- * each active bullet using the provided camera and game statistics. After
- * processing all bullets, it removes any that are no longer active.
+ * This function iterates through the BulletList, rendering each active
+ * bullet using the provided camera at its position for the current list
+ * tick; trails are drawn by drawBulletTrails.
  *
  * @param list A pointer to the BulletList containing the bullets to be drawn.
  * @param camera A pointer to the Camera3D used for rendering the scene.
- * @param stat A pointer to the GameStat structure for tracking hits and misses.
+ * @param lights A pointer to the LightManager receiving one light per bullet.
  */
-void drawBullets(BulletList *list, Camera3D *camera, GameStat *stat)
+void drawBullets(BulletList *list, Camera3D *camera, LightManager *lights)
 {
   BulletNode *node = list->head;
-  // Process and draw bullets
   while (node)
   {
-    drawBullet(&node->self, &list->frame, camera, stat);
+    if (node->self.alive)
+    {
+      Bullet *bullet = &node->self;
+      BulletPosition position = bulletPositionAt(bullet, list->tick);
+      drawBullet(bullet, position,
+                 list->tick - bullet->trajectory.spawn_tick, camera);
+      lightsAddFrameLight(lights,
+                          (Vector3){position.x, position.y, position.z},
+                          (Color){255, 70, 40, 255}, 1.5f, 8.0f);
+    }
     node = node->next;
   }
-  // Cleanup
-  removeBullets(list);
+}
+
+/**
+ * @brief Draws the trails of all bullets in a single additive pass.
+ *
+ * @param list A pointer to the BulletList containing the bullets.
+ * @param camera A pointer to the Camera3D used for rendering the scene.
+ */
+void drawBulletTrails(BulletList *list, Camera3D *camera)
+{
+  // Trails of all bullets share the atlas and the blend mode: one batch
+  BillboardBasis basis = billboardBasis(camera);
+  unsigned int bound = 0;
+  profilerGpuBegin(PROFILE_GPU_TRAILS);
+  fillRateBlendBegin(BLEND_ADDITIVE);
+  for (BulletNode *node = list->head; node; node = node->next)
+  {
+    TrailEmitter *trail = &node->self.trail;
+    if (!node->self.alive || trail->count == 0)
+    {
+      continue;
+    }
+    if (trail->tex.id != bound)
+    {
+      if (bound != 0)
+      {
+        billboardEnd();
+      }
+      bound = trail->tex.id;
+      billboardBegin(bound);
+    }
+    trailDrawParticles(trail, *camera, &basis);
+  }
+  if (bound != 0)
+  {
+    billboardEnd();
+  }
+  fillRateBlendEnd();
+  profilerGpuEnd(PROFILE_GPU_TRAILS);
 }
 
 /**
@@ -504,6 +820,11 @@ void destroyBulletList(BulletList *list)
   list->head = list->tail = NULL;
   list->length = 0;
   list->idx = 0;
+  free(list->expiry);
+  list->expiry = NULL;
+  list->expiry_count = 0;
+  list->expiry_capacity = 0;
+  entityTableFree(&list->handles);
 }
 
 // Helper function to compute collision radius of a bullet
@@ -516,57 +837,34 @@ static inline float bulletCollisionRadius(const Bullet *b)
 }
 
 // Check if two bullets overlap in the XZ plane
-static inline bool bulletsOverlapXZ(const Bullet *a, const Bullet *b)
+static inline bool bulletsOverlapXZ(const Bullet *a, BulletPosition at_a,
+                                    const Bullet *b, BulletPosition at_b)
 {
-  const float dx = a->position.x - b->position.x;
-  const float dz = a->position.z - b->position.z;
+  const float dx = at_a.x - at_b.x;
+  const float dz = at_a.z - at_b.z;
   const float r = bulletCollisionRadius(a) + bulletCollisionRadius(b);
   return (dx * dx + dz * dz) <= (r * r);
 }
 
 /**
- * @brief Resolves collisions between bullets in the list.
+ * @brief Tests whether two bullets collide (overlap in the XZ plane).
  *
- * This function checks for collisions between all pairs of bullets in the
- * BulletList. If two bullets collide (overlap in the XZ plane), both are
- * marked as inactive (alive = false). The function can be configured to
- * ignore collisions between bullets owned by the same entity.
+ * Pure query: neither bullet is modified, so it is safe to call from
+ * several threads at once.
  *
- * @param list A pointer to the BulletList containing the bullets to check for collisions.
- * @param same_owner_collides A boolean flag indicating whether bullets from the same owner should collide.
+ * @param a First bullet.
+ * @param at_a Position of the first bullet (see bulletPositionAt).
+ * @param b Second bullet.
+ * @param at_b Position of the second bullet.
+ * @param same_owner_collides Whether bullets from the same owner collide.
+ * @return True when both bullets are alive and overlap.
  */
-void bulletsResolveMutualCollisions(BulletList *list,
-                                    bool same_owner_collides)
+bool bulletsCollide(const Bullet *a, BulletPosition at_a, const Bullet *b,
+                    BulletPosition at_b, bool same_owner_collides)
 {
-  if (!list)
-    return;
-
-  size_t destroyed_pairs = 0;
-
-  for (BulletNode *a = list->head; a; a = a->next)
-  {
-    Bullet *ba = &a->self;
-    if (!ba->alive)
-      continue;
-
-    for (BulletNode *b = a->next; b; b = b->next)
-    {
-      Bullet *bb = &b->self;
-      if (!bb->alive)
-        continue;
-
-      if (!same_owner_collides && ba->owner == bb->owner)
-        continue;
-
-      if (bulletsOverlapXZ(ba, bb))
-      {
-        ba->alive = false;
-        bb->alive = false;
-
-        destroyed_pairs++;
-        break;
-      }
-    }
-  }
-  removeBullets(list);
+  if (!a->alive || !b->alive)
+    return false;
+  if (!same_owner_collides && a->owner == b->owner)
+    return false;
+  return bulletsOverlapXZ(a, at_a, b, at_b);
 }
\ No newline at end of file
@@ -6,8 +6,9 @@
 #ifndef BULLETS_H
 #define BULLETS_H
 
-#include "../game/stat.h"
+#include "../render/lights.h"
 #include "../textures/textures.h"
+#include "../utils/handles.h"
 #include "trail.h"
 #include <stdbool.h>
 #include <stddef.h>
@@ -73,25 +74,43 @@ typedef struct
 typedef struct
 {
   float acceleration; /// Acceleration along the Z axis.
-  float speed;        /// Current speed of the bullet.
+  float speed;        /// Speed at spawn; grows by acceleration every tick.
   float angle;        /// Orientation angle (used for rotation or visual effects).
   uint8_t direction;  /// Movement direction (from BulletMovementDirection).
   Vector3 dir;        /// Normalized direction vector in XZ plane.
 } BulletMovement;
 
+/// Exit tick of a bullet that never leaves the area frame.
+#define BULLET_TICK_NEVER UINT32_MAX
+
+/**
+ * @brief Closed-form flight of a bullet.
+ *
+ * A bullet keeps its direction and gains a constant acceleration every tick,
+ * so after n ticks it has covered n * speed + acceleration * n * (n + 1) / 2
+ * along its direction. Positions are evaluated from the spawn state, when
+ * they are needed, instead of being integrated tick by tick.
+ */
+typedef struct
+{
+  BulletPosition origin; /// Position at spawn.
+  uint32_t spawn_tick;   /// List tick at spawn.
+  uint32_t exit_tick;    /// List tick the bullet leaves the area frame.
+} BulletTrajectory;
+
 /**
  * @brief Represents a single bullet instance with its full state and
  * properties.
  */
 typedef struct
 {
-  BulletMovement movement; /// Movement-related state.
-  BulletPosition position; /// 3D position.
-  BulletSize size;         /// Shape and dimensions.
-  BulletParameters params; /// Damage and energy parameters.
-  bool alive;              /// Status flag: false if bullet is inactive.
-  BulletOwner owner;       /// Owner of the bullet (player or unit).
-  TrailEmitter trail;      /// Visual trail effect emitter.
+  BulletMovement movement;     /// Movement-related state.
+  BulletTrajectory trajectory; /// Spawn state the position is evaluated from.
+  BulletSize size;             /// Shape and dimensions.
+  BulletParameters params;     /// Damage and energy parameters.
+  bool alive;                  /// Status flag: false if bullet is inactive.
+  BulletOwner owner;           /// Owner of the bullet (player or unit).
+  TrailEmitter trail;          /// Visual trail effect emitter.
 } Bullet;
 
 /**
@@ -103,6 +122,7 @@ typedef struct BulletNode
   struct BulletNode *prev; /// Pointer to the previous bullet in list.
   Bullet self;             /// The actual bullet data.
   size_t idx;              /// Unique identifier or spawn index.
+  EntityHandle handle;     /// Generational handle of the bullet.
 } BulletNode;
 
 /**
@@ -116,17 +136,31 @@ typedef struct BulletAreaFrame
   float bottom; /// Bottom Z boundary (usually for enemy bullets).
 } BulletAreaFrame;
 
+/**
+ * @brief Pending expiry of a bullet: the tick it leaves the area frame.
+ */
+typedef struct
+{
+  uint32_t tick;       /// List tick of the exit.
+  EntityHandle handle; /// Bullet to expire; stale once it hit something.
+} BulletExpiry;
+
 /**
  * @brief Represents the entire collection of active bullets in the scene.
  */
 typedef struct
 {
-  BulletNode *head;      /// First bullet in the list.
-  BulletNode *tail;      /// Last bullet in the list.
-  uint16_t length;       /// Number of active bullets.
-  size_t idx;            /// Incremental ID for newly spawned bullets.
-  double last_spawn;     /// Time of the last bullet spawn.
-  BulletAreaFrame frame; /// Movement frame boundaries for bullets.
+  BulletNode *head;       /// First bullet in the list.
+  BulletNode *tail;       /// Last bullet in the list.
+  uint16_t length;        /// Number of active bullets.
+  size_t idx;             /// Incremental ID for newly spawned bullets.
+  double last_spawn;      /// Time of the last bullet spawn.
+  BulletAreaFrame frame;  /// Movement frame boundaries for bullets.
+  EntityTable handles;    /// Bullet handles and the end-of-tick destroy queue.
+  uint32_t tick;          /// Bullet ticks simulated so far.
+  BulletExpiry *expiry;   /// Min-heap of exits, earliest first.
+  size_t expiry_count;    /// Entries in the heap.
+  size_t expiry_capacity; /// Allocated heap entries.
 } BulletList;
 
 /**
@@ -191,11 +225,40 @@ BulletList *newBulletList();
 void insertBulletIntoList(BulletList *list, Bullet bullet);
 
 /**
- * @brief Draws all active bullets in the list.
+ * @brief Evaluates where a bullet is at a given list tick.
+ *
+ * @param bullet Pointer to the bullet.
+ * @param tick List tick to evaluate, not before the spawn tick.
+ * @return Position of the bullet.
+ */
+BulletPosition bulletPositionAt(const Bullet *bullet, uint32_t tick);
+
+/**
+ * @brief Advances the bullets by one tick: expires the bullets whose exit
+ * tick came (a miss for player bullets). The others are not touched; their
+ * positions are evaluated at list->tick by whoever needs them.
+ *
+ * @param list Pointer to the BulletList.
+ */
+void advanceBullets(BulletList *list);
+
+/**
+ * @brief Advances and draws all active bullets in the list.
+ *
+ * @param list Pointer to the BulletList.
+ * @param camera Pointer to the Camera3D used for rendering the scene.
+ * @param lights Pointer to the LightManager receiving one light per bullet.
+ */
+void drawBullets(BulletList *list, Camera3D *camera, LightManager *lights);
+
+/**
+ * @brief Draws the trails of all active bullets in one additive batch; call
+ * after every opaque draw of the frame.
  *
  * @param list Pointer to the BulletList.
+ * @param camera Pointer to the Camera3D used for rendering the scene.
  */
-void drawBullets(BulletList *list, Camera3D *camera, GameStat *stat);
+void drawBulletTrails(BulletList *list, Camera3D *camera);
 
 /**
  * @brief Computes the bounding box for a given bullet.
@@ -203,9 +266,11 @@ void drawBullets(BulletList *list, Camera3D *camera, GameStat *stat);
  * Used for collision detection with units.
  *
  * @param bullet Pointer to the bullet.
+ * @param position Position of the bullet (see bulletPositionAt).
  * @return BoundingBox struct in world space.
  */
-BoundingBox getBulletBoundingBox(Bullet *bullet);
+BoundingBox getBulletBoundingBox(const Bullet *bullet,
+                                 BulletPosition position);
 
 /**
  * @brief Frees all memory used by the BulletList and its bullets.
@@ -215,24 +280,45 @@ BoundingBox getBulletBoundingBox(Bullet *bullet);
 void destroyBulletList(BulletList *list);
 
 /**
- * @brief Updates all bullets in the list, moving them and handling their
- * lifecycle.
+ * @brief Marks a bullet as inactive and queues it for destruction at the end
+ * of the tick; it stays in the list (skipped by every pass) until then.
  *
- * Bullets that go out of bounds or are marked as inactive will be removed.
+ * @param list Pointer to the BulletList owning the bullet.
+ * @param node Node of the bullet.
+ */
+void destroyBulletLater(BulletList *list, BulletNode *node);
+
+/**
+ * @brief Resolves a bullet handle.
+ *
+ * @param list Pointer to the BulletList that issued the handle.
+ * @param handle Handle of the bullet.
+ * @return The bullet node, or NULL once the bullet has been destroyed.
+ */
+BulletNode *resolveBullet(BulletList *list, EntityHandle handle);
+
+/**
+ * @brief Destroys the bullets queued during the tick in one pass.
+ *
+ * Call once at the end of the tick.
  *
  * @param list Pointer to the BulletList.
- * @param delta Time elapsed since last update (in seconds).
  */
 void removeBullets(BulletList *list);
 
 /**
- * @brief Updates the position and state of a bullet based on its movement
- * parameters.
+ * @brief Tests whether two bullets collide (overlap in the XZ plane).
+ *
+ * Pure query, safe to call from several threads at once.
  *
- * @param bullet Pointer to the Bullet to update.
- * @param frame Pointer to the BulletAreaFrame defining valid area.
- * @param stat Pointer to GameStat for tracking hits/misses.
+ * @param a First bullet.
+ * @param at_a Position of the first bullet (see bulletPositionAt).
+ * @param b Second bullet.
+ * @param at_b Position of the second bullet.
+ * @param same_owner_collides Whether bullets from the same owner collide.
+ * @return True when both bullets are alive and overlap.
  */
-void bulletsResolveMutualCollisions(BulletList *list, bool same_owner_collides);
+bool bulletsCollide(const Bullet *a, BulletPosition at_a, const Bullet *b,
+                    BulletPosition at_b, bool same_owner_collides);
 
 #endif
\ No newline at end of file
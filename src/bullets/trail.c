@@ -6,6 +6,11 @@
 // ================================================
 
 #include "trail.h"
+#include "../render/fillrate.h"
+#include "../render/particlelod.h"
+#include "../utils/packed.h"
+#include "../utils/profiler.h"
+#include "../utils/vecmath.h"
 #include "raylib.h"
 #include "rlgl.h"
 #include <raymath.h>
@@ -25,14 +30,16 @@ static inline float frand(float a, float b)
  * spawning, size, growth, damping, speed, and color. The provided texture
  * and blending mode are applied to the emitter.
  *
- * @param tex The texture to use for trail particles.
+ * @param tex The texture (atlas) to use for trail particles.
+ * @param src Sub-rectangle of the particle image inside the texture.
  * @param additive If true, uses additive blending; otherwise, uses alpha blending.
  * @return A fully initialized TrailEmitter object.
  */
-TrailEmitter newTrailEmitter(Texture2D tex, bool additive)
+TrailEmitter newTrailEmitter(Texture2D tex, Rectangle src, bool additive)
 {
   TrailEmitter emitter = {0};
   emitter.tex = tex;
+  emitter.src = src;
   emitter.additive = additive;
   emitter.spawnRate = 60.0f;
   emitter.baseSize = 1.5f;
@@ -54,10 +61,14 @@ TrailEmitter newTrailEmitter(Texture2D tex, bool additive)
  * @param origin The 3D position from which to emit particles.
  * @param dir The direction vector for particle emission.
  * @param dt Time elapsed since the last update (in seconds).
+ * @param rate_scale Fraction of the spawn rate to use (LOD), 0..1.
  */
-void trailEmit(TrailEmitter *emitter, Vector3 origin, Vector3 dir, float dt)
+void trailEmit(TrailEmitter *emitter, Vector3 origin, Vector3 dir, float dt,
+               float rate_scale)
 {
-  emitter->accum += emitter->spawnRate * dt;
+  float full = emitter->spawnRate * dt;
+  profilerCount(PROFILE_PARTICLES_UNSPAWNED, full * (1.0f - rate_scale));
+  emitter->accum += full * rate_scale;
   while (emitter->accum >= 1.0f && emitter->count < TRAIL_MAX)
   {
 
@@ -67,12 +78,12 @@ void trailEmit(TrailEmitter *emitter, Vector3 origin, Vector3 dir, float dt)
                       frand(-0.25f, 0.25f)};
     Vector3 v = Vector3Add(Vector3Scale(dir, -emitter->speed), jitter);
 
+    float motion[4] = {v.x, v.y, v.z, emitter->baseSize * frand(0.9f, 1.2f)};
     q->pos = origin;
-    q->vel = v;
-    q->size = emitter->baseSize * frand(0.9f, 1.2f);
-    q->rot = frand(0.0f, 360.0f);
-    q->ttl = frand(0.35f, 0.55f);
-    q->life = q->ttl;
+    floatToHalf4(motion, q->motion);
+    q->rot = packRotation(frand(0.0f, 360.0f));
+    q->ttl = floatToHalf(frand(0.35f, 0.55f));
+    q->life = (uint16_t)PACKED_LIFE_FULL;
     q->color = emitter->baseColor;
 
     emitter->accum -= 1.0f;
@@ -91,18 +102,27 @@ void trailEmit(TrailEmitter *emitter, Vector3 origin, Vector3 dir, float dt)
  */
 void trailUpdate(TrailEmitter *e, float dt)
 {
+  // Velocity and size share one vector: the size lane is not damped and
+  // grows instead.
+  Vec4 damping = vec4Set(e->damping, e->damping, e->damping, 1.0f);
+  Vec4 grow = vec4Set(0.0f, 0.0f, 0.0f, e->grow * dt);
+  Vec4 step = vec4Splat(dt);
+
   int w = 0;
   for (int r = 0; r < e->count; ++r)
   {
     TrailParticle *q = &e->p[r];
-    q->pos = Vector3Add(q->pos, Vector3Scale(q->vel, dt));
-    q->vel = Vector3Scale(q->vel, e->damping);
-    q->size += e->grow * dt;
-    q->life -= dt;
-    if (q->life > 0)
+    float motion[4];
+    halfToFloat4(q->motion, motion);
+    Vec4 vel = vec4Load(motion);
+    q->pos = vec4ToVector3(
+        vec4MulAdd(vel, step, vec4FromVector3(q->pos, 0.0f)));
+    if (packedLifeStep(&q->life, dt, halfToFloat(q->ttl)))
     {
-      float t = q->life / q->ttl;
+      float t = 1.0f - packedLifeAge(q->life);
       q->color.a = (unsigned char)(220 * t);
+      vec4Store(vec4MulAdd(vel, damping, grow), motion);
+      floatToHalf4(motion, q->motion);
       e->p[w++] = *q;
     }
   }
@@ -122,19 +142,92 @@ void trailDraw(TrailEmitter *e, Camera3D cam)
 {
   if (e->count == 0)
     return;
-  BeginBlendMode(e->additive ? BLEND_ADDITIVE : BLEND_ALPHA);
+  BillboardBasis basis = billboardBasis(&cam);
+  fillRateBlendBegin(e->additive ? BLEND_ADDITIVE : BLEND_ALPHA);
+  billboardBegin(e->tex.id);
+  trailDrawParticles(e, cam, &basis);
+  billboardEnd();
+  fillRateBlendEnd();
+}
+
+/**
+ * @brief Draws one trail billboard.
+ *
+ * @param e Pointer to the TrailEmitter instance.
+ * @param cam The Camera3D used for rendering the scene.
+ * @param basis Billboard basis of the camera.
+ * @param pos Quad center.
+ * @param size Quad side length.
+ * @param rot Rotation in degrees.
+ * @param color Quad color.
+ */
+static void drawTrailQuad(const TrailEmitter *e, const Camera3D *cam,
+                          const BillboardBasis *basis, Vector3 pos, float size,
+                          float rot, Color color)
+{
+  Rectangle uv = {e->src.x / (float)e->tex.width,
+                  e->src.y / (float)e->tex.height,
+                  e->src.width / (float)e->tex.width,
+                  e->src.height / (float)e->tex.height};
+  billboardQuad(basis, pos, (Vector2){size, size}, rot, uv, color);
+  profilerCountParticle(cam, pos, size);
+}
+
+/**
+ * @brief Draws the quad standing in for a group of merged particles.
+ *
+ * @param e Pointer to the TrailEmitter instance.
+ * @param cam The Camera3D used for rendering the scene.
+ * @param basis Billboard basis of the camera.
+ * @param merge Gathered particles; reset afterwards.
+ */
+static void drawTrailMerge(const TrailEmitter *e, const Camera3D *cam,
+                           const BillboardBasis *basis, ParticleMerge *merge)
+{
+  Vector3 pos;
+  float size;
+  Color color;
+  particleMergeTake(merge, &pos, &size, &color);
+  drawTrailQuad(e, cam, basis, pos, size, 0.0f, color);
+}
 
-  Rectangle src = {0, 0, (float)e->tex.width, (float)e->tex.height};
-  Vector3 up = {0, 1, 0};
+/**
+ * @brief Renders trail particles into the open billboard batch, without
+ * touching the blend mode.
+ *
+ * Every particle is a billboard sampling the emitter's sub-rectangle of the
+ * shared atlas, so consecutive emitters do not break the batch. Sub-pixel
+ * particles are skipped and tiny ones merged (see render/particlelod.h).
+ *
+ * @param e Pointer to the TrailEmitter instance.
+ * @param cam The Camera3D used for rendering the scene.
+ * @param basis Billboard basis of the camera.
+ */
+void trailDrawParticles(TrailEmitter *e, Camera3D cam,
+                        const BillboardBasis *basis)
+{
+  ParticleLod lod = particleLodBegin(&cam);
+  ParticleMerge merge = {0};
 
   for (int i = 0; i < e->count; ++i)
   {
     TrailParticle *q = &e->p[i];
-    Vector2 size = {q->size, q->size};
-    Vector2 origin = {q->size * 0.5f, q->size * 0.5f};
-    DrawBillboardPro(cam, e->tex, src, q->pos, up, size, origin, q->rot,
-                     q->color);
+    float size = halfToFloat(q->motion[3]);
+    switch (particleLodFilter(&lod, &merge, q->pos, size, q->color))
+    {
+    case PARTICLE_LOD_DRAW:
+      drawTrailQuad(e, &cam, basis, q->pos, size, unpackRotation(q->rot),
+                    q->color);
+      break;
+    case PARTICLE_LOD_MERGED:
+      drawTrailMerge(e, &cam, basis, &merge);
+      break;
+    default:
+      break;
+    }
+  }
+  if (merge.count > 0)
+  {
+    drawTrailMerge(e, &cam, basis, &merge);
   }
-
-  EndBlendMode();
 }
@@ -1,21 +1,25 @@
+#include "../render/billboard.h"
 #include "raylib.h"
 #include "rlgl.h"
 #include <raymath.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 // Maximum number of trail particles
 #define TRAIL_MAX 128
 
 /**
- * @brief Represents a single particle in the trail effect.
+ * @brief Represents a single particle in the trail effect in 32 bytes (see
+ * utils/packed.h for the encodings).
  */
 typedef struct {
-  Vector3 pos, vel; /// Position and velocity
-  float size;       /// Current size
-  float rot;        /// Rotation angle
-  float life, ttl;  /// Remaining life and total lifespan
-  Color color;      /// Color with alpha
+  Vector3 pos;        /// Position
+  uint16_t motion[4]; /// Half floats: velocity xyz, current size
+  uint16_t life;      /// Remaining life, PACKED_LIFE_FULL at spawn
+  uint16_t ttl;       /// Half float total lifespan (seconds)
+  uint8_t rot;        /// Rotation index, 256 steps per turn
+  Color color;        /// Color with alpha
 } TrailParticle;
 
 /**
@@ -24,7 +28,8 @@ typedef struct {
 typedef struct {
   TrailParticle p[TRAIL_MAX]; /// Array of particles
   int count;                  /// Current active particle count
-  Texture2D tex;              /// Texture for particles
+  Texture2D tex;              /// Texture (atlas) for particles
+  Rectangle src;              /// Sub-rectangle of the particle in tex
   bool additive;              /// Blending mode
   float spawnRate;            /// Particles spawned per second
   float accum;                /// Accumulated spawn time
@@ -38,11 +43,12 @@ typedef struct {
 /**
  * @brief Creates and initializes a new TrailEmitter instance.
  *
- * @param tex The texture to use for the trail particles.
+ * @param tex The texture (atlas) to use for the trail particles.
+ * @param src Sub-rectangle of the particle image inside the texture.
  * @param additive Whether to use additive blending (true) or alpha blending (false).
  * @return A fully initialized TrailEmitter object.
  */
-TrailEmitter newTrailEmitter(Texture2D tex, bool additive);
+TrailEmitter newTrailEmitter(Texture2D tex, Rectangle src, bool additive);
 
 /**
  * @brief Emits new trail particles from the emitter at the specified origin and direction.
@@ -51,8 +57,10 @@ TrailEmitter newTrailEmitter(Texture2D tex, bool additive);
  * @param origin The 3D position from which to emit particles.
  * @param dir The direction vector for particle emission.
  * @param dt Time elapsed since the last update (in seconds).
+ * @param rate_scale Fraction of the spawn rate to use (LOD), 0..1.
  */
-void trailEmit(TrailEmitter *e, Vector3 origin, Vector3 dir, float dt);
+void trailEmit(TrailEmitter *e, Vector3 origin, Vector3 dir, float dt,
+               float rate_scale);
 
 /**
  * @brief Updates the state of all active trail particles in the emitter.
@@ -68,4 +76,19 @@ void trailUpdate(TrailEmitter *e, float dt);
  * @param e Pointer to the TrailEmitter instance.
  * @param cam The Camera3D used for rendering the scene.
  */
-void trailDraw(TrailEmitter *e, Camera3D cam);
\ No newline at end of file
+void trailDraw(TrailEmitter *e, Camera3D cam);
+
+/**
+ * @brief Renders trail particles into the open billboard batch, without
+ * touching the blend mode.
+ *
+ * Lets the caller draw many emitters inside one billboardBegin(e->tex.id)
+ * block so they end up in a single draw (all emitters sample the same
+ * atlas).
+ *
+ * @param e Pointer to the TrailEmitter instance.
+ * @param cam The Camera3D used for rendering the scene.
+ * @param basis Billboard basis of the camera.
+ */
+void trailDrawParticles(TrailEmitter *e, Camera3D cam,
+                        const BillboardBasis *basis);
\ No newline at end of file
@@ -0,0 +1,50 @@
+/**
+ * @file clock.c
+ * @brief Implements the real-time and fixed-step game clock.
+ */
+#include "clock.h"
+#include "raylib.h"
+
+/**
+ * @brief Internal clock state.
+ */
+typedef struct GameClock
+{
+  bool fixed;      /// Fixed-step mode enabled.
+  float fixed_dt;  /// Step used in fixed-step mode.
+  double now;      /// Time of the current frame.
+  float dt;        /// Duration of the current frame.
+  uint64_t frames; /// Frames started so far.
+} GameClock;
+
+static GameClock game_clock = {0};
+
+void clockUseFixedStep(float dt)
+{
+  game_clock.fixed = true;
+  game_clock.fixed_dt = dt;
+}
+
+bool clockIsFixedStep(void) { return game_clock.fixed; }
+
+void clockBeginFrame(void)
+{
+  if (game_clock.fixed)
+  {
+    // Count from zero so replays never depend on when the window opened.
+    game_clock.dt = game_clock.fixed_dt;
+    game_clock.now = (double)game_clock.frames * (double)game_clock.fixed_dt;
+  }
+  else
+  {
+    game_clock.dt = GetFrameTime();
+    game_clock.now = GetTime();
+  }
+  game_clock.frames += 1;
+}
+
+double clockNow(void) { return game_clock.now; }
+
+float clockDelta(void) { return game_clock.dt; }
+
+uint64_t clockFrameIndex(void) { return game_clock.frames; }
@@ -0,0 +1,51 @@
+/**
+ * @file clock.h
+ * @brief Declares the game clock used by simulation and effects instead of
+ * raylib's wall-clock timers.
+ *
+ * In real-time mode the clock mirrors GetTime()/GetFrameTime(), sampled once
+ * per frame. In fixed-step mode every frame advances it by the same delta, so
+ * a run is reproducible regardless of how fast frames are produced.
+ */
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/// Simulation step used when recording or replaying (matches 60 FPS).
+#define CLOCK_FIXED_DT (1.0f / 60.0f)
+
+/**
+ * @brief Switches the clock to fixed-step mode.
+ *
+ * @param dt Seconds added to the clock on every frame.
+ */
+void clockUseFixedStep(float dt);
+
+/**
+ * @brief Returns true if the clock runs in fixed-step mode.
+ */
+bool clockIsFixedStep(void);
+
+/**
+ * @brief Advances the clock; call once at the start of every frame.
+ */
+void clockBeginFrame(void);
+
+/**
+ * @brief Returns the game time of the current frame, in seconds.
+ */
+double clockNow(void);
+
+/**
+ * @brief Returns the duration of the current frame, in seconds.
+ */
+float clockDelta(void);
+
+/**
+ * @brief Returns the number of frames started so far.
+ */
+uint64_t clockFrameIndex(void);
+
+#endif
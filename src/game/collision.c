@@ -0,0 +1,447 @@
+/**
+ * @file collision.c
+ * @brief Implements the collision phase: a read-only query split across
+ * worker threads and a single-threaded, deterministic resolve step.
+ */
+#define _POSIX_C_SOURCE 200809L
+#include "collision.h"
+#include "raylib.h"
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// Threads used by the collision query (--collision-threads); 0 = per CPU.
+int collision_threads = 0;
+
+/**
+ * @brief Parses --collision-threads <n>.
+ *
+ * @param argc The count of command-line arguments.
+ * @param argv The array of command-line argument strings.
+ */
+void checkCollisionThreadsFlag(int argc, char *argv[])
+{
+  for (int i = 1; i < argc - 1; i++)
+  {
+    if (strcmp(argv[i], "--collision-threads") == 0)
+    {
+      char *end = NULL;
+      long threads = strtol(argv[i + 1], &end, 10);
+      if (end == argv[i + 1] || *end != '\0' || threads < 0 ||
+          threads > COLLISION_MAX_THREADS)
+      {
+        TraceLog(LOG_WARNING,
+                 "Invalid collision thread count '%s' (0..%d). Using one "
+                 "per CPU.",
+                 argv[i + 1], COLLISION_MAX_THREADS);
+        return;
+      }
+      collision_threads = (int)threads;
+      break;
+    }
+  }
+}
+
+/**
+ * @brief Appends a hit record to a thread's buffer.
+ *
+ * @return False when memory ran out; the hit is lost and logged.
+ */
+static bool collisionPushHit(CollisionHitBuffer *buffer, uint32_t kind,
+                             uint32_t a, uint32_t b)
+{
+  if (buffer->count == buffer->capacity)
+  {
+    size_t capacity = buffer->capacity ? buffer->capacity * 2 : 64;
+    CollisionHit *items = realloc(buffer->items, capacity * sizeof(*items));
+    if (!items)
+    {
+      TraceLog(LOG_ERROR, "[Collision] out of memory for hit records");
+      return false;
+    }
+    buffer->items = items;
+    buffer->capacity = capacity;
+  }
+  buffer->items[buffer->count++] = (CollisionHit){kind, a, b};
+  return true;
+}
+
+/**
+ * @brief Query step of one thread. Only reads the snapshot and the scene;
+ * hits go to the thread's own buffer.
+ *
+ * Bullets are dealt out round-robin (bullet i goes to thread i % active),
+ * which balances the triangular bullet-pair loop across threads.
+ *
+ * @param world Pointer to the CollisionWorld.
+ * @param thread Index of the thread, 0..active-1.
+ */
+static void collisionQuery(CollisionWorld *world, int thread)
+{
+  CollisionHitBuffer *out = &world->buffers[thread];
+  const UnitList *units = world->units;
+  out->count = 0;
+  for (uint32_t i = (uint32_t)thread; i < world->bullet_count;
+       i += (uint32_t)world->active)
+  {
+    Bullet *bullet = &world->bullets[i]->self;
+    if (!bullet->alive)
+    {
+      continue;
+    }
+    BulletPosition at = world->bullet_positions[i];
+    BoundingBox box = getBulletBoundingBox(bullet, at);
+    if (bullet->owner == BULLET_OWNER_PLAYER)
+    {
+      // Every overlapped unit is recorded: an earlier record of the same
+      // resolve may kill the first one, and the bullet then goes on to the
+      // next unit it overlaps.
+      for (uint16_t k = 0; k < units->live_count; k++)
+      {
+        uint16_t slot = units->live[k];
+        if (CheckCollisionBoxes(world->unit_boxes[slot], box))
+        {
+          collisionPushHit(out, COLLISION_HIT_UNIT, slot, i);
+        }
+      }
+    }
+    else if (bullet->owner == BULLET_OWNER_UNIT &&
+             CheckCollisionBoxes(world->player_box, box))
+    {
+      collisionPushHit(out, COLLISION_HIT_PLAYER, i, 0);
+    }
+    for (uint32_t j = i + 1; j < world->bullet_count; j++)
+    {
+      if (bulletsCollide(bullet, at, &world->bullets[j]->self,
+                         world->bullet_positions[j],
+                         world->same_owner_collides))
+      {
+        collisionPushHit(out, COLLISION_HIT_BULLET, i, j);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Worker thread: runs its share of every posted query.
+ */
+static void *collisionWorkerMain(void *arg)
+{
+  CollisionWorker *worker = arg;
+  CollisionWorld *world = worker->world;
+  uint64_t seen = 0;
+
+  pthread_mutex_lock(&world->lock);
+  for (;;)
+  {
+    while (world->running && world->generation == seen)
+    {
+      pthread_cond_wait(&world->start, &world->lock);
+    }
+    if (!world->running)
+    {
+      break;
+    }
+    seen = world->generation;
+    bool takes_part = worker->index < world->active;
+    pthread_mutex_unlock(&world->lock);
+
+    if (takes_part)
+    {
+      collisionQuery(world, worker->index);
+    }
+
+    pthread_mutex_lock(&world->lock);
+    if (takes_part && --world->pending == 0)
+    {
+      pthread_cond_signal(&world->done);
+    }
+  }
+  pthread_mutex_unlock(&world->lock);
+  return NULL;
+}
+
+/**
+ * @brief Starts the collision worker threads.
+ *
+ * @param threads Threads taking part in the query, caller included; 0 picks
+ * one per CPU.
+ * @return Pointer to the CollisionWorld, or NULL on failure.
+ */
+CollisionWorld *newCollisionWorld(int threads)
+{
+  if (threads <= 0)
+  {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    threads = cpus > 0 ? (int)cpus : 1;
+  }
+  if (threads > COLLISION_MAX_THREADS)
+  {
+    threads = COLLISION_MAX_THREADS;
+  }
+  CollisionWorld *world = calloc(1, sizeof(CollisionWorld));
+  if (!world)
+  {
+    return NULL;
+  }
+  pthread_mutex_init(&world->lock, NULL);
+  pthread_cond_init(&world->start, NULL);
+  pthread_cond_init(&world->done, NULL);
+  world->running = true;
+  world->thread_count = 1;
+  for (int i = 1; i < threads; i++)
+  {
+    CollisionWorker *worker = &world->workers[i];
+    worker->world = world;
+    worker->index = i;
+    if (pthread_create(&worker->thread, NULL, collisionWorkerMain, worker) !=
+        0)
+    {
+      TraceLog(LOG_WARNING, "[Collision] started %d of %d threads",
+               world->thread_count, threads);
+      break;
+    }
+    world->thread_count += 1;
+  }
+  TraceLog(LOG_INFO, "[Collision] query on %d thread(s)",
+           world->thread_count);
+  return world;
+}
+
+/**
+ * @brief Stops the worker threads and frees the world.
+ *
+ * @param world Pointer to the CollisionWorld. Safe to pass NULL.
+ */
+void destroyCollisionWorld(CollisionWorld *world)
+{
+  if (!world)
+  {
+    return;
+  }
+  pthread_mutex_lock(&world->lock);
+  world->running = false;
+  pthread_cond_broadcast(&world->start);
+  pthread_mutex_unlock(&world->lock);
+  for (int i = 1; i < world->thread_count; i++)
+  {
+    pthread_join(world->workers[i].thread, NULL);
+  }
+  pthread_cond_destroy(&world->done);
+  pthread_cond_destroy(&world->start);
+  pthread_mutex_destroy(&world->lock);
+  for (int i = 0; i < COLLISION_MAX_THREADS; i++)
+  {
+    free(world->buffers[i].items);
+  }
+  free(world->merged);
+  free(world->bullets);
+  free(world->bullet_positions);
+  free(world->unit_boxes);
+  free(world);
+}
+
+/**
+ * @brief Captures what the query reads: bullets in list order with their
+ * positions at the current list tick, and the world box of every unit slot.
+ *
+ * Bullet positions are evaluated here, once per tick, from the closed-form
+ * trajectory; nothing stores them in between.
+ *
+ * @return False when memory ran out.
+ */
+static bool collisionSnapshot(CollisionWorld *world, UnitList *units,
+                              Player *player, BulletList *bullets)
+{
+  if (world->bullet_capacity < bullets->length)
+  {
+    BulletNode **entries =
+        realloc(world->bullets, bullets->length * sizeof(*entries));
+    if (!entries)
+    {
+      return false;
+    }
+    world->bullets = entries;
+    BulletPosition *positions = realloc(
+        world->bullet_positions, bullets->length * sizeof(*positions));
+    if (!positions)
+    {
+      return false;
+    }
+    world->bullet_positions = positions;
+    world->bullet_capacity = bullets->length;
+  }
+  world->bullet_count = 0;
+  for (BulletNode *node = bullets->head;
+       node && world->bullet_count < world->bullet_capacity;
+       node = node->next)
+  {
+    world->bullet_positions[world->bullet_count] =
+        bulletPositionAt(&node->self, bullets->tick);
+    world->bullets[world->bullet_count++] = node;
+  }
+
+  if (world->unit_capacity < units->handles.used)
+  {
+    BoundingBox *boxes =
+        realloc(world->unit_boxes, units->handles.used * sizeof(*boxes));
+    if (!boxes)
+    {
+      return false;
+    }
+    world->unit_boxes = boxes;
+    world->unit_capacity = units->handles.used;
+  }
+  for (uint16_t i = 0; i < units->live_count; i++)
+  {
+    uint16_t slot = units->live[i];
+    world->unit_boxes[slot] =
+        getUnitBoundingBox(&units->units[slot], &units->cold[slot]);
+  }
+  world->units = units;
+  world->player_box = getPlayerBoundingBox(player);
+  return true;
+}
+
+/**
+ * @brief Orders hit records by kind, then by their two indices.
+ */
+static int compareCollisionHits(const void *lhs, const void *rhs)
+{
+  const CollisionHit *a = lhs;
+  const CollisionHit *b = rhs;
+  if (a->kind != b->kind)
+    return a->kind < b->kind ? -1 : 1;
+  if (a->a != b->a)
+    return a->a < b->a ? -1 : 1;
+  if (a->b != b->b)
+    return a->b < b->b ? -1 : 1;
+  return 0;
+}
+
+/**
+ * @brief Merges the thread buffers into one sorted array.
+ *
+ * @return Number of records, or 0 when memory ran out.
+ */
+static size_t collisionMergeHits(CollisionWorld *world)
+{
+  size_t total = 0;
+  for (int i = 0; i < world->active; i++)
+  {
+    total += world->buffers[i].count;
+  }
+  if (total == 0)
+  {
+    return 0;
+  }
+  if (world->merged_capacity < total)
+  {
+    CollisionHit *merged = realloc(world->merged, total * sizeof(*merged));
+    if (!merged)
+    {
+      TraceLog(LOG_ERROR, "[Collision] out of memory for hit records");
+      return 0;
+    }
+    world->merged = merged;
+    world->merged_capacity = total;
+  }
+  size_t offset = 0;
+  for (int i = 0; i < world->active; i++)
+  {
+    memcpy(world->merged + offset, world->buffers[i].items,
+           world->buffers[i].count * sizeof(CollisionHit));
+    offset += world->buffers[i].count;
+  }
+  qsort(world->merged, total, sizeof(CollisionHit), compareCollisionHits);
+  return total;
+}
+
+/**
+ * @brief Runs the collision phase for one tick.
+ *
+ * @param world Pointer to the CollisionWorld.
+ * @param units Pointer to the enemy UnitList.
+ * @param player Pointer to the Player.
+ * @param bullets Pointer to the BulletList.
+ * @param same_owner_collides Whether bullets of the same owner collide.
+ */
+void collisionStep(CollisionWorld *world, UnitList *units, Player *player,
+                   BulletList *bullets, bool same_owner_collides)
+{
+  if (!world || !units || !player || !bullets)
+  {
+    return;
+  }
+  if (!collisionSnapshot(world, units, player, bullets))
+  {
+    TraceLog(LOG_ERROR, "[Collision] out of memory for the snapshot");
+    return;
+  }
+  world->same_owner_collides = same_owner_collides;
+
+  // Query: read-only, split across the workers
+  int active = world->bullet_count < COLLISION_PARALLEL_MIN_BULLETS
+                   ? 1
+                   : world->thread_count;
+  if (active > 1)
+  {
+    pthread_mutex_lock(&world->lock);
+    world->active = active;
+    world->pending = active - 1;
+    world->generation += 1;
+    pthread_cond_broadcast(&world->start);
+    pthread_mutex_unlock(&world->lock);
+  }
+  else
+  {
+    world->active = 1;
+  }
+  collisionQuery(world, 0);
+  if (active > 1)
+  {
+    pthread_mutex_lock(&world->lock);
+    while (world->pending > 0)
+    {
+      pthread_cond_wait(&world->done, &world->lock);
+    }
+    pthread_mutex_unlock(&world->lock);
+  }
+
+  // Resolve: one thread, fixed order
+  size_t count = collisionMergeHits(world);
+  for (size_t i = 0; i < count; i++)
+  {
+    const CollisionHit *hit = &world->merged[i];
+    switch (hit->kind)
+    {
+    case COLLISION_HIT_UNIT:
+    {
+      // Records come in slot order: a bullet is spent on the first unit it
+      // overlaps that is still alive (applyBulletHitToUnit skips the dead).
+      BulletNode *node = world->bullets[hit->b];
+      if (node->self.alive)
+      {
+        applyBulletHitToUnit(units, &units->units[hit->a], bullets, node);
+      }
+      break;
+    }
+    case COLLISION_HIT_PLAYER:
+      applyBulletHitToPlayer(player, bullets, world->bullets[hit->a]);
+      break;
+    case COLLISION_HIT_BULLET:
+    {
+      // Earlier hits may have spent either bullet; a bullet is paired with
+      // the first bullet after it that is still alive.
+      BulletNode *a = world->bullets[hit->a];
+      BulletNode *b = world->bullets[hit->b];
+      if (a->self.alive && b->self.alive)
+      {
+        destroyBulletLater(bullets, a);
+        destroyBulletLater(bullets, b);
+      }
+      break;
+    }
+    }
+  }
+}
@@ -0,0 +1,148 @@
+/**
+ * @file collision.h
+ * @brief Declares the collision phase: bullets against enemy units, the
+ * player and each other.
+ *
+ * The phase runs in two steps. The query step only reads the scene; it is
+ * split across worker threads, each writing hit records into its own
+ * buffer. The resolve step runs on the calling thread: it merges the
+ * buffers, sorts the records into one fixed order and applies them
+ * (damage, destroyed bullets, gameplay events). The outcome therefore does not
+ * depend on the number of threads or on how the work was split.
+ */
+#ifndef COLLISION_H
+#define COLLISION_H
+
+#include "../bullets/bullets.h"
+#include "../units/player.h"
+#include "../units/unit.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/// Most threads taking part in the query step (the caller included).
+#define COLLISION_MAX_THREADS 8
+
+/// Below this many bullets the query runs on the calling thread only;
+/// waking the workers would cost more than the query.
+#define COLLISION_PARALLEL_MIN_BULLETS 128
+
+/**
+ * @brief What a hit record refers to.
+ */
+typedef enum CollisionHitKind
+{
+  COLLISION_HIT_UNIT = 0,   /// Player bullet hit an enemy unit.
+  COLLISION_HIT_PLAYER = 1, /// Enemy bullet hit the player.
+  COLLISION_HIT_BULLET = 2  /// Two bullets hit each other.
+} CollisionHitKind;
+
+/**
+ * @brief One hit found by the query. Records are applied in ascending
+ * (kind, a, b) order.
+ */
+typedef struct CollisionHit
+{
+  uint32_t kind; /// CollisionHitKind.
+  uint32_t a;    /// Unit slot (unit hits), else index of the first bullet.
+  uint32_t b;    /// Bullet index (unit hits), second bullet, or 0.
+} CollisionHit;
+
+/**
+ * @brief Growable hit buffer owned by one query thread.
+ */
+typedef struct CollisionHitBuffer
+{
+  CollisionHit *items; /// Records found by the thread.
+  size_t count;        /// Records in use.
+  size_t capacity;     /// Allocated records.
+} CollisionHitBuffer;
+
+struct CollisionWorld;
+
+/**
+ * @brief A query worker thread.
+ */
+typedef struct CollisionWorker
+{
+  pthread_t thread;             /// Worker thread.
+  struct CollisionWorld *world; /// World the worker queries.
+  int index;                    /// Share of the query and hit buffer.
+} CollisionWorker;
+
+/**
+ * @brief Worker threads, per-thread buffers and the scene snapshot the
+ * query step reads.
+ */
+typedef struct CollisionWorld
+{
+  CollisionWorker workers[COLLISION_MAX_THREADS]; /// Workers (0 is the caller).
+  int thread_count;            /// Threads in the query, caller included.
+  int active;                  /// Threads taking part in the current query.
+  pthread_mutex_t lock;        /// Guards the fields below.
+  pthread_cond_t start;        /// Signalled when a query is posted.
+  pthread_cond_t done;         /// Signalled when the last worker finishes.
+  uint64_t generation;         /// Incremented for every posted query.
+  int pending;                 /// Workers still running the current query.
+  bool running;                /// Cleared to stop the workers.
+  CollisionHitBuffer buffers[COLLISION_MAX_THREADS]; /// One per thread.
+  CollisionHit *merged;        /// All records, sorted for the resolve step.
+  size_t merged_capacity;      /// Allocated merged records.
+  BulletNode **bullets;        /// Bullets in list order.
+  BulletPosition *bullet_positions; /// Position of every bullet this tick.
+  uint32_t bullet_count;       /// Bullets in the snapshot.
+  uint32_t bullet_capacity;    /// Allocated bullet entries.
+  BoundingBox *unit_boxes;     /// World box of every unit slot.
+  uint32_t unit_capacity;      /// Allocated unit boxes.
+  const UnitList *units;       /// Enemy units of the current query.
+  BoundingBox player_box;      /// World box of the player.
+  bool same_owner_collides;    /// Bullets of the same owner collide.
+} CollisionWorld;
+
+// Threads used by the collision query; set by --collision-threads <n>,
+// 0 picks one per CPU (up to COLLISION_MAX_THREADS).
+extern int collision_threads;
+
+/**
+ * @brief Parses --collision-threads <n>.
+ *
+ * @param argc The count of command-line arguments.
+ * @param argv The array of command-line argument strings.
+ */
+void checkCollisionThreadsFlag(int argc, char *argv[]);
+
+/**
+ * @brief Starts the collision worker threads.
+ *
+ * @param threads Threads taking part in the query, caller included; 0 picks
+ * one per CPU. Clamped to 1..COLLISION_MAX_THREADS.
+ * @return Pointer to the CollisionWorld, or NULL on failure.
+ */
+CollisionWorld *newCollisionWorld(int threads);
+
+/**
+ * @brief Stops the worker threads and frees the world.
+ *
+ * @param world Pointer to the CollisionWorld. Safe to pass NULL.
+ */
+void destroyCollisionWorld(CollisionWorld *world);
+
+/**
+ * @brief Runs the collision phase for one tick.
+ *
+ * Player bullets hit the first enemy unit (in slot order) they overlap that
+ * is still alive when the hit is resolved, enemy bullets hit the player,
+ * and the remaining bullets are paired off against each other in list
+ * order. Hit bullets are queued for destruction at the end of the tick.
+ *
+ * @param world Pointer to the CollisionWorld.
+ * @param units Pointer to the enemy UnitList.
+ * @param player Pointer to the Player.
+ * @param bullets Pointer to the BulletList.
+ * @param same_owner_collides Whether bullets of the same owner collide.
+ */
+void collisionStep(CollisionWorld *world, UnitList *units, Player *player,
+                   BulletList *bullets, bool same_owner_collides);
+
+#endif
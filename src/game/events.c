@@ -0,0 +1,114 @@
+/**
+ * @file events.c
+ * @brief Implements the per-tick gameplay event queue.
+ */
+#include "events.h"
+#include "raylib.h"
+#include <stdlib.h>
+
+/**
+ * @brief Internal queue state.
+ */
+typedef struct GameEventQueue
+{
+  GameEvent *items; /// Events of the current tick.
+  size_t count;     /// Events in use.
+  size_t capacity;  /// Allocated events.
+} GameEventQueue;
+
+static GameEventQueue queue = {0};
+
+/**
+ * @brief Starts a new tick: drops the events of the previous one.
+ */
+void gameEventsBegin(void)
+{
+  queue.count = 0;
+}
+
+/**
+ * @brief Appends an event to the queue of the current tick.
+ *
+ * @param event Event to append.
+ */
+void gameEventEmit(GameEvent event)
+{
+  if (queue.count == queue.capacity)
+  {
+    size_t capacity =
+        queue.capacity ? queue.capacity * 2 : GAME_EVENTS_INITIAL;
+    GameEvent *items = realloc(queue.items, capacity * sizeof(GameEvent));
+    if (!items)
+    {
+      TraceLog(LOG_ERROR, "[Events] out of memory, event %u dropped",
+               event.type);
+      return;
+    }
+    queue.items = items;
+    queue.capacity = capacity;
+  }
+  queue.items[queue.count++] = event;
+}
+
+/**
+ * @brief Returns the events emitted so far in this tick.
+ *
+ * @param count Receives the number of events.
+ * @return The events, in emission order.
+ */
+const GameEvent *gameEvents(size_t *count)
+{
+  *count = queue.count;
+  return queue.items;
+}
+
+/**
+ * @brief Log consumer: writes one line per event.
+ *
+ * @param events Events to log.
+ * @param count Number of events.
+ */
+void gameEventsLog(const GameEvent *events, size_t count)
+{
+  for (size_t i = 0; i < count; i++)
+  {
+    const GameEvent *event = &events[i];
+    switch (event->type)
+    {
+    case GAME_EVENT_HIT:
+      TraceLog(LOG_INFO, "[Units] HIT! health = %u", event->value);
+      break;
+    case GAME_EVENT_KILL:
+      TraceLog(LOG_INFO, "[Units] destroyed at %.1f, %.1f",
+               event->position.x, event->position.z);
+      break;
+    case GAME_EVENT_MISS:
+      TraceLog(LOG_INFO, "[Bullets] missed at %.1f, %.1f", event->position.x,
+               event->position.z);
+      break;
+    case GAME_EVENT_PLAYER_HIT:
+      TraceLog(LOG_INFO, "[Player] HIT! health = %u", event->value);
+      break;
+    case GAME_EVENT_SPAWN:
+      TraceLog(LOG_INFO, "[Bullets] bullet has been spawn: %f, %f, %f",
+               event->position.x, event->position.y, event->position.z);
+      break;
+    case GAME_EVENT_LEVEL_UP:
+      TraceLog(LOG_INFO, "[game] next level! (%u)", event->value);
+      break;
+    default:
+      break;
+    }
+  }
+}
+
+/**
+ * @brief Frees the queue.
+ */
+void gameEventsShutdown(void)
+{
+  free(queue.items);
+  queue.items = NULL;
+  queue.count = 0;
+  queue.capacity = 0;
+}
@@ -0,0 +1,82 @@
+/**
+ * @file events.h
+ * @brief Declares the per-tick gameplay event queue.
+ *
+ * Gameplay code does not update statistics, start effects or log from its
+ * inner loops; it appends small plain-data events to the queue instead.
+ * Consumers read the events of the tick in batches at fixed points of the
+ * game loop (see runGame), so the order of side effects is explicit.
+ */
+#ifndef EVENTS_H
+#define EVENTS_H
+
+#include "../utils/handles.h"
+#include "raylib.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/// Events the queue holds before it first has to grow.
+#define GAME_EVENTS_INITIAL 256
+
+/**
+ * @brief Kinds of gameplay events.
+ */
+typedef enum GameEventType
+{
+  GAME_EVENT_HIT = 0,    /// Player bullet hit an enemy unit.
+  GAME_EVENT_KILL,       /// Enemy unit health dropped to zero.
+  GAME_EVENT_MISS,       /// Player bullet left the field.
+  GAME_EVENT_PLAYER_HIT, /// Enemy bullet hit the player.
+  GAME_EVENT_SPAWN,      /// Bullet fired.
+  GAME_EVENT_LEVEL_UP,   /// Wave cleared, next level started.
+  GAME_EVENT_TYPE_COUNT
+} GameEventType;
+
+/**
+ * @brief One gameplay event (plain data, copied by value).
+ */
+typedef struct GameEvent
+{
+  uint8_t type;         /// GameEventType.
+  uint8_t owner;        /// BulletOwner of the bullet involved.
+  uint16_t value;       /// Health left (hits, kills) or level (level up).
+  EntityHandle subject; /// Unit handle (hit, kill) or bullet handle.
+  Vector3 position;     /// Where it happened.
+} GameEvent;
+
+/**
+ * @brief Starts a new tick: drops the events of the previous one. Call once
+ * at the start of every frame.
+ */
+void gameEventsBegin(void);
+
+/**
+ * @brief Appends an event to the queue of the current tick.
+ *
+ * @param event Event to append.
+ */
+void gameEventEmit(GameEvent event);
+
+/**
+ * @brief Returns the events emitted so far in this tick, in emission order.
+ *
+ * @param count Receives the number of events.
+ * @return The events; valid until the next gameEventEmit or
+ * gameEventsBegin.
+ */
+const GameEvent *gameEvents(size_t *count);
+
+/**
+ * @brief Log consumer: writes one line per event.
+ *
+ * @param events Events to log.
+ * @param count Number of events.
+ */
+void gameEventsLog(const GameEvent *events, size_t count);
+
+/**
+ * @brief Frees the queue.
+ */
+void gameEventsShutdown(void);
+
+#endif
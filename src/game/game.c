@@ -8,14 +8,31 @@
 #include "../models/models.h"
 #include "../parallax/parallax.h"
 #include "../raylib/rlights.h"
+#include "../render/bloom.h"
+#include "../render/capture.h"
+#include "../render/debugdraw.h"
+#include "../render/effects.h"
+#include "../render/fillrate.h"
+#include "../render/lights.h"
+#include "../render/quality.h"
+#include "../render/stream.h"
+#include "../sprites/animation.h"
 #include "../sprites/sprites.h"
 #include "../textures/textures.h"
 #include "../units/bars.h"
+#include "../units/explosion.h"
 #include "../units/player.h"
 #include "../units/unit.h"
+#include "../utils/arena.h"
 #include "../utils/debug.h"
+#include "../utils/profiler.h"
+#include "../utils/resolution.h"
+#include "clock.h"
+#include "events.h"
+#include "input.h"
 #include "levels.h"
 #include "raylib.h"
+#include "rlgl.h"
 #include "stat.h"
 #include <limits.h>
 #include <stdbool.h>
@@ -34,7 +51,7 @@
  */
 Game *newGame()
 {
-  Game *game = malloc(sizeof(Game));
+  Game *game = calloc(1, sizeof(Game));
   if (!game)
   {
     return NULL;
@@ -82,6 +99,12 @@ Game *newGame()
     destroyGame(game);
     return NULL;
   }
+  game->anims = newSpriteAnimPool();
+  if (!game->anims)
+  {
+    destroyGame(game);
+    return NULL;
+  }
   // Create a player
   ShipModel *player_model = findModelInList(game->models, MODEL_TRANSTELLAR);
   if (!player_model)
@@ -96,8 +119,15 @@ Game *newGame()
     destroyGame(game);
     return NULL;
   }
+  game->collisions = newCollisionWorld(collision_threads);
+  if (!game->collisions)
+  {
+    destroyGame(game);
+    return NULL;
+  }
   game->parallax = parallaxInit(500, (Vector2){30.0f, 80.0f},
-                                (unsigned)GetRandomValue(1, INT_MAX));
+                                (unsigned)GetRandomValue(1, INT_MAX),
+                                game->textures);
 
   game->level = getFirstLevel();
   Camera3D camera = {.position = (Vector3){0.0f, 80.0f, 40.0f},
@@ -109,11 +139,60 @@ Game *newGame()
   Light light = CreateLight(LIGHT_DIRECTIONAL, (Vector3){2, 4, 4},
                             (Vector3){0, -1, 0}, WHITE, game->models->shader);
   game->light = light;
+  game->lights = newLightManager();
+  if (!game->lights)
+  {
+    destroyGame(game);
+    return NULL;
+  }
+  game->alpha = newAlphaParticleQueue(4096);
+  if (!game->alpha)
+  {
+    destroyGame(game);
+    return NULL;
+  }
 
-  int ambientLoc = GetShaderLocation(game->models->shader, "ambient");
-  float ambient[4] = {0.3f, 0.3f, 0.3f, 1.0f};
-  SetShaderValue(game->models->shader, ambientLoc, ambient,
-                 SHADER_UNIFORM_VEC4);
+  // Shared by every lighting variant, including ones compiled later
+  float ambient[4] = {SHIP_LIGHT_AMBIENT, SHIP_LIGHT_AMBIENT,
+                      SHIP_LIGHT_AMBIENT, 1.0f};
+  setShaderVariantsValue(game->models->shaders, "ambient", ambient,
+                         SHADER_UNIFORM_VEC4);
+  Vector3 light_direction = SHIP_LIGHT_DIRECTION;
+  setShaderVariantsValue(game->models->shaders, "lightDirection",
+                         &light_direction, SHADER_UNIFORM_VEC3);
+  if (qualityBakesShipLighting())
+  {
+    // Same light setup, evaluated once per vertex instead of per pixel
+    bakeShipModelListLighting(game->models, SHIP_LIGHT_DIRECTION,
+                              SHIP_LIGHT_AMBIENT);
+  }
+
+  // Bloom is optional: without it the explosions keep their halos.
+  game->bloom = newBloom(render_width, render_height);
+
+  if (capture_offline)
+  {
+    // Offline rendering: draw off-screen at the requested size and never
+    // drop a frame, however long the encoder takes. Headless runs without a
+    // target only render (benchmarks).
+    game->target = LoadRenderTexture(render_width, render_height);
+    if (capture_target)
+    {
+      game->capture = newFrameCapture(render_width, render_height,
+                                      capture_format, capture_target, true);
+    }
+    if (game->target.id == 0 || (capture_target && !game->capture))
+    {
+      destroyGame(game);
+      return NULL;
+    }
+  }
+  else if (capture_target)
+  {
+    // Capture is optional: a failure is logged and the game runs without it.
+    game->capture = newFrameCapture(GetRenderWidth(), GetRenderHeight(),
+                                    capture_format, capture_target, false);
+  }
 
   TraceLog(LOG_INFO, "[game] Game has been created");
   return game;
@@ -132,10 +211,22 @@ void destroyGame(Game *game)
   {
     return;
   }
+  destroyFrameCapture(game->capture);
+  destroyBloom(game->bloom);
+  destroyOverdraw(game->overdraw);
+  destroyEffectsPass(game->effects);
+  destroyLightManager(game->lights);
+  destroyAlphaParticleQueue(game->alpha);
+  if (game->target.id != 0)
+  {
+    UnloadRenderTexture(game->target);
+  }
+  destroyCollisionWorld(game->collisions);
   destroyUnitList(game->enemies);
   destroyPlayer(game->player);
   destroyShipModelList(game->models);
   destroyBulletList(game->bullets);
+  destroySpriteAnimPool(game->anims);
   destroySpriteSheetList(game->sprites);
   destroyTexturesList(game->textures);
   destroyParallax(&game->parallax);
@@ -167,6 +258,7 @@ bool nextGameLevel(Game *game)
   {
     return false;
   }
+  destroyUnitList(game->enemies);
   game->enemies = enemies;
   game->player->state.health = 100;
   game->player->state.energy = 100;
@@ -198,6 +290,7 @@ void dropGameLevel(Game *game)
   {
     return;
   }
+  destroyUnitList(game->enemies);
   game->enemies = enemies;
   game->player->state.health = 100;
   game->player->state.energy = 100;
@@ -218,8 +311,8 @@ void gameOverDraw()
 
   int textW = MeasureText(text, font);
   int textH = font;
-  int x = (GetScreenWidth() - textW) / 2;
-  int y = (GetScreenHeight() - textH) / 2;
+  int x = (render_width - textW) / 2;
+  int y = (render_height - textH) / 2;
 
   DrawText(text, x + 2, y + 2, font, Fade(BLACK, 0.5f));
   DrawText(text, x, y, font, Fade(RAYWHITE, 1.0f));
@@ -240,35 +333,104 @@ void gameOverDraw()
 void runGame(Game *game)
 {
   TraceLog(LOG_INFO, "[game] starting");
-  double over_tm = GetTime();
+  double wall_start = GetTime();
+  double over_tm = clockNow();
   bool over = false;
   while (!WindowShouldClose())
   {
+    clockBeginFrame();
+    frameArenaBegin();
+    gameEventsBegin();
+    if (!inputBeginFrame())
+    {
+      TraceLog(LOG_INFO, "[game] replay finished after %llu frames",
+               (unsigned long long)(clockFrameIndex() - 1));
+      break;
+    }
     if (game->player->state.health <= 0 && !over)
     {
-      over_tm = GetTime();
+      over_tm = clockNow();
       over = true;
     }
     if (over)
     {
-      if (GetTime() - over_tm > 5.0)
+      if (clockNow() - over_tm > 5.0)
       {
         over = false;
         dropGameLevel(game);
       }
     }
-    if (!game->enemies->head)
+    if (game->enemies->length == 0)
     {
-      TraceLog(LOG_INFO, "[game] next level!");
       if (!nextGameLevel(game))
       {
         return;
       }
+      gameEventEmit((GameEvent){.type = GAME_EVENT_LEVEL_UP,
+                                .value = game->level.level,
+                                .subject = ENTITY_NONE});
     }
+    if (IsKeyPressed(KEY_B))
+    {
+      is_bloom_enabled = !is_bloom_enabled;
+    }
+    if (IsKeyPressed(KEY_F3))
+    {
+      is_profiler_enabled = !is_profiler_enabled;
+    }
+    debugDrawHandleKeys();
+    fillRateHandleKeys();
+    // Bloom supplies the glow, so the per-particle halos are only drawn
+    // without it.
+    bool bloom = game->bloom && is_bloom_enabled;
+    explosion_halos_enabled = !bloom;
+    if (is_overdraw_view && !game->overdraw)
+    {
+      game->overdraw = newOverdraw(render_width, render_height);
+      is_overdraw_view = game->overdraw != NULL;
+    }
+    // The heat map replaces the shaded scene and its post-processing; the
+    // halos still follow bloom, so it counts what would have been drawn.
+    bool heat = game->overdraw && is_overdraw_view;
+    bloom = bloom && !heat;
+    if (effects_downscale > 1 && !game->effects)
+    {
+      game->effects =
+          newEffectsPass(render_width, render_height, effects_downscale);
+      effects_downscale = game->effects ? effects_downscale : 1;
+    }
+    // Effects go to the reduced-resolution target; the heat map counts them
+    // at full resolution instead.
+    bool lowres = game->effects && !heat;
+
+    lightsBeginFrame(game->lights, clockNow());
+    profilerBeginFrame();
+    streamBeginFrame();
+    fillRateBeginFrame();
     BeginDrawing();
+    if (heat)
+    {
+      overdrawBeginScene(game->overdraw);
+    }
+    else if (lowres)
+    {
+      effectsBeginScene(game->effects);
+    }
+    else if (bloom)
+    {
+      bloomBeginScene(game->bloom);
+    }
+    else if (game->target.id != 0)
+    {
+      BeginTextureMode(game->target);
+    }
     ClearBackground(BLACK);
 
+    profilerBegin(PROFILE_SCENE);
+
     BeginMode3D(game->camera);
+    fillRateNoteMatrix();
+    alphaQueueBegin(game->alpha, &game->camera);
 
     if (is_debug_mode)
     {
@@ -276,22 +438,110 @@ void runGame(Game *game)
     }
     if (!over)
     {
-      checkBulletHitsUnits(game->enemies, game->bullets, &game->stat);
-      checkBulletHitsPlayer(game->player, game->bullets, &game->stat);
-      bulletsResolveMutualCollisions(game->bullets, false);
+      collisionStep(game->collisions, game->enemies, game->player,
+                    game->bullets, false);
+      // Effects batch: kills found by the collision phase
+      size_t count;
+      const GameEvent *events = gameEvents(&count);
+      applyEventsToUnits(game->enemies, events, count, game->sprites,
+                         game->anims, game->lights);
       selectUnitsToFire(game->enemies, game->player,
                         &game->level, 10.0, game->textures);
     }
-    drawUnits(game->enemies, &game->camera, game->sprites);
+    profilerGpuBegin(PROFILE_GPU_SHIPS);
+    drawUnits(game->enemies, &game->camera, game->sprites, game->anims,
+              game->lights);
     if (!over)
     {
       drawPlayer(game->player, &game->level, game->textures, &game->camera,
-                 game->sprites);
-      drawBullets(game->bullets, &game->camera, &game->stat);
+                 game->sprites, game->anims, game->lights);
     }
+    profilerGpuEnd(PROFILE_GPU_SHIPS);
+    if (!over)
+    {
+      advanceBullets(game->bullets);
+      profilerGpuBegin(PROFILE_GPU_BULLETS);
+      drawBullets(game->bullets, &game->camera, game->lights);
+      profilerGpuEnd(PROFILE_GPU_BULLETS);
+    }
+    // Blended effects from here on: nothing below writes depth
+    if (lowres)
+    {
+      effectsBeginParticles(game->effects, game->camera);
+    }
+    drawUnitsEffects(game->enemies, &game->camera, game->alpha);
+    if (!over)
+    {
+      drawPlayerEffects(game->player, &game->camera, game->alpha);
+      drawBulletTrails(game->bullets, &game->camera);
+    }
+    spriteAnimUpdate(game->anims, clockNow());
+    profilerGpuBegin(PROFILE_GPU_SPRITES);
+    spriteAnimDrawAll(game->anims, &game->camera, clockNow());
+    profilerGpuEnd(PROFILE_GPU_SPRITES);
     parallaxUpdate(&game->parallax, &game->camera, game->player);
-    parallaxRender(&game->parallax, &game->camera);
+    parallaxRender(&game->parallax, &game->camera, game->alpha);
+    // Stars and smoke from every emitter, back-to-front, in one batch
+    profilerGpuBegin(PROFILE_GPU_TRANSPARENT);
+    alphaQueueFlush(game->alpha, &game->camera);
+    profilerGpuEnd(PROFILE_GPU_TRANSPARENT);
+    if (lowres)
+    {
+      effectsEndParticles(game->effects, game->camera);
+    }
+    debugDrawFlushLines();
     EndMode3D();
+    fillRateNoteMatrix();
+    profilerEnd(PROFILE_SCENE);
+    // End of tick: free everything destroyed this frame in one pass, then
+    // hand the whole tick's events to the statistics and the log
+    removeUnits(game->enemies);
+    removeBullets(game->bullets);
+    {
+      size_t count;
+      const GameEvent *events = gameEvents(&count);
+      applyEventsToGameStat(&game->stat, events, count);
+      gameEventsLog(events, count);
+    }
+
+    if (lowres)
+    {
+      effectsEndScene(game->effects);
+      if (bloom)
+      {
+        bloomBeginScene(game->bloom);
+      }
+      else if (game->target.id != 0)
+      {
+        BeginTextureMode(game->target);
+      }
+      effectsComposite(game->effects);
+    }
+    if (heat)
+    {
+      overdrawEndScene(game->overdraw);
+      if (game->target.id != 0)
+      {
+        BeginTextureMode(game->target);
+      }
+      overdrawComposite(game->overdraw);
+    }
+    else if (bloom)
+    {
+      profilerBegin(PROFILE_POST);
+      profilerGpuBegin(PROFILE_GPU_POST);
+      bloomEndScene(game->bloom);
+      if (game->target.id != 0)
+      {
+        BeginTextureMode(game->target);
+      }
+      bloomComposite(game->bloom);
+      profilerGpuEnd(PROFILE_GPU_POST);
+      profilerEnd(PROFILE_POST);
+    }
+
+    profilerBegin(PROFILE_HUD);
+    profilerGpuBegin(PROFILE_GPU_HUD);
 
     if (!over)
     {
@@ -305,7 +555,44 @@ void runGame(Game *game)
     {
       gameOverDraw();
     }
+    debugDrawFlushLabels(game->camera);
+    profilerGpuEnd(PROFILE_GPU_HUD);
+    profilerEnd(PROFILE_HUD);
+    if (game->capture)
+    {
+      // Flush the batch so the readback sees the finished frame; the status
+      // line is drawn afterwards and stays out of the recording.
+      rlDrawRenderBatchActive();
+      captureFrame(game->capture);
+    }
+    if (game->target.id != 0)
+    {
+      EndTextureMode();
+      if (clockFrameIndex() % 600 == 0)
+      {
+        TraceLog(LOG_INFO, "[game] rendered %llu frames (%.0f s of gameplay)",
+                 (unsigned long long)clockFrameIndex(), clockNow());
+      }
+    }
+    else
+    {
+      if (game->capture)
+      {
+        captureDrawStats(game->capture, 10, GetScreenHeight() - 26);
+      }
+      profilerDraw(GetScreenWidth() - 260, 20, render_width * render_height);
+      fillRateDrawBreaks(GetScreenWidth() - 580, 20);
+    }
+    profilerEndFrame();
     EndDrawing();
   }
+  if (game->target.id != 0)
+  {
+    // Off-screen runs are unthrottled, so this is the renderer's throughput
+    unsigned long long frames = (unsigned long long)(clockFrameIndex() - 1);
+    double wall = GetTime() - wall_start;
+    TraceLog(LOG_INFO, "[game] %llu frames in %.2f s (%.3f ms per frame)",
+             frames, wall, frames ? wall * 1000.0 / (double)frames : 0.0);
+  }
   TraceLog(LOG_INFO, "[game] finished");
 }
\ No newline at end of file
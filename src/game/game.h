@@ -10,10 +10,18 @@
 #include "../models/models.h"
 #include "../parallax/parallax.h"
 #include "../raylib/rlights.h"
+#include "../render/bloom.h"
+#include "../render/alphaqueue.h"
+#include "../render/capture.h"
+#include "../render/effects.h"
+#include "../render/fillrate.h"
+#include "../render/lights.h"
+#include "../sprites/animation.h"
 #include "../sprites/sprites.h"
 #include "../textures/textures.h"
 #include "../units/player.h"
 #include "../units/unit.h"
+#include "collision.h"
 #include "levels.h"
 #include "raylib.h"
 #include "stat.h"
@@ -27,17 +35,26 @@
  */
 typedef struct Game
 {
-  UnitList *enemies;        /// Linked list of enemy units.
+  UnitList *enemies;        /// Enemy units (hot/cold slot tables).
   Player *player;           /// Pointer to the player instance.
   BulletList *bullets;      /// Shared bullet registry for both player and enemies.
+  CollisionWorld *collisions; /// Collision query threads and hit buffers.
   ShipModelList *models;    /// List of loaded 3D models used by the game.
   GameTextures *textures;   /// Pointer to loaded game textures.
   SpriteSheetList *sprites; /// List of loaded sprites textures/models
+  SpriteAnimPool *anims;    /// Pool of playing sprite-sheet animations.
   Camera3D camera;          /// Active 3D camera used for rendering the scene.
   Light light;              /// Scene lighting setup for shading.
+  LightManager *lights;     /// Dynamic point lights (explosions, bullets).
+  AlphaParticleQueue *alpha; /// Depth-sorted transparent particle pass.
   GameStat stat;            /// Game statistics (hits, misses, score, etc).
   Level level;              /// Current game level and parameters.
   ParallaxField parallax;   /// Parallax starfield background effect.
+  FrameCapture *capture;    /// Frame capture, NULL when not recording.
+  Bloom *bloom;             /// Bloom post-process, NULL if unavailable.
+  Overdraw *overdraw;       /// Overdraw heat map, created on first use.
+  EffectsPass *effects;     /// Reduced-resolution effects, created on first use.
+  RenderTexture2D target;   /// Off-screen frame for offline rendering (id 0 if unused).
 } Game;
 
 /**
@@ -0,0 +1,134 @@
+/**
+ * @file input.c
+ * @brief Implements per-frame input sampling with record and replay.
+ */
+#include "input.h"
+#include "raylib.h"
+#include <stdio.h>
+#include <string.h>
+
+/// File signature and format version of replay files.
+#define REPLAY_MAGIC "CLXR"
+#define REPLAY_VERSION 1u
+
+// Replay file to write, given by --record.
+const char *input_record_path = NULL;
+
+// Replay file to play, given by --replay.
+const char *input_replay_path = NULL;
+
+/**
+ * @brief Internal input state.
+ */
+typedef struct InputState
+{
+  uint8_t bits;  /// Actions held in the current frame.
+  FILE *record;  /// Replay file being written.
+  FILE *replay;  /// Replay file being read.
+} InputState;
+
+static InputState input_state = {0};
+
+/**
+ * @brief Parses --record <file> and --replay <file>.
+ *
+ * @param argc The count of command-line arguments.
+ * @param argv The array of command-line argument strings.
+ */
+void checkInputFlags(int argc, char *argv[])
+{
+  for (int i = 1; i < argc - 1; i++)
+  {
+    if (strcmp(argv[i], "--record") == 0)
+      input_record_path = argv[i + 1];
+    else if (strcmp(argv[i], "--replay") == 0)
+      input_replay_path = argv[i + 1];
+  }
+}
+
+bool inputStartRecording(const char *path, uint32_t seed, float dt)
+{
+  FILE *file = fopen(path, "wb");
+  if (!file)
+  {
+    TraceLog(LOG_WARNING, "Input: cannot create replay %s", path);
+    return false;
+  }
+  uint32_t version = REPLAY_VERSION;
+  fwrite(REPLAY_MAGIC, 1, 4, file);
+  fwrite(&version, sizeof(version), 1, file);
+  fwrite(&seed, sizeof(seed), 1, file);
+  fwrite(&dt, sizeof(dt), 1, file);
+  input_state.record = file;
+  TraceLog(LOG_INFO, "Input: recording to %s (seed %u)", path, seed);
+  return true;
+}
+
+bool inputStartReplay(const char *path, uint32_t *seed, float *dt)
+{
+  FILE *file = fopen(path, "rb");
+  if (!file)
+  {
+    TraceLog(LOG_WARNING, "Input: cannot open replay %s", path);
+    return false;
+  }
+  char magic[4];
+  uint32_t version = 0;
+  if (fread(magic, 1, 4, file) != 4 || memcmp(magic, REPLAY_MAGIC, 4) != 0 ||
+      fread(&version, sizeof(version), 1, file) != 1 ||
+      version != REPLAY_VERSION || fread(seed, sizeof(*seed), 1, file) != 1 ||
+      fread(dt, sizeof(*dt), 1, file) != 1 || !(*dt > 0.0f))
+  {
+    TraceLog(LOG_WARNING, "Input: %s is not a valid replay", path);
+    fclose(file);
+    return false;
+  }
+  input_state.replay = file;
+  TraceLog(LOG_INFO, "Input: replaying %s (seed %u)", path, *seed);
+  return true;
+}
+
+bool inputBeginFrame(void)
+{
+  if (input_state.replay)
+  {
+    int value = fgetc(input_state.replay);
+    if (value == EOF)
+      return false;
+    input_state.bits = (uint8_t)value;
+    return true;
+  }
+
+  uint8_t bits = 0;
+  if (IsKeyDown(KEY_LEFT))
+    bits |= INPUT_LEFT;
+  if (IsKeyDown(KEY_RIGHT))
+    bits |= INPUT_RIGHT;
+  if (IsKeyDown(KEY_UP))
+    bits |= INPUT_UP;
+  if (IsKeyDown(KEY_DOWN))
+    bits |= INPUT_DOWN;
+  if (IsKeyDown(KEY_SPACE))
+    bits |= INPUT_FIRE;
+  input_state.bits = bits;
+
+  if (input_state.record)
+    fputc(bits, input_state.record);
+  return true;
+}
+
+bool inputDown(uint8_t action) { return (input_state.bits & action) != 0; }
+
+void inputStop(void)
+{
+  if (input_state.record)
+  {
+    fclose(input_state.record);
+    input_state.record = NULL;
+  }
+  if (input_state.replay)
+  {
+    fclose(input_state.replay);
+    input_state.replay = NULL;
+  }
+}
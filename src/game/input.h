@@ -0,0 +1,75 @@
+/**
+ * @file input.h
+ * @brief Declares the input layer used by gameplay code: keyboard sampling
+ * once per frame, with optional recording to and replay from a file.
+ *
+ * A replay file stores the random seed, the fixed simulation step and one
+ * byte of action bits per frame, which is enough to reproduce a run exactly.
+ */
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define INPUT_LEFT (1u << 0)
+#define INPUT_RIGHT (1u << 1)
+#define INPUT_UP (1u << 2)
+#define INPUT_DOWN (1u << 3)
+#define INPUT_FIRE (1u << 4)
+
+// Replay file to write, given by --record; NULL when not recording.
+extern const char *input_record_path;
+
+// Replay file to play, given by --replay; NULL when playing live.
+extern const char *input_replay_path;
+
+/**
+ * @brief Parses --record <file> and --replay <file>.
+ *
+ * @param argc The count of command-line arguments.
+ * @param argv The array of command-line argument strings.
+ */
+void checkInputFlags(int argc, char *argv[]);
+
+/**
+ * @brief Starts writing every frame's input to a replay file.
+ *
+ * @param path Replay file path.
+ * @param seed Random seed of the run.
+ * @param dt Fixed simulation step of the run.
+ * @return true on success.
+ */
+bool inputStartRecording(const char *path, uint32_t seed, float dt);
+
+/**
+ * @brief Opens a replay file; input is then read from it instead of the
+ * keyboard.
+ *
+ * @param path Replay file path.
+ * @param seed Receives the random seed of the recorded run.
+ * @param dt Receives the fixed simulation step of the recorded run.
+ * @return true on success.
+ */
+bool inputStartReplay(const char *path, uint32_t *seed, float *dt);
+
+/**
+ * @brief Samples the input of a new frame; call once per frame.
+ *
+ * @return false when a replay has run out of frames.
+ */
+bool inputBeginFrame(void);
+
+/**
+ * @brief Returns true if an action is held in the current frame.
+ *
+ * @param action One of the INPUT_* bits.
+ */
+bool inputDown(uint8_t action);
+
+/**
+ * @brief Closes the replay file being written or read, if any.
+ */
+void inputStop(void);
+
+#endif
@@ -1,5 +1,7 @@
 #include "levels.h"
 #include "../utils/debug.h"
+#include "../utils/resolution.h"
+#include "clock.h"
 #include <raylib.h>
 #include <stdint.h>
 
@@ -36,7 +38,7 @@ Level getFirstLevel()
   level.level = 0;
   level.units = units;
   level.player = player;
-  level.label_started_at = GetTime();
+  level.label_started_at = clockNow();
   return level;
 }
 
@@ -54,7 +56,7 @@ Level getFirstLevel()
 Level goToNextLevel(Level level)
 {
   level.level += 1;
-  level.label_started_at = GetTime();
+  level.label_started_at = clockNow();
   level.units.bullet_acceleration *= (1.0f + LEVEL_PARAMS_STEP);
   level.units.bullet_init_speed *= (1.0f + LEVEL_PARAMS_STEP);
   level.units.bullet_delay_spawn *= (1.0f - LEVEL_PARAMS_STEP);
@@ -85,7 +87,7 @@ void levelDraw(Level *level)
   if (!level)
     return;
 
-  double elapsed = GetTime() - level->label_started_at;
+  double elapsed = clockNow() - level->label_started_at;
   if (elapsed >= LEVEL_LABEL_DURATION)
     return;
 
@@ -100,8 +102,8 @@ void levelDraw(Level *level)
 
   int textW = MeasureText(levelText, font);
   int textH = font;
-  int x = (GetScreenWidth() - textW) / 2;
-  int y = (GetScreenHeight() - textH) / 2;
+  int x = (render_width - textW) / 2;
+  int y = (render_height - textH) / 2;
 
   DrawText(levelText, x + 2, y + 2, font, Fade(BLACK, alpha * 0.5f));
   DrawText(levelText, x, y, font, Fade(RAYWHITE, alpha));
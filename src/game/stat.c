@@ -1,5 +1,6 @@
 
 #include "stat.h"
+#include "../utils/arena.h"
 #include "raylib.h"
 #include <stdbool.h>
 #include <stdint.h>
@@ -29,9 +30,11 @@ GameStat newGameStat()
 void gameStatDraw(GameStat *stat)
 {
 
-  const char *hitsText = TextFormat("Hits: %d", stat->hits);
-  const char *missText = TextFormat("Misses: %d", stat->misses);
-  const char *scoreText = TextFormat("Score: %d", stat->score);
+  // Frame arena strings: all three stay valid while they are measured and
+  // drawn, unlike TextFormat's few rotating buffers.
+  const char *hitsText = frameFormat("Hits: %d", stat->hits);
+  const char *missText = frameFormat("Misses: %d", stat->misses);
+  const char *scoreText = frameFormat("Score: %d", stat->score);
 
   int w = MeasureText(hitsText, GAME_STAT_FONT_SIZE);
   int w2 = MeasureText(missText, GAME_STAT_FONT_SIZE);
@@ -86,4 +89,34 @@ void addMissIntoGameStat(GameStat *stat)
 void addShootIntoGameStat(GameStat *stat)
 {
   stat->score -= (int)GAME_STAT_SHOOT_COST;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Statistics consumer of the event queue: counts hits, misses and
+ * hits taken by the player.
+ *
+ * @param stat Pointer to the GameStat structure to update.
+ * @param events Events of the current tick.
+ * @param count Number of events.
+ */
+void applyEventsToGameStat(GameStat *stat, const GameEvent *events,
+                           size_t count)
+{
+  for (size_t i = 0; i < count; i++)
+  {
+    switch (events[i].type)
+    {
+    case GAME_EVENT_HIT:
+      addHitIntoGameStat(stat);
+      break;
+    case GAME_EVENT_MISS:
+      addMissIntoGameStat(stat);
+      break;
+    case GAME_EVENT_PLAYER_HIT:
+      addShootIntoGameStat(stat);
+      break;
+    default:
+      break;
+    }
+  }
+}
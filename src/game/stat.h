@@ -1,6 +1,9 @@
 #ifndef GAME_STAT_H
 #define GAME_STAT_H
 
+#include "events.h"
+#include <stddef.h>
+
 // Game statistics display parameters
 static const unsigned int GAME_STAT_FONT_SIZE = 18;
 // Padding around the statistics text
@@ -67,4 +70,15 @@ void addMissIntoGameStat(GameStat *stat);
  */
 void addShootIntoGameStat(GameStat *stat);
 
+/**
+ * @brief Statistics consumer of the event queue: counts hits, misses and
+ * hits taken by the player.
+ *
+ * @param stat Pointer to the GameStat structure to update.
+ * @param events Events of the current tick.
+ * @param count Number of events.
+ */
+void applyEventsToGameStat(GameStat *stat, const GameEvent *events,
+                           size_t count);
+
 #endif
@@ -1,5 +1,20 @@
+#include "./game/clock.h"
+#include "./game/events.h"
 #include "./game/game.h"
+#include "./game/input.h"
+#include "./render/bloom.h"
+#include "./render/capture.h"
+#include "./render/debugdraw.h"
+#include "./render/effects.h"
+#include "./render/fillrate.h"
+#include "./render/gl.h"
+#include "./render/headless.h"
+#include "./render/particlelod.h"
+#include "./render/quality.h"
+#include "./render/stream.h"
+#include "./utils/arena.h"
 #include "./utils/debug.h"
+#include "./utils/profiler.h"
 #include "./utils/resolution.h"
 #include "raylib.h"
 #include "rlgl.h"
@@ -15,17 +30,112 @@ int main(int argc, char *argv[])
   // Check resolution flag --resolution or -r
   checkResolution(argc, argv);
 
+  // Check post-process and profiler flags --no-bloom and --profile
+  checkBloomFlag(argc, argv);
+  checkProfilerFlag(argc, argv);
+
+  // Check collision query threads --collision-threads
+  checkCollisionThreadsFlag(argc, argv);
+
+  // Check rendering quality tier --quality
+  checkQualityFlag(argc, argv);
+
+  // Check particle LOD flag --no-particle-lod
+  checkParticleLodFlag(argc, argv);
+
+  // Check fill-rate debug views --overdraw and --batch-breaks
+  checkFillRateFlags(argc, argv);
+
+  // Check effects resolution --effects-res
+  checkEffectsFlag(argc, argv);
+
+  // Check streamed vertex ring flag --no-stream
+  checkStreamFlag(argc, argv);
+
+  // Check capture flags --capture and --capture-format
+  checkCaptureFlags(argc, argv);
+
+  // Check replay flags --record and --replay
+  checkInputFlags(argc, argv);
+
+  // Check offline render size --render-size
+  checkRenderSize(argc, argv);
+
+  // Headless builds have no window to present to: every frame takes the
+  // offline path, and is dumped only when --render or --capture names a
+  // target.
+  if (is_headless)
+  {
+    capture_offline = true;
+  }
+
+  // Scratch memory for transient per-frame data; rendering runs on this
+  // thread, so one buffer is enough.
+  frameArenaInit(FRAME_ARENA_BUDGET, 1);
+
   if (is_debug_mode)
   {
     TraceLog(LOG_INFO, "[DEBUG] Debug mode is ON");
+    debug_draw_layers = DEBUG_LAYER_AABB;
   }
 
   uint32_t seed = (uint32_t)time(NULL);
-  srand(seed);
+  if (input_replay_path)
+  {
+    // A replay dictates the seed and the simulation step.
+    float dt = CLOCK_FIXED_DT;
+    if (!inputStartReplay(input_replay_path, &seed, &dt))
+    {
+      return 1;
+    }
+    clockUseFixedStep(dt);
+  }
+  else if (capture_offline)
+  {
+    TraceLog(LOG_ERROR, is_headless ? "Headless builds need --replay <file>"
+                                    : "--render requires --replay <file>");
+    return 1;
+  }
+  else if (input_record_path)
+  {
+    // Recording runs the simulation at a fixed step so it can be replayed.
+    clockUseFixedStep(CLOCK_FIXED_DT);
+    if (!inputStartRecording(input_record_path, seed, CLOCK_FIXED_DT))
+    {
+      return 1;
+    }
+  }
   TraceLog(LOG_INFO, "Starting");
 
+  if (capture_offline)
+  {
+    // Nothing is presented: frames go to an off-screen target.
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+  }
+  headlessBeforeInit();
   InitWindow(resolution_width, resolution_height, "Ceelaxy");
-  SetTargetFPS(60);
+  // The renderer's own GL calls go to the context raylib just created.
+  if (!headlessAfterInit() || !loadGlFunctions())
+  {
+    inputStop();
+    return 1;
+  }
+  if (!capture_offline)
+  {
+    SetTargetFPS(60);
+  }
+  // Needs a GL context to look at the renderer.
+  resolveQualityTier();
+  streamInit();
+  if (!capture_offline || render_width <= 0 || render_height <= 0)
+  {
+    render_width = GetScreenWidth();
+    render_height = GetScreenHeight();
+  }
+
+  // InitWindow reseeds raylib's generator, so seed both generators here.
+  srand(seed);
+  SetRandomSeed(seed);
 
   Game *game = newGame(resolution_height, resolution_width);
 
@@ -38,6 +148,16 @@ int main(int argc, char *argv[])
 
   destroyGame(game);
 
+  profilerShutdown();
+
+  streamShutdown();
+
+  frameArenaShutdown();
+
+  gameEventsShutdown();
+
+  inputStop();
+
   CloseWindow();
 
   return 0;
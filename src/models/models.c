@@ -13,10 +13,12 @@
  * Example model set includes "CamoStellarJet", "RedFighter", etc.
  */
 #include "models.h"
-#include "../utils/debug.h"
+#include "../render/debugdraw.h"
+#include "../render/gl.h"
 #include "../utils/path.h"
 #include "raylib.h"
 #include "rlgl.h"
+#include <math.h>
 #include <raymath.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -46,6 +48,13 @@
  */
 #define MODEL_PNG_EXT ".png"
 
+/**
+ * @def MESH_VBO_COLORS
+ * @brief Slot of the color buffer in raylib's `Mesh.vboId`, which is also the
+ * attribute location raylib binds "vertexColor" to.
+ */
+#define MESH_VBO_COLORS 3
+
 /**
  * @brief Constructs a full file path to a model asset file.
  *
@@ -134,19 +143,13 @@ ShipModel *loadShipModel(const char *filename, ModelId id) {
   box.by_x = combined.max.x - combined.min.x;
   box.by_y = combined.max.y - combined.min.y;
   box.by_z = combined.max.z - combined.min.z;
-  if (is_debug_mode) {
-    Mesh box_mesh = GenMeshCube(box.by_x, box.by_y, box.by_z);
-    Model box_model = LoadModelFromMesh(box_mesh);
-    ship->box_model = malloc(sizeof(Model));
-    *ship->box_model = box_model;
-  } else {
-    ship->box_model = NULL;
-  };
   ship->model = model;
   ship->texture = texture;
   ship->model_name = filename;
   ship->id = id;
   ship->box = box;
+  ship->shaders = NULL;
+  ship->baked = false;
   return ship;
 }
 
@@ -167,6 +170,146 @@ void setShipModelColor(ShipModel *model, Color color) {
   material->maps[MATERIAL_MAP_DIFFUSE].color = color;
 }
 
+/**
+ * @brief Uploads the color attribute of a mesh that was loaded without one.
+ *
+ * The buffer is attached to the mesh's vertex array at raylib's color
+ * attribute location and kept in `vboId`/`colors`, so UnloadMesh releases it.
+ *
+ * @param mesh Pointer to the mesh; `mesh->colors` must be filled.
+ */
+static void uploadMeshColors(Mesh *mesh) {
+  size_t size = (size_t)mesh->vertexCount * 4 * sizeof(unsigned char);
+  if (mesh->vboId[MESH_VBO_COLORS] != 0) {
+    UpdateMeshBuffer(*mesh, MESH_VBO_COLORS, mesh->colors, (int)size,
+                     0);
+    return;
+  }
+  GLuint vbo = 0;
+  glBindVertexArray(mesh->vaoId);
+  glGenBuffers(1, &vbo);
+  glBindBuffer(GL_ARRAY_BUFFER, vbo);
+  glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)size, mesh->colors,
+               GL_STATIC_DRAW);
+  glVertexAttribPointer(MESH_VBO_COLORS, 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, 0);
+  glEnableVertexAttribArray(MESH_VBO_COLORS);
+  glBindVertexArray(0);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  mesh->vboId[MESH_VBO_COLORS] = vbo;
+}
+
+/**
+ * @brief Bakes the static directional and ambient light into vertex colors.
+ *
+ * Evaluates the same diffuse term as lighting.fs for every vertex, in the
+ * model's rest orientation, and uploads the result as the mesh color
+ * attribute. Calling it again with another light setup re-uploads the
+ * colors. Baked ships can then be drawn with the unlit variant.
+ *
+ * @param model Pointer to the ShipModel to bake.
+ * @param direction Direction the light travels in.
+ * @param ambient Ambient intensity added to the diffuse term.
+ */
+void bakeShipModelLighting(ShipModel *model, Vector3 direction, float ambient) {
+  if (!model) {
+    return;
+  }
+  Vector3 to_light = Vector3Negate(Vector3Normalize(direction));
+  // Normals follow the load-time transform the same way the vertex shader
+  // transforms them (inverse transpose).
+  Matrix normal_matrix = MatrixTranspose(MatrixInvert(model->model.transform));
+  for (int m = 0; m < model->model.meshCount; m++) {
+    Mesh *mesh = &model->model.meshes[m];
+    if (!mesh->normals || mesh->vaoId == 0) {
+      continue;
+    }
+    if (!mesh->colors) {
+      mesh->colors = MemAlloc((unsigned)mesh->vertexCount * 4);
+      if (!mesh->colors) {
+        continue;
+      }
+    }
+    for (int v = 0; v < mesh->vertexCount; v++) {
+      Vector3 n = {mesh->normals[v * 3], mesh->normals[v * 3 + 1],
+                   mesh->normals[v * 3 + 2]};
+      n = Vector3Normalize(Vector3Transform(n, normal_matrix));
+      float diff = fmaxf(Vector3DotProduct(n, to_light), 0.0f);
+      // Vertex colors are normalized bytes: ambient + diffuse saturates at 1
+      float light = Clamp(ambient + diff, 0.0f, 1.0f);
+      unsigned char c = (unsigned char)(light * 255.0f + 0.5f);
+      mesh->colors[v * 4] = c;
+      mesh->colors[v * 4 + 1] = c;
+      mesh->colors[v * 4 + 2] = c;
+      mesh->colors[v * 4 + 3] = 255;
+    }
+    uploadMeshColors(mesh);
+  }
+  model->baked = true;
+}
+
+/**
+ * @brief Bakes the static lighting of every model in the list.
+ *
+ * @param models Pointer to the ShipModelList.
+ * @param direction Direction the light travels in.
+ * @param ambient Ambient intensity added to the diffuse term.
+ */
+void bakeShipModelListLighting(ShipModelList *models, Vector3 direction,
+                               float ambient) {
+  if (!models) {
+    return;
+  }
+  for (ShipModelNode *node = models->head; node; node = node->next) {
+    bakeShipModelLighting(node->self, direction, ambient);
+  }
+  TraceLog(LOG_INFO, "[Models] static lighting baked into %zu models",
+           models->length);
+}
+
+/**
+ * @brief Selects the cheapest lighting variant for the next draw of a ship.
+ *
+ * Picks the point lights reaching the ship, compiles (or reuses) the variant
+ * for that light count plus the hit tint when needed, uploads the lights and
+ * assigns the variant to the model's material. With `baked` set and the model
+ * baked, the unlit variant is used and point lights are skipped.
+ *
+ * @param model Pointer to the ShipModel about to be drawn.
+ * @param lights Pointer to the light manager (may be NULL).
+ * @param center World position of the ship.
+ * @param hit Whether the ship is drawn with the red hit tint.
+ * @param baked Use the baked vertex lighting when available.
+ */
+void bindShipModelShader(ShipModel *model, LightManager *lights,
+                         Vector3 center, bool hit, bool baked) {
+  if (!model || !model->shaders) {
+    return;
+  }
+  if (baked && model->baked) {
+    unsigned key = SHADER_UNLIT | (hit ? SHADER_HIT_TINT : 0);
+    model->model.materials[0].shader =
+        getShaderVariant(model->shaders, key)->shader;
+    return;
+  }
+  LightSelection selection =
+      lightsSelectForObject(lights, center, SHIP_LIGHT_RADIUS);
+  unsigned key = SHADER_POINT_LIGHTS(selection.count);
+  if (hit) {
+    key |= SHADER_HIT_TINT;
+  }
+  const ShaderVariant *variant = getShaderVariant(model->shaders, key);
+  lightsUpload(&selection, variant);
+  debugDrawSphere(DEBUG_LAYER_CULLING, center, SHIP_LIGHT_RADIUS, YELLOW);
+  for (int i = 0; i < selection.count; i++) {
+    Vector3 light = {selection.position[i * 4], selection.position[i * 4 + 1],
+                     selection.position[i * 4 + 2]};
+    debugDrawLine(DEBUG_LAYER_CULLING, center, light, YELLOW);
+    debugDrawSphere(DEBUG_LAYER_CULLING, light, selection.position[i * 4 + 3],
+                    Fade(YELLOW, 0.3f));
+  }
+  model->model.materials[0].shader = variant->shader;
+}
+
 /**
  * @brief Frees all memory and GPU resources associated with a ShipModel.
  *
@@ -177,10 +320,6 @@ void setShipModelColor(ShipModel *model, Color color) {
 void destroyShipModel(ShipModel *ship) {
   TraceLog(LOG_INFO, "[Models] model will be unload \"%s\"", ship->model_name);
   UnloadModel(ship->model);
-  if (ship->box_model) {
-    UnloadModel(*ship->box_model);
-    free(ship->box_model);
-  }
   UnloadTexture(ship->texture);
   TraceLog(LOG_INFO, "[Models] model \"%s\" has been unload", ship->model_name);
   free(ship);
@@ -232,7 +371,7 @@ const char *getModelNameById(ModelId id) {
 /**
  * @brief Loads all predefined models into a ShipModelList.
  *
- * This function initializes the shader from lighting.vs/fs files,
+ * This function loads the lighting.vs/fs sources into a variant cache,
  * iterates over a hardcoded list of model names, loads each,
  * and stores them in a doubly-linked list.
  *
@@ -251,14 +390,20 @@ ShipModelList *newShipModelList() {
   models->head = NULL;
   models->tail = NULL;
 
-  // Create shader
+  // Load lighting shader sources; variants are compiled on demand
   char *vs_file = path_join(LIGHTS, "lighting.vs");
   char *fs_file = path_join(LIGHTS, "lighting.fs");
 
-  Shader shader = LoadShader(vs_file, fs_file);
+  models->shaders = newShaderVariantCache(vs_file, fs_file);
 
   free(vs_file);
   free(fs_file);
+  if (!models->shaders) {
+    TraceLog(LOG_ERROR, "[Models] Fail to load lighting shader");
+    free(models);
+    return NULL;
+  }
+  models->shader = getShaderVariant(models->shaders, 0)->shader;
 
   for (int id = 0; id < MODEL_ID_COUNT; id++) {
     const char *name = getModelNameById(id);
@@ -268,6 +413,8 @@ ShipModelList *newShipModelList() {
       destroyShipModelList(models);
       return NULL;
     }
+    node->self->shaders = models->shaders;
+    node->self->model.materials[0].shader = models->shader;
     if (!models->head) {
       models->head = node;
     }
@@ -278,7 +425,6 @@ ShipModelList *newShipModelList() {
     models->length += 1;
     TraceLog(LOG_INFO, "Model %s has been loaded", name);
   }
-  models->shader = shader;
   return models;
 }
 
@@ -326,6 +472,6 @@ void destroyShipModelList(ShipModelList *models) {
   }
   models->head = models->tail = NULL;
   models->length = 0;
-  UnloadShader(models->shader);
+  destroyShaderVariantCache(models->shaders);
   free(models);
 }
@@ -1,11 +1,23 @@
 #ifndef MODELS_H
 #define MODELS_H
 
+#include "../render/lights.h"
+#include "../render/shaders.h"
 #include "raylib.h"
+#include <stdbool.h>
 #include <stddef.h> // For size_t
 
 #include <string.h>
 
+/// Bounding radius of a ship used to pick the point lights that reach it.
+#define SHIP_LIGHT_RADIUS 3.0f
+
+/// Direction of the static directional light shared by all ships.
+#define SHIP_LIGHT_DIRECTION ((Vector3){-0.5f, -1.0f, -0.3f})
+
+/// Constant ambient term added to the directional light.
+#define SHIP_LIGHT_AMBIENT 0.3f
+
 typedef enum ModelId {
   MODEL_CAMO_STELLAR_JET = 0,
   MODEL_DUAL_STRIKER,
@@ -42,7 +54,8 @@ typedef struct ShipModel {
   const char *model_name; ///< Name of the model (without extension or path).
   ModelId id;
   ShipBoundingBox box;
-  Model *box_model;
+  ShaderVariantCache *shaders; ///< Lighting shader variants (not owned).
+  bool baked; ///< Vertex colors hold the static lighting (see bake below).
 } ShipModel;
 
 /**
@@ -61,7 +74,8 @@ typedef struct ShipModelNode {
 typedef struct {
   ShipModelNode *head; ///< Pointer to the first node in the list.
   ShipModelNode *tail; ///< Pointer to the last node in the list.
-  Shader shader;       ///< Shared shader used by all models in the list.
+  Shader shader;       ///< Base lighting variant (owned by `shaders`).
+  ShaderVariantCache *shaders; ///< Lighting shader variants for all models.
   size_t length;       ///< Number of models in the list.
 } ShipModelList;
 
@@ -76,6 +90,47 @@ typedef struct {
  */
 void setShipModelColor(ShipModel *model, Color color);
 
+/**
+ * @brief Bakes the static directional and ambient light into vertex colors.
+ *
+ * Evaluates the same diffuse term as lighting.fs for every vertex, in the
+ * model's rest orientation, and uploads the result as the mesh color
+ * attribute. Calling it again with another light setup re-uploads the
+ * colors. Baked ships can then be drawn with the unlit variant.
+ *
+ * @param model Pointer to the ShipModel to bake.
+ * @param direction Direction the light travels in.
+ * @param ambient Ambient intensity added to the diffuse term.
+ */
+void bakeShipModelLighting(ShipModel *model, Vector3 direction, float ambient);
+
+/**
+ * @brief Bakes the static lighting of every model in the list.
+ *
+ * @param models Pointer to the ShipModelList.
+ * @param direction Direction the light travels in.
+ * @param ambient Ambient intensity added to the diffuse term.
+ */
+void bakeShipModelListLighting(ShipModelList *models, Vector3 direction,
+                               float ambient);
+
+/**
+ * @brief Selects the cheapest lighting variant for the next draw of a ship.
+ *
+ * Picks the point lights reaching the ship, compiles (or reuses) the variant
+ * for that light count plus the hit tint when needed, uploads the lights and
+ * assigns the variant to the model's material. With `baked` set and the model
+ * baked, the unlit variant is used and point lights are skipped.
+ *
+ * @param model Pointer to the ShipModel about to be drawn.
+ * @param lights Pointer to the light manager (may be NULL).
+ * @param center World position of the ship.
+ * @param hit Whether the ship is drawn with the red hit tint.
+ * @param baked Use the baked vertex lighting when available.
+ */
+void bindShipModelShader(ShipModel *model, LightManager *lights,
+                         Vector3 center, bool hit, bool baked);
+
 /**
  * @brief Frees a ShipModelNode and its associated model.
  *
@@ -39,39 +39,31 @@ const float MOVEMENT_MAX_Z = 1.0f;
   (MOVEMENT_DIRECTION_FORWARD | MOVEMENT_DIRECTION_BACKWARD)
 
 /**
- * @brief Allocates and initializes a new MovementAction with default
- * oscillation behavior.
+ * @brief Initializes a new MovementAction with default oscillation behavior.
  *
  * Sets a random initial direction, bounds, and angle/rotation constraints.
  * Also assigns randomized speed values via randSpeedMovementAction().
  *
- * @return Pointer to a newly allocated MovementAction, or NULL on failure.
+ * @return A MovementAction with a random direction and speed.
  */
-MovementAction *newMovementAction()
+MovementAction newMovementAction()
 {
-  MovementAction *action = malloc(sizeof(MovementAction));
-  if (!action)
-  {
-    return NULL;
-  }
-  action->direction =
+  MovementAction action;
+  action.direction =
       (rand() % 2 ? MOVEMENT_DIRECTION_LEFT : MOVEMENT_DIRECTION_RIGHT) |
       (rand() % 2 ? MOVEMENT_DIRECTION_FORWARD : MOVEMENT_DIRECTION_BACKWARD);
-  action->max_x = MOVEMENT_MAX_X;
-  action->max_y = MOVEMENT_MAX_Y;
-  action->max_z = MOVEMENT_MAX_Z;
-  action->x = 0.0f;
-  action->y = 0.0f;
-  action->z = 0.0f;
-  action->max_rotate_x = 10.0f;
-  action->max_rotate_z = 15.0f;
-  action->max_rotate_y = 0;
-  action->rotate_x = 0.0f;
-  action->rotate_y = 0.0f;
-  action->rotate_z = 0.0f;
-  action->max_angle = 15.0f;
-  action->angle = 0.0f;
-  randSpeedMovementAction(action, 1.0f);
+  action.max_x = MOVEMENT_MAX_X;
+  action.max_y = MOVEMENT_MAX_Y;
+  action.max_z = MOVEMENT_MAX_Z;
+  action.max_rotate_x = 10.0f;
+  action.max_rotate_z = 15.0f;
+  action.max_rotate_y = 0;
+  action.rotate_x = 0.0f;
+  action.rotate_y = 0.0f;
+  action.rotate_z = 0.0f;
+  action.max_angle = 15.0f;
+  action.angle = 0.0f;
+  randSpeedMovementAction(&action, 1.0f);
   return action;
 }
 
@@ -118,23 +110,25 @@ void randSpeedMovementAction(MovementAction *action, float slow_factor)
  * - Introduces natural oscillation-like behavior.
  *
  * @param action Pointer to the MovementAction to iterate.
+ * @param offset Pointer to the offset the action accumulates into.
  */
-void iterateMovementAction(MovementAction *action, float slow_factor)
+void iterateMovementAction(MovementAction *action, MovementOffset *offset,
+                           float slow_factor)
 {
-  if (!action)
+  if (!action || !offset)
   {
     return;
   }
   if (action->direction & MOVEMENT_X_MASK)
   {
-    if (fabsf(action->x) <= action->max_x)
+    if (fabsf(offset->x) <= action->max_x)
     {
-      action->x += (action->step_x) *
+      offset->x += (action->step_x) *
                    (action->direction & MOVEMENT_DIRECTION_LEFT ? -1 : 1);
     }
     else
     {
-      action->x = action->max_x * (action->x > 0 ? 1 : -1);
+      offset->x = action->max_x * (offset->x > 0 ? 1 : -1);
       if (action->direction & MOVEMENT_DIRECTION_LEFT)
       {
         action->direction &= (uint8_t)~(uint8_t)MOVEMENT_DIRECTION_LEFT;
@@ -147,9 +141,9 @@ void iterateMovementAction(MovementAction *action, float slow_factor)
       }
       randSpeedMovementAction(action, slow_factor);
     }
-    action->rotate_z = -action->max_rotate_z * (action->x / action->max_x);
+    action->rotate_z = -action->max_rotate_z * (offset->x / action->max_x);
     action->angle = action->max_angle *
-                    ((action->max_x - fabsf(action->x)) - action->max_x);
+                    ((action->max_x - fabsf(offset->x)) - action->max_x);
   }
   else
   {
@@ -157,14 +151,14 @@ void iterateMovementAction(MovementAction *action, float slow_factor)
   }
   if (action->direction & MOVEMENT_Y_MASK)
   {
-    if (fabsf(action->y) <= action->max_y)
+    if (fabsf(offset->y) <= action->max_y)
     {
-      action->y += (action->step_y) *
+      offset->y += (action->step_y) *
                    (action->direction & MOVEMENT_DIRECTION_UP ? -1 : 1);
     }
     else
     {
-      action->y = action->max_y * (action->y > 0 ? 1 : -1);
+      offset->y = action->max_y * (offset->y > 0 ? 1 : -1);
       if (action->direction & MOVEMENT_DIRECTION_UP)
       {
         action->direction &= (uint8_t)~(uint8_t)MOVEMENT_DIRECTION_UP;
@@ -180,14 +174,14 @@ void iterateMovementAction(MovementAction *action, float slow_factor)
   }
   if (action->direction & MOVEMENT_Z_MASK)
   {
-    if (fabsf(action->z) <= action->max_z)
+    if (fabsf(offset->z) <= action->max_z)
     {
-      action->z += (action->step_z) *
+      offset->z += (action->step_z) *
                    (action->direction & MOVEMENT_DIRECTION_FORWARD ? -1 : 1);
     }
     else
     {
-      action->z = action->max_z * (action->z > 0 ? 1 : -1);
+      offset->z = action->max_z * (offset->z > 0 ? 1 : -1);
       if (action->direction & MOVEMENT_DIRECTION_FORWARD)
       {
         action->direction &= (uint8_t)~(uint8_t)MOVEMENT_DIRECTION_FORWARD;
@@ -200,25 +194,12 @@ void iterateMovementAction(MovementAction *action, float slow_factor)
       }
       randSpeedMovementAction(action, slow_factor);
     }
-    action->rotate_x = action->max_rotate_x * (action->z / action->max_z);
+    action->rotate_x = action->max_rotate_x * (offset->z / action->max_z);
     action->angle = action->max_angle *
-                    ((action->max_z - fabsf(action->z)) - action->max_z);
+                    ((action->max_z - fabsf(offset->z)) - action->max_z);
   }
   else
   {
     action->rotate_x = 0.0f;
   }
 }
-
-/**
- * @brief Deallocates memory associated with the given MovementAction.
- *
- * @param action Pointer to the MovementAction to destroy.
- */
-void destroyMovementAction(MovementAction *action)
-{
-  if (action)
-  {
-    free(action);
-  }
-}
\ No newline at end of file
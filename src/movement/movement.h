@@ -30,10 +30,22 @@ typedef enum MovementDirection
 } MovementDirection;
 
 /**
- * @brief Represents the full dynamic movement state of a unit.
+ * @brief Displacement accumulated by a movement action, added to the
+ * position of the unit.
+ */
+typedef struct MovementOffset
+{
+  float x; /// Accumulated offset along X axis.
+  float y; /// Accumulated offset along Y axis.
+  float z; /// Accumulated offset along Z axis.
+} MovementOffset;
+
+/**
+ * @brief Represents the dynamic movement state of a unit.
  *
- * Includes direction, movement speed per axis, rotation angles, bounds,
- * and accumulated displacement for animations or physics effects.
+ * Includes direction, movement speed per axis, rotation angles and bounds.
+ * The displacement it produces is kept apart in a MovementOffset, so it can
+ * live next to the position it is added to.
  */
 typedef struct MovementAction
 {
@@ -52,17 +64,14 @@ typedef struct MovementAction
   float max_x;        /// Max position delta along X.
   float max_y;        /// Max position delta along Y.
   float max_z;        /// Max position delta along Z.
-  float x;            /// Accumulated offset along X axis.
-  float y;            /// Accumulated offset along Y axis.
-  float z;            /// Accumulated offset along Z axis.
 } MovementAction;
 
 /**
- * @brief Allocates and initializes a new MovementAction with default values.
+ * @brief Initializes a new MovementAction with default values.
  *
- * @return Pointer to a newly allocated MovementAction, or NULL on failure.
+ * @return A MovementAction with a random direction and speed.
  */
-MovementAction *newMovementAction();
+MovementAction newMovementAction();
 
 /**
  * @brief Advances the current movement and rotation values based on internal
@@ -72,15 +81,10 @@ MovementAction *newMovementAction();
  * motion.
  *
  * @param action Pointer to the MovementAction to update.
+ * @param offset Pointer to the offset the action accumulates into.
  */
-void iterateMovementAction(MovementAction *action, float slow_factor);
-
-/**
- * @brief Frees memory used by a MovementAction.
- *
- * @param action Pointer to the MovementAction to destroy.
- */
-void destroyMovementAction(MovementAction *action);
+void iterateMovementAction(MovementAction *action, MovementOffset *offset,
+                           float slow_factor);
 
 /**
  * @brief Assigns random movement speeds and directions to the action.
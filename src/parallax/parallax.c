@@ -5,6 +5,7 @@
 // ================================================
 
 #include "parallax.h"
+#include "../game/clock.h"
 #include "../units/player.h"
 
 #include <limits.h>
@@ -28,16 +29,6 @@ static inline float frand01(unsigned int *state)
   return (float)(*state) / (float)UINT_MAX;
 }
 
-// Create a simple 1x1 white texture for point sprites.
-static Texture2D makeDotTexture(void)
-{
-  // 1x1 white tex; swap to a round sprite if you have one.
-  Image img = GenImageColor(1, 1, WHITE);
-  Texture2D t = LoadTextureFromImage(img);
-  UnloadImage(img);
-  return t;
-}
-
 // Apply alpha to a Color, clamping to [0..255].
 static Color colorWithAlpha(Color c, float a)
 {
@@ -118,10 +109,11 @@ static void randomizeParticle(ParallaxField *field, ParallaxParticle *pp,
  * @param particleCount Number of particles to create.
  * @param halfExtentXZ Half-size of the field in X and Z directions (world units).
  * @param seed Random seed for particle distribution.
+ * @param textures Game textures; stars use the dot from the particle atlas.
  * @return Initialized ParallaxField structure.
  */
 ParallaxField parallaxInit(int particleCount, Vector2 halfExtentXZ,
-                           unsigned int seed)
+                           unsigned int seed, GameTextures *textures)
 {
   ParallaxField field = (ParallaxField){0};
 
@@ -134,7 +126,13 @@ ParallaxField parallaxInit(int particleCount, Vector2 halfExtentXZ,
   field.yNear = -2.0f;
   field.respawnMargin = 24.0f; // softer wrap edges
 
-  field.dotTex = makeDotTexture();
+  // Solid dot from the shared particle atlas (no texture switch vs. effects)
+  GameTexture *dot = getGameTextureById(textures, TEX_ID_DOT);
+  if (dot)
+  {
+    field.dotTex = dot->tex;
+    field.dotSrc = dot->src;
+  }
 
   // Default motion tuning
   field.baseForwardSpeedZ = +28.0f; // constant forward flow (+Z)
@@ -183,8 +181,6 @@ void destroyParallax(ParallaxField *field)
 {
   if (!field)
     return;
-  if (field->dotTex.id)
-    UnloadTexture(field->dotTex);
   if (field->p)
   {
     MemFree(field->p);
@@ -204,7 +200,7 @@ void parallaxUpdate(ParallaxField *field, const Camera3D *cam,
   if (!field || !cam || !player)
     return;
 
-  const float dt = GetFrameTime();
+  const float dt = clockDelta();
   field->time += dt;
 
   // Raw player velocity in XZ
@@ -323,17 +319,19 @@ void parallaxUpdate(ParallaxField *field, const Camera3D *cam,
  *
  * @param field Pointer to the ParallaxField to render.
  * @param cam Pointer to the active Camera3D for view/projection.
+ * @param alpha Transparent pass queue receiving the stars.
  */
-void parallaxRender(const ParallaxField *field, const Camera3D *cam)
+void parallaxRender(const ParallaxField *field, const Camera3D *cam,
+                    AlphaParticleQueue *alpha)
 {
-  if (!field || !cam)
+  if (!field || !cam || !alpha)
     return;
 
-  // Alpha blending for maximum visibility; switch to BLEND_ADDITIVE for glow.
-  BeginBlendMode(BLEND_ALPHA);
-
-  // World up works well for top-down too.
-  const Vector3 upBill = (Vector3){0, 1, 0};
+  // Alpha blended: queued and depth-sorted with the other transparent particles.
+  const Rectangle uv = {field->dotSrc.x / (float)field->dotTex.width,
+                        field->dotSrc.y / (float)field->dotTex.height,
+                        field->dotSrc.width / (float)field->dotTex.width,
+                        field->dotSrc.height / (float)field->dotTex.height};
 
   for (int i = 0; i < field->count; ++i)
   {
@@ -341,14 +339,9 @@ void parallaxRender(const ParallaxField *field, const Camera3D *cam)
 
     const float base = pp->size;
     const Vector2 size = (Vector2){base, base * (1.0f + pp->streak * 6.0f)};
-    const Rectangle src =
-        (Rectangle){0, 0, (float)field->dotTex.width, (float)field->dotTex.height};
     const Color tint = colorWithAlpha(pp->tint, pp->alpha);
 
-    // rotation = 0; we rely on 'upBill' only.
-    DrawBillboardPro(*cam, field->dotTex, src, pp->pos, upBill, size,
-                     (Vector2){0.5f, 0.5f}, 0.0f, tint);
+    // rotation = 0; billboards keep world up, which works for top-down too.
+    alphaQueuePush(alpha, field->dotTex.id, pp->pos, size, 0.0f, uv, tint);
   }
-
-  EndBlendMode();
 }
@@ -3,6 +3,7 @@
 #include "raymath.h"
 #include <stdbool.h>
 #include <stddef.h>
+#include "../render/alphaqueue.h"
 #include "../units/player.h"
 
 /**
@@ -35,7 +36,8 @@ typedef struct
   float yFar, yMid, yNear;
   float respawnMargin;
 
-  Texture2D dotTex;
+  Texture2D dotTex;  // atlas holding the star dot (not owned)
+  Rectangle dotSrc;  // dot sub-rectangle inside dotTex
 
   bool hasPrevPlayerPos;
   Vector2 prevPlayerXZ;
@@ -55,10 +57,11 @@ typedef struct
  * @param particleCount Number of particles to create.
  * @param halfExtentXZ Half-size of the field in X and Z directions (world units).
  * @param seed Random seed for particle distribution.
+ * @param textures Game textures; stars use the dot from the particle atlas.
  * @return Initialized ParallaxField structure.
  */
 ParallaxField parallaxInit(int particleCount, Vector2 halfExtentXZ,
-                           unsigned int seed);
+                           unsigned int seed, GameTextures *textures);
 
 /** Advances the parallax field state for the current frame.
  *
@@ -71,9 +74,14 @@ void parallaxUpdate(ParallaxField *f, const Camera3D *cam,
 /** Renders the parallax field as a background effect.
  *
  * @param f Pointer to the ParallaxField to render.
+ * Stars are alpha-blended and go into the transparent pass, sorted together
+ * with explosion smoke.
+ *
  * @param cam Pointer to the active Camera3D for view/projection.
+ * @param alpha Transparent pass queue receiving the stars.
  */
-void parallaxRender(const ParallaxField *f, const Camera3D *cam);
+void parallaxRender(const ParallaxField *f, const Camera3D *cam,
+                    AlphaParticleQueue *alpha);
 
 /** Releases all memory used by the parallax field.
  *
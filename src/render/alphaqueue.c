@@ -0,0 +1,259 @@
+/**
+ * @file alphaqueue.c
+ * @brief Implements the depth-sorted transparent particle pass.
+ */
+#include "alphaqueue.h"
+#include "billboard.h"
+#include "fillrate.h"
+#include "../utils/arena.h"
+#include "raylib.h"
+#include "raymath.h"
+#include <stdlib.h>
+#include <string.h>
+
+/// Bits sorted per radix pass.
+#define ALPHA_QUEUE_DIGIT_BITS 8
+
+/// Buckets per radix pass.
+#define ALPHA_QUEUE_BUCKETS (1 << ALPHA_QUEUE_DIGIT_BITS)
+
+/// Largest quantized depth.
+#define ALPHA_QUEUE_KEY_MAX ((1u << ALPHA_QUEUE_KEY_BITS) - 1u)
+
+/**
+ * @brief Creates an empty queue.
+ *
+ * @param capacity Initial number of particles; the queue grows as needed.
+ * @return Pointer to the queue, or NULL on allocation failure.
+ */
+AlphaParticleQueue *newAlphaParticleQueue(size_t capacity)
+{
+  AlphaParticleQueue *queue = calloc(1, sizeof(AlphaParticleQueue));
+  if (!queue)
+  {
+    return NULL;
+  }
+  if (capacity == 0)
+  {
+    capacity = 1;
+  }
+  queue->items = malloc(capacity * sizeof(AlphaParticle));
+  if (!queue->items)
+  {
+    destroyAlphaParticleQueue(queue);
+    return NULL;
+  }
+  queue->capacity = capacity;
+  return queue;
+}
+
+/**
+ * @brief Frees the queue and its buffers.
+ *
+ * @param queue Pointer to the queue. Safe to pass NULL.
+ */
+void destroyAlphaParticleQueue(AlphaParticleQueue *queue)
+{
+  if (!queue)
+  {
+    return;
+  }
+  free(queue->items);
+  free(queue);
+}
+
+/**
+ * @brief Doubles the particle buffer of the queue.
+ *
+ * @param queue Pointer to the queue.
+ * @return False when memory ran out; the queue is left unchanged.
+ */
+static bool growAlphaQueue(AlphaParticleQueue *queue)
+{
+  size_t capacity = queue->capacity * 2;
+  AlphaParticle *items = realloc(queue->items, capacity * sizeof(AlphaParticle));
+  if (!items)
+  {
+    return false;
+  }
+  queue->items = items;
+  queue->capacity = capacity;
+  return true;
+}
+
+/**
+ * @brief Clears the queue and captures the camera used for sorting.
+ *
+ * @param queue Pointer to the queue.
+ * @param camera Camera of the frame.
+ */
+void alphaQueueBegin(AlphaParticleQueue *queue, const Camera3D *camera)
+{
+  if (!queue || !camera)
+  {
+    return;
+  }
+  queue->count = 0;
+  queue->eye = camera->position;
+  queue->forward =
+      Vector3Normalize(Vector3Subtract(camera->target, camera->position));
+}
+
+/**
+ * @brief Queues one alpha-blended billboard.
+ *
+ * When the queue cannot grow the particle is dropped.
+ *
+ * @param queue Pointer to the queue.
+ * @param texture_id GL texture sampled by the quad.
+ * @param position Center in world space.
+ * @param size Width and height in world units.
+ * @param rotation Rotation around the view axis, degrees.
+ * @param uv Normalized texture rectangle.
+ * @param tint Vertex color.
+ */
+void alphaQueuePush(AlphaParticleQueue *queue, unsigned int texture_id,
+                    Vector3 position, Vector2 size, float rotation,
+                    Rectangle uv, Color tint)
+{
+  if (!queue)
+  {
+    return;
+  }
+  if (queue->count == queue->capacity && !growAlphaQueue(queue))
+  {
+    return;
+  }
+  queue->items[queue->count++] =
+      (AlphaParticle){position, size, rotation, uv, tint, texture_id};
+}
+
+/**
+ * @brief Quantizes a view depth into an inverted sort key.
+ *
+ * Far particles get small keys so that an ascending sort draws them first.
+ *
+ * @param depth Distance along the view direction.
+ * @return Key in [0, ALPHA_QUEUE_KEY_MAX].
+ */
+static inline uint32_t depthKey(float depth)
+{
+  float t = Clamp(depth / ALPHA_QUEUE_MAX_DEPTH, 0.0f, 1.0f);
+  uint32_t quantized = (uint32_t)(t * (float)ALPHA_QUEUE_KEY_MAX + 0.5f);
+  return ALPHA_QUEUE_KEY_MAX - quantized;
+}
+
+/**
+ * @brief Stable ascending sort of 64-bit values by the ALPHA_QUEUE_KEY_BITS
+ * key stored from bit 32 up; the low 32 bits are carried along.
+ *
+ * @param values Values to sort; holds the result on return.
+ * @param scratch Buffer of the same length.
+ * @param count Number of values.
+ */
+void alphaQueueRadixSort(uint64_t *values, uint64_t *scratch, size_t count)
+{
+  uint64_t *src = values;
+  uint64_t *dst = scratch;
+  for (int shift = 32; shift < 32 + ALPHA_QUEUE_KEY_BITS;
+       shift += ALPHA_QUEUE_DIGIT_BITS)
+  {
+    size_t offsets[ALPHA_QUEUE_BUCKETS] = {0};
+    for (size_t i = 0; i < count; i++)
+    {
+      offsets[(src[i] >> shift) & (ALPHA_QUEUE_BUCKETS - 1)]++;
+    }
+    size_t sum = 0;
+    for (int b = 0; b < ALPHA_QUEUE_BUCKETS; b++)
+    {
+      size_t n = offsets[b];
+      offsets[b] = sum;
+      sum += n;
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+      dst[offsets[(src[i] >> shift) & (ALPHA_QUEUE_BUCKETS - 1)]++] = src[i];
+    }
+    uint64_t *swap = src;
+    src = dst;
+    dst = swap;
+  }
+  if (src != values)
+  {
+    memcpy(values, src, count * sizeof(uint64_t));
+  }
+}
+
+/**
+ * @brief Sorts queued particles back-to-front by view depth.
+ *
+ * Depth along the view direction is quantized to ALPHA_QUEUE_KEY_BITS and
+ * inverted, so an ascending, stable LSD radix sort yields far-to-near order
+ * with ties kept in submission order. The key buffers come from the frame
+ * arena and stay valid until the next frame.
+ *
+ * @param queue Pointer to the queue.
+ * @return False when the frame arena is exhausted and nothing was sorted.
+ */
+bool alphaQueueSort(AlphaParticleQueue *queue)
+{
+  if (!queue)
+  {
+    return false;
+  }
+  queue->sort = frameAlloc(queue->count * sizeof(uint64_t));
+  queue->scratch = frameAlloc(queue->count * sizeof(uint64_t));
+  if (!queue->sort || !queue->scratch)
+  {
+    queue->sort = NULL;
+    queue->scratch = NULL;
+    return false;
+  }
+  for (size_t i = 0; i < queue->count; i++)
+  {
+    float depth = Vector3DotProduct(
+        Vector3Subtract(queue->items[i].position, queue->eye), queue->forward);
+    queue->sort[i] = ((uint64_t)depthKey(depth) << 32) | (uint64_t)i;
+  }
+  alphaQueueRadixSort(queue->sort, queue->scratch, queue->count);
+  return true;
+}
+
+/**
+ * @brief Sorts and draws every queued particle with alpha blending.
+ *
+ * Consecutive particles sharing a texture go into one quad batch; with the
+ * shared particle atlas the whole pass is a single batch.
+ *
+ * @param queue Pointer to the queue.
+ * @param camera Camera of the frame.
+ */
+void alphaQueueFlush(AlphaParticleQueue *queue, const Camera3D *camera)
+{
+  if (!queue || !camera || queue->count == 0)
+  {
+    return;
+  }
+  // Without arena memory the particles still draw, in submission order
+  bool sorted = alphaQueueSort(queue);
+  BillboardBasis basis = billboardBasis(camera);
+  fillRateBlendBegin(BLEND_ALPHA);
+  unsigned int bound =
+      queue->items[sorted ? queue->sort[0] & 0xffffffffu : 0].texture_id;
+  billboardBegin(bound);
+  for (size_t i = 0; i < queue->count; i++)
+  {
+    size_t index = sorted ? (size_t)(queue->sort[i] & 0xffffffffu) : i;
+    const AlphaParticle *p = &queue->items[index];
+    if (p->texture_id != bound)
+    {
+      billboardEnd();
+      bound = p->texture_id;
+      billboardBegin(bound);
+    }
+    billboardQuad(&basis, p->position, p->size, p->rotation, p->uv, p->tint);
+  }
+  billboardEnd();
+  fillRateBlendEnd();
+  queue->count = 0;
+}
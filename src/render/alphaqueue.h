@@ -0,0 +1,122 @@
+/**
+ * @file alphaqueue.h
+ * @brief Declares the transparent particle pass: alpha-blended billboards
+ * from every emitter are collected during the frame, sorted back-to-front by
+ * view depth with an LSD radix sort and drawn as one batch.
+ */
+#ifndef ALPHAQUEUE_H
+#define ALPHAQUEUE_H
+
+#include "raylib.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/// View depth mapped onto the full range of the quantized sort key.
+#define ALPHA_QUEUE_MAX_DEPTH 1024.0f
+
+/// Bits of the quantized depth key (sorted in 8-bit digits).
+#define ALPHA_QUEUE_KEY_BITS 16
+
+/**
+ * @brief One queued alpha-blended billboard.
+ */
+typedef struct AlphaParticle
+{
+  Vector3 position;        /// Center in world space.
+  Vector2 size;            /// Width and height in world units.
+  float rotation;          /// Rotation around the view axis, degrees.
+  Rectangle uv;            /// Normalized texture rectangle.
+  Color tint;              /// Vertex color.
+  unsigned int texture_id; /// GL texture sampled by the quad.
+} AlphaParticle;
+
+/**
+ * @brief Particles of the current frame and the sort buffers.
+ */
+typedef struct AlphaParticleQueue
+{
+  AlphaParticle *items; /// Particles in submission order.
+  uint64_t *sort;       /// Depth key << 32 | item index (frame arena).
+  uint64_t *scratch;    /// Radix sort ping-pong buffer (frame arena).
+  size_t count;         /// Queued particles.
+  size_t capacity;      /// Allocated entries in items.
+  Vector3 eye;          /// Camera position of the frame.
+  Vector3 forward;      /// Unit view direction of the frame.
+} AlphaParticleQueue;
+
+/**
+ * @brief Creates an empty queue.
+ *
+ * @param capacity Initial number of particles; the queue grows as needed.
+ * @return Pointer to the queue, or NULL on allocation failure.
+ */
+AlphaParticleQueue *newAlphaParticleQueue(size_t capacity);
+
+/**
+ * @brief Frees the queue and its buffers.
+ *
+ * @param queue Pointer to the queue. Safe to pass NULL.
+ */
+void destroyAlphaParticleQueue(AlphaParticleQueue *queue);
+
+/**
+ * @brief Clears the queue and captures the camera used for sorting.
+ *
+ * @param queue Pointer to the queue.
+ * @param camera Camera of the frame.
+ */
+void alphaQueueBegin(AlphaParticleQueue *queue, const Camera3D *camera);
+
+/**
+ * @brief Queues one alpha-blended billboard.
+ *
+ * When the queue cannot grow the particle is dropped.
+ *
+ * @param queue Pointer to the queue.
+ * @param texture_id GL texture sampled by the quad.
+ * @param position Center in world space.
+ * @param size Width and height in world units.
+ * @param rotation Rotation around the view axis, degrees.
+ * @param uv Normalized texture rectangle.
+ * @param tint Vertex color.
+ */
+void alphaQueuePush(AlphaParticleQueue *queue, unsigned int texture_id,
+                    Vector3 position, Vector2 size, float rotation,
+                    Rectangle uv, Color tint);
+
+/**
+ * @brief Sorts queued particles back-to-front by view depth.
+ *
+ * Depth along the view direction is quantized to ALPHA_QUEUE_KEY_BITS and
+ * inverted, so an ascending, stable LSD radix sort yields far-to-near order
+ * with ties kept in submission order. The key buffers come from the frame
+ * arena and stay valid until the next frame.
+ *
+ * @param queue Pointer to the queue.
+ * @return False when the frame arena is exhausted and nothing was sorted.
+ */
+bool alphaQueueSort(AlphaParticleQueue *queue);
+
+/**
+ * @brief Sorts and draws every queued particle with alpha blending.
+ *
+ * Consecutive particles sharing a texture go into one quad batch; with the
+ * shared particle atlas the whole pass is a single batch.
+ *
+ * @param queue Pointer to the queue.
+ * @param camera Camera of the frame.
+ */
+void alphaQueueFlush(AlphaParticleQueue *queue, const Camera3D *camera);
+
+/**
+ * @brief Stable ascending sort of 64-bit values by the ALPHA_QUEUE_KEY_BITS
+ * key stored from bit 32 up; the low 32 bits are carried along.
+ *
+ * @param values Values to sort; holds the result on return.
+ * @param scratch Buffer of the same length.
+ * @param count Number of values.
+ */
+void alphaQueueRadixSort(uint64_t *values, uint64_t *scratch, size_t count);
+
+#endif
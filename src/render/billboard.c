@@ -0,0 +1,145 @@
+/**
+ * @file billboard.c
+ * @brief Implements batched camera-facing quads on the stream ring, with the
+ * rlgl batch as fallback.
+ */
+#include "billboard.h"
+#include "fillrate.h"
+#include "raylib.h"
+#include "rlgl.h"
+#include "stream.h"
+#include <math.h>
+#include <raymath.h>
+
+/**
+ * @brief Quad batch opened by billboardBegin.
+ */
+typedef struct BillboardPass
+{
+  unsigned int texture; /// Texture of the batch.
+  bool streamed;        /// Quads go to the stream ring, else to rlgl.
+} BillboardPass;
+
+static BillboardPass pass = {0};
+
+/**
+ * @brief Computes the billboard basis for the given camera.
+ *
+ * Matches DrawBillboardPro: the right vector comes from the view matrix and
+ * the up vector is world Y.
+ *
+ * @param camera Active camera.
+ * @return Basis to pass to billboardQuad.
+ */
+BillboardBasis billboardBasis(const Camera3D *camera)
+{
+  Matrix view = MatrixLookAt(camera->position, camera->target, camera->up);
+  BillboardBasis basis;
+  basis.right = Vector3Normalize((Vector3){view.m0, view.m4, view.m8});
+  basis.up = (Vector3){0.0f, 1.0f, 0.0f};
+  return basis;
+}
+
+/**
+ * @brief Starts a quad batch sampling the given texture.
+ *
+ * @param texture_id GL id of the texture (0 = default white texture).
+ */
+void billboardBegin(unsigned int texture_id)
+{
+  fillRateNoteTexture(texture_id);
+  pass.texture = texture_id;
+  pass.streamed = streamBegin(STREAM_QUADS, texture_id);
+  if (!pass.streamed)
+  {
+    rlSetTexture(texture_id);
+    rlBegin(RL_QUADS);
+  }
+}
+
+/**
+ * @brief Ends a quad batch started with billboardBegin.
+ */
+void billboardEnd(void)
+{
+  if (pass.streamed)
+  {
+    streamEnd();
+    pass.streamed = false;
+    return;
+  }
+  rlEnd();
+  rlSetTexture(0);
+}
+
+/**
+ * @brief Emits one centered, optionally rotated billboard quad.
+ *
+ * @param basis Basis from billboardBasis.
+ * @param position Center of the quad in world space.
+ * @param size Width and height in world units.
+ * @param rotation Rotation around the view axis, in degrees.
+ * @param uv Normalized texture rectangle.
+ * @param tint Vertex color.
+ */
+void billboardQuad(const BillboardBasis *basis, Vector3 position, Vector2 size,
+                   float rotation, Rectangle uv, Color tint)
+{
+  Vector3 r = basis->right;
+  Vector3 u = basis->up;
+  if (rotation != 0.0f)
+  {
+    float c = cosf(rotation * DEG2RAD);
+    float s = sinf(rotation * DEG2RAD);
+    Vector3 rr = Vector3Add(Vector3Scale(r, c), Vector3Scale(u, s));
+    Vector3 ur = Vector3Subtract(Vector3Scale(u, c), Vector3Scale(r, s));
+    r = rr;
+    u = ur;
+  }
+  r = Vector3Scale(r, size.x * 0.5f);
+  u = Vector3Scale(u, size.y * 0.5f);
+
+  if (pass.streamed)
+  {
+    StreamVertex *v = streamReserve(4);
+    if (v)
+    {
+      // Whole vertices in order: the ring is write-combined memory
+      v[0] = (StreamVertex){position.x - r.x - u.x, position.y - r.y - u.y,
+                            position.z - r.z - u.z, uv.x, uv.y + uv.height,
+                            tint.r, tint.g, tint.b, tint.a};
+      v[1] = (StreamVertex){position.x + r.x - u.x, position.y + r.y - u.y,
+                            position.z + r.z - u.z, uv.x + uv.width,
+                            uv.y + uv.height, tint.r, tint.g, tint.b, tint.a};
+      v[2] = (StreamVertex){position.x + r.x + u.x, position.y + r.y + u.y,
+                            position.z + r.z + u.z, uv.x + uv.width, uv.y,
+                            tint.r, tint.g, tint.b, tint.a};
+      v[3] = (StreamVertex){position.x - r.x + u.x, position.y - r.y + u.y,
+                            position.z - r.z + u.z, uv.x, uv.y, tint.r,
+                            tint.g, tint.b, tint.a};
+      return;
+    }
+    // Ring full: draw what it holds, the rest of the batch goes to rlgl
+    streamEnd();
+    pass.streamed = false;
+    rlSetTexture(pass.texture);
+    rlBegin(RL_QUADS);
+  }
+
+  // Flushes (and restores mode/texture) when the batch buffer is full
+  rlCheckRenderBatchLimit(4);
+
+  rlColor4ub(tint.r, tint.g, tint.b, tint.a);
+  rlTexCoord2f(uv.x, uv.y + uv.height);
+  rlVertex3f(position.x - r.x - u.x, position.y - r.y - u.y,
+             position.z - r.z - u.z);
+  rlTexCoord2f(uv.x + uv.width, uv.y + uv.height);
+  rlVertex3f(position.x + r.x - u.x, position.y + r.y - u.y,
+             position.z + r.z - u.z);
+  rlTexCoord2f(uv.x + uv.width, uv.y);
+  rlVertex3f(position.x + r.x + u.x, position.y + r.y + u.y,
+             position.z + r.z + u.z);
+  rlTexCoord2f(uv.x, uv.y);
+  rlVertex3f(position.x - r.x + u.x, position.y - r.y + u.y,
+             position.z - r.z + u.z);
+}
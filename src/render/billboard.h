@@ -0,0 +1,60 @@
+/**
+ * @file billboard.h
+ * @brief Camera-facing quad helpers for batched particle and sprite passes.
+ *
+ * raylib's DrawBillboardPro rebuilds the view matrix for every quad. These
+ * helpers compute the camera basis once per pass and write quads straight
+ * into the stream ring (see stream.h), so callers can draw thousands of
+ * billboards that share one texture with a single draw call. When the ring
+ * is off or full the quads go to the active rlgl batch instead.
+ */
+#ifndef BILLBOARD_H
+#define BILLBOARD_H
+
+#include "raylib.h"
+
+/**
+ * @brief Orientation shared by all billboards of one pass.
+ */
+typedef struct
+{
+  Vector3 right; /// Camera right vector (unit length).
+  Vector3 up;    /// Billboard up vector (world Y, as raylib billboards use).
+} BillboardBasis;
+
+/**
+ * @brief Computes the billboard basis for the given camera.
+ *
+ * @param camera Active camera.
+ * @return Basis to pass to billboardQuad.
+ */
+BillboardBasis billboardBasis(const Camera3D *camera);
+
+/**
+ * @brief Starts a quad batch sampling the given texture.
+ *
+ * @param texture_id GL id of the texture (0 = default white texture).
+ */
+void billboardBegin(unsigned int texture_id);
+
+/**
+ * @brief Ends a quad batch started with billboardBegin.
+ */
+void billboardEnd(void);
+
+/**
+ * @brief Emits one centered, optionally rotated billboard quad.
+ *
+ * Must be called between billboardBegin and billboardEnd.
+ *
+ * @param basis Basis from billboardBasis.
+ * @param position Center of the quad in world space.
+ * @param size Width and height in world units.
+ * @param rotation Rotation around the view axis, in degrees.
+ * @param uv Normalized texture rectangle.
+ * @param tint Vertex color.
+ */
+void billboardQuad(const BillboardBasis *basis, Vector3 position, Vector2 size,
+                   float rotation, Rectangle uv, Color tint);
+
+#endif
@@ -0,0 +1,361 @@
+/**
+ * @file bloom.c
+ * @brief Implements the bloom post-process (threshold, blurred mip chain,
+ * composite).
+ */
+#include "bloom.h"
+#include "../utils/path.h"
+#include "gl.h"
+#include "raylib.h"
+#include "rlgl.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @def SHADERS
+ * @brief Path to the directory containing post-process shaders.
+ */
+#define SHADERS "assets/shaders"
+
+// Global flag: bloom starts enabled unless --no-bloom is given.
+bool is_bloom_enabled = true;
+
+/**
+ * @brief Parses command-line arguments to check for the --no-bloom flag.
+ *
+ * @param argc The count of command-line arguments.
+ * @param argv The array of command-line argument strings.
+ */
+void checkBloomFlag(int argc, char *argv[])
+{
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--no-bloom") == 0)
+    {
+      is_bloom_enabled = false;
+      break;
+    }
+  }
+}
+
+/**
+ * @brief Creates a texture for a render target attachment.
+ */
+static GLuint loadTargetTexture(int width, int height, GLint format,
+                                GLenum layout, GLenum type, GLint filter)
+{
+  GLuint texture = 0;
+  glGenTextures(1, &texture);
+  glBindTexture(GL_TEXTURE_2D, texture);
+  glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, layout, type,
+               NULL);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  glBindTexture(GL_TEXTURE_2D, 0);
+  return texture;
+}
+
+/**
+ * @brief Frees the depth attachment of a target, a texture or a
+ * renderbuffer.
+ */
+static void unloadTargetDepth(GLuint fbo, GLuint depth)
+{
+  GLint kind = GL_NONE;
+  glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+  glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,
+                                        GL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE,
+                                        &kind);
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  if (kind == GL_TEXTURE)
+    glDeleteTextures(1, &depth);
+  else
+    glDeleteRenderbuffers(1, &depth);
+}
+
+/**
+ * @brief Creates a half-float render target.
+ *
+ * raylib's LoadRenderTexture only creates 8-bit targets, so the framebuffer
+ * is built with GL directly and wrapped in a RenderTexture2D, which is all
+ * BeginTextureMode and DrawTexturePro need.
+ *
+ * @param width Target width.
+ * @param height Target height.
+ * @param depth Depth attachment (for the 3D scene).
+ * @param filter TEXTURE_FILTER_POINT or TEXTURE_FILTER_BILINEAR for the
+ * colour and depth textures.
+ * @return The target, with id 0 on failure.
+ */
+RenderTexture2D loadHdrTarget(int width, int height, HdrDepth depth,
+                              int filter)
+{
+  RenderTexture2D target = {0};
+  GLint gl_filter = filter == TEXTURE_FILTER_POINT ? GL_NEAREST : GL_LINEAR;
+  GLuint fbo = 0, depth_id = 0;
+  GLuint color = loadTargetTexture(width, height, GL_RGBA16F, GL_RGBA,
+                                   GL_HALF_FLOAT, gl_filter);
+
+  glGenFramebuffers(1, &fbo);
+  glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+  glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                         color, 0);
+  if (depth == HDR_DEPTH_BUFFER)
+  {
+    glGenRenderbuffers(1, &depth_id);
+    glBindRenderbuffer(GL_RENDERBUFFER, depth_id);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,
+                              GL_RENDERBUFFER, depth_id);
+  }
+  else if (depth == HDR_DEPTH_TEXTURE)
+  {
+    depth_id = loadTargetTexture(width, height, GL_DEPTH_COMPONENT24,
+                                 GL_DEPTH_COMPONENT, GL_UNSIGNED_INT,
+                                 gl_filter);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D,
+                           depth_id, 0);
+  }
+  GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+  if (status != GL_FRAMEBUFFER_COMPLETE)
+  {
+    TraceLog(LOG_WARNING, "[Render] %dx%d half-float target incomplete (0x%x)",
+             width, height, status);
+    if (depth_id)
+      unloadTargetDepth(fbo, depth_id);
+    glDeleteFramebuffers(1, &fbo);
+    glDeleteTextures(1, &color);
+    return target;
+  }
+
+  target.id = fbo;
+  target.texture = (Texture2D){color, width, height, 1,
+                               PIXELFORMAT_UNCOMPRESSED_R16G16B16A16};
+  target.depth = (Texture2D){depth_id, width, height, 1, 0};
+  return target;
+}
+
+/**
+ * @brief Frees a target created by loadHdrTarget.
+ *
+ * @param target Target to free; an id of 0 is ignored.
+ */
+void unloadHdrTarget(RenderTexture2D target)
+{
+  if (target.id == 0)
+    return;
+  GLuint fbo = target.id;
+  GLuint color = target.texture.id;
+  if (target.depth.id)
+    unloadTargetDepth(fbo, target.depth.id);
+  glDeleteFramebuffers(1, &fbo);
+  glDeleteTextures(1, &color);
+}
+
+/**
+ * @brief Loads a post-process fragment shader from the shaders directory,
+ * with raylib's default vertex shader.
+ *
+ * @param name File name of the fragment shader.
+ * @return The shader, with id 0 when it failed to compile.
+ */
+Shader loadPostShader(const char *name)
+{
+  char *fs_file = path_join(SHADERS, name);
+  Shader shader = LoadShader(NULL, fs_file);
+  free(fs_file);
+  // raylib falls back to its default shader when compilation fails.
+  if (shader.id == rlGetShaderIdDefault())
+  {
+    return (Shader){0};
+  }
+  return shader;
+}
+
+/**
+ * @brief Draws a whole texture over a whole target.
+ *
+ * Render textures are stored bottom-up, so the source is flipped to keep
+ * every level in the same orientation as the scene.
+ */
+static void bloomBlit(Texture2D source, RenderTexture2D dest)
+{
+  BeginTextureMode(dest);
+  DrawTexturePro(
+      source,
+      (Rectangle){0.0f, 0.0f, (float)source.width, -(float)source.height},
+      (Rectangle){0.0f, 0.0f, (float)dest.texture.width,
+                  (float)dest.texture.height},
+      (Vector2){0.0f, 0.0f}, 0.0f, WHITE);
+  EndTextureMode();
+}
+
+/**
+ * @brief Creates the bloom targets and loads the shaders.
+ *
+ * @param width Width of the scene in pixels.
+ * @param height Height of the scene in pixels.
+ * @return Pointer to the bloom state, or NULL on failure.
+ */
+Bloom *newBloom(int width, int height)
+{
+  Bloom *bloom = calloc(1, sizeof(Bloom));
+  if (!bloom)
+  {
+    return NULL;
+  }
+  bloom->width = width;
+  bloom->height = height;
+  bloom->threshold_value = 0.8f;
+  bloom->knee_value = 0.4f;
+  bloom->intensity_value = 0.9f;
+
+  bool ok = true;
+  bloom->scene =
+      loadHdrTarget(width, height, HDR_DEPTH_BUFFER, TEXTURE_FILTER_BILINEAR);
+  ok = ok && bloom->scene.id != 0;
+  for (int i = 0; i < BLOOM_MIPS && ok; i++)
+  {
+    int w = width >> (i + 1);
+    int h = height >> (i + 1);
+    w = w > 0 ? w : 1;
+    h = h > 0 ? h : 1;
+    bloom->mip[i] =
+        loadHdrTarget(w, h, HDR_DEPTH_NONE, TEXTURE_FILTER_BILINEAR);
+    bloom->temp[i] =
+        loadHdrTarget(w, h, HDR_DEPTH_NONE, TEXTURE_FILTER_BILINEAR);
+    ok = bloom->mip[i].id != 0 && bloom->temp[i].id != 0;
+  }
+
+  bloom->threshold = loadPostShader("bloom_threshold.fs");
+  bloom->blur = loadPostShader("bloom_blur.fs");
+  bloom->composite = loadPostShader("bloom_composite.fs");
+  ok = ok && bloom->threshold.id != 0 && bloom->blur.id != 0 &&
+       bloom->composite.id != 0;
+  if (!ok)
+  {
+    TraceLog(LOG_WARNING, "[bloom] Failed to create bloom, disabled");
+    destroyBloom(bloom);
+    return NULL;
+  }
+
+  bloom->threshold_loc = GetShaderLocation(bloom->threshold, "threshold");
+  bloom->knee_loc = GetShaderLocation(bloom->threshold, "knee");
+  bloom->direction_loc = GetShaderLocation(bloom->blur, "direction");
+  bloom->bloom_texture_loc =
+      GetShaderLocation(bloom->composite, "bloomTexture");
+  bloom->intensity_loc = GetShaderLocation(bloom->composite, "intensity");
+
+  TraceLog(LOG_INFO, "[bloom] %dx%d scene, %d levels", width, height,
+           BLOOM_MIPS);
+  return bloom;
+}
+
+/**
+ * @brief Redirects drawing into the bloom scene target.
+ *
+ * @param bloom Pointer to the bloom state.
+ */
+void bloomBeginScene(Bloom *bloom)
+{
+  BeginTextureMode(bloom->scene);
+}
+
+/**
+ * @brief Finishes the scene and builds the blurred bloom chain.
+ *
+ * Bright parts of the scene go to the half-size level; each level is
+ * downsampled from the previous one and blurred horizontally then
+ * vertically. The levels are then added back up, smallest first, so the
+ * first level holds the wide and the tight glow together.
+ *
+ * @param bloom Pointer to the bloom state.
+ */
+void bloomEndScene(Bloom *bloom)
+{
+  EndTextureMode();
+
+  SetShaderValue(bloom->threshold, bloom->threshold_loc,
+                 &bloom->threshold_value, SHADER_UNIFORM_FLOAT);
+  SetShaderValue(bloom->threshold, bloom->knee_loc, &bloom->knee_value,
+                 SHADER_UNIFORM_FLOAT);
+  BeginShaderMode(bloom->threshold);
+  bloomBlit(bloom->scene.texture, bloom->mip[0]);
+  EndShaderMode();
+
+  for (int i = 0; i < BLOOM_MIPS; i++)
+  {
+    if (i > 0)
+    {
+      bloomBlit(bloom->mip[i - 1].texture, bloom->mip[i]);
+    }
+    Vector2 horizontal = {1.0f / (float)bloom->mip[i].texture.width, 0.0f};
+    Vector2 vertical = {0.0f, 1.0f / (float)bloom->mip[i].texture.height};
+
+    BeginShaderMode(bloom->blur);
+    SetShaderValue(bloom->blur, bloom->direction_loc, &horizontal,
+                   SHADER_UNIFORM_VEC2);
+    bloomBlit(bloom->mip[i].texture, bloom->temp[i]);
+    SetShaderValue(bloom->blur, bloom->direction_loc, &vertical,
+                   SHADER_UNIFORM_VEC2);
+    bloomBlit(bloom->temp[i].texture, bloom->mip[i]);
+    EndShaderMode();
+  }
+
+  BeginBlendMode(BLEND_ADDITIVE);
+  for (int i = BLOOM_MIPS - 2; i >= 0; i--)
+  {
+    bloomBlit(bloom->mip[i + 1].texture, bloom->mip[i]);
+  }
+  EndBlendMode();
+}
+
+/**
+ * @brief Draws scene + bloom into the current target (screen or texture).
+ *
+ * @param bloom Pointer to the bloom state.
+ */
+void bloomComposite(Bloom *bloom)
+{
+  BeginShaderMode(bloom->composite);
+  SetShaderValueTexture(bloom->composite, bloom->bloom_texture_loc,
+                        bloom->mip[0].texture);
+  SetShaderValue(bloom->composite, bloom->intensity_loc,
+                 &bloom->intensity_value, SHADER_UNIFORM_FLOAT);
+  DrawTexturePro(bloom->scene.texture,
+                 (Rectangle){0.0f, 0.0f, (float)bloom->width,
+                             -(float)bloom->height},
+                 (Rectangle){0.0f, 0.0f, (float)bloom->width,
+                             (float)bloom->height},
+                 (Vector2){0.0f, 0.0f}, 0.0f, WHITE);
+  EndShaderMode();
+}
+
+/**
+ * @brief Frees the bloom targets and shaders.
+ *
+ * @param bloom Pointer to the bloom state to destroy.
+ */
+void destroyBloom(Bloom *bloom)
+{
+  if (!bloom)
+    return;
+  unloadHdrTarget(bloom->scene);
+  for (int i = 0; i < BLOOM_MIPS; i++)
+  {
+    unloadHdrTarget(bloom->mip[i]);
+    unloadHdrTarget(bloom->temp[i]);
+  }
+  if (bloom->threshold.id != 0)
+    UnloadShader(bloom->threshold);
+  if (bloom->blur.id != 0)
+    UnloadShader(bloom->blur);
+  if (bloom->composite.id != 0)
+    UnloadShader(bloom->composite);
+  free(bloom);
+}
@@ -0,0 +1,128 @@
+/**
+ * @file bloom.h
+ * @brief Declares the bloom post-process: the 3D scene is drawn into a
+ * half-float target, bright parts are extracted, blurred over a chain of
+ * downsampled targets and added back on top of the scene.
+ */
+#ifndef BLOOM_H
+#define BLOOM_H
+
+#include "raylib.h"
+#include <stdbool.h>
+
+/// Number of downsampled levels in the blur chain (1/2 .. 1/32 size).
+#define BLOOM_MIPS 5
+
+// Global flag: bloom starts enabled unless --no-bloom is given.
+extern bool is_bloom_enabled;
+
+/**
+ * @brief Parses command-line arguments to check for the --no-bloom flag.
+ *
+ * @param argc The count of command-line arguments.
+ * @param argv The array of command-line argument strings.
+ */
+void checkBloomFlag(int argc, char *argv[]);
+
+/**
+ * @brief Depth attachment of a half-float target.
+ */
+typedef enum HdrDepth
+{
+  HDR_DEPTH_NONE = 0, /// No depth buffer.
+  HDR_DEPTH_BUFFER,   /// Depth renderbuffer, for depth testing only.
+  HDR_DEPTH_TEXTURE,  /// Depth texture later passes can sample.
+} HdrDepth;
+
+/**
+ * @brief Creates a half-float render target (raylib's LoadRenderTexture only
+ * creates 8-bit ones). Also used by the overdraw heat map and the effects
+ * pass.
+ *
+ * @param width Target width.
+ * @param height Target height.
+ * @param depth Depth attachment (for the 3D scene).
+ * @param filter TEXTURE_FILTER_POINT or TEXTURE_FILTER_BILINEAR for the
+ * colour and depth textures.
+ * @return The target, with id 0 on failure.
+ */
+RenderTexture2D loadHdrTarget(int width, int height, HdrDepth depth,
+                              int filter);
+
+/**
+ * @brief Frees a target created by loadHdrTarget.
+ *
+ * @param target Target to free; an id of 0 is ignored.
+ */
+void unloadHdrTarget(RenderTexture2D target);
+
+/**
+ * @brief Loads a post-process fragment shader from the shaders directory,
+ * with raylib's default vertex shader.
+ *
+ * @param name File name of the fragment shader.
+ * @return The shader, with id 0 when it failed to compile.
+ */
+Shader loadPostShader(const char *name);
+
+/**
+ * @brief Bloom targets, shaders and parameters.
+ */
+typedef struct Bloom
+{
+  int width;                      /// Scene width in pixels.
+  int height;                     /// Scene height in pixels.
+  RenderTexture2D scene;          /// Half-float scene target with depth.
+  RenderTexture2D mip[BLOOM_MIPS];  /// Blurred levels (results).
+  RenderTexture2D temp[BLOOM_MIPS]; /// Horizontal-pass scratch per level.
+  Shader threshold;               /// Bright-pass shader.
+  Shader blur;                    /// Separable gaussian shader.
+  Shader composite;               /// Scene + bloom shader.
+  int threshold_loc;              /// "threshold" uniform.
+  int knee_loc;                   /// "knee" uniform.
+  int direction_loc;              /// "direction" uniform.
+  int bloom_texture_loc;          /// "bloomTexture" uniform.
+  int intensity_loc;              /// "intensity" uniform.
+  float threshold_value;          /// Brightness where bloom starts.
+  float knee_value;               /// Softness of the threshold.
+  float intensity_value;          /// Strength of the added bloom.
+} Bloom;
+
+/**
+ * @brief Creates the bloom targets and loads the shaders.
+ *
+ * @param width Width of the scene in pixels.
+ * @param height Height of the scene in pixels.
+ * @return Pointer to the bloom state, or NULL on failure.
+ */
+Bloom *newBloom(int width, int height);
+
+/**
+ * @brief Redirects drawing into the bloom scene target.
+ *
+ * @param bloom Pointer to the bloom state.
+ */
+void bloomBeginScene(Bloom *bloom);
+
+/**
+ * @brief Finishes the scene and builds the blurred bloom chain.
+ *
+ * @param bloom Pointer to the bloom state.
+ */
+void bloomEndScene(Bloom *bloom);
+
+/**
+ * @brief Draws scene + bloom into the current target (screen or texture).
+ *
+ * @param bloom Pointer to the bloom state.
+ */
+void bloomComposite(Bloom *bloom);
+
+/**
+ * @brief Frees the bloom targets and shaders.
+ *
+ * @param bloom Pointer to the bloom state to destroy.
+ */
+void destroyBloom(Bloom *bloom);
+
+#endif
@@ -0,0 +1,511 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "capture.h"
+#include "raylib.h"
+#include <errno.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+
+// Capture target given by --capture; NULL when capture is disabled.
+const char *capture_target = NULL;
+
+// Output format given by --capture-format.
+CaptureFormat capture_format = CAPTURE_FORMAT_RAW;
+
+// True when --render was given (offline, lossless capture).
+bool capture_offline = false;
+
+/// Fence wait per attempt while a blocking capture waits for a readback
+/// (0.1 second); it retries until the fence signals.
+#define CAPTURE_WAIT_STEP_NS 100000000ull
+
+/**
+ * @brief Parses --capture <target>, --render <target> and
+ * --capture-format <raw|png|pipe>.
+ *
+ * @param argc The count of command-line arguments.
+ * @param argv The array of command-line argument strings.
+ */
+void checkCaptureFlags(int argc, char *argv[])
+{
+  for (int i = 1; i < argc - 1; i++)
+  {
+    if (strcmp(argv[i], "--capture") == 0)
+    {
+      capture_target = argv[i + 1];
+    }
+    else if (strcmp(argv[i], "--render") == 0)
+    {
+      capture_target = argv[i + 1];
+      capture_offline = true;
+    }
+    else if (strcmp(argv[i], "--capture-format") == 0)
+    {
+      const char *fmt = argv[i + 1];
+      if (strcmp(fmt, "raw") == 0)
+        capture_format = CAPTURE_FORMAT_RAW;
+      else if (strcmp(fmt, "png") == 0)
+        capture_format = CAPTURE_FORMAT_PNG;
+      else if (strcmp(fmt, "pipe") == 0)
+        capture_format = CAPTURE_FORMAT_PIPE;
+      else
+        TraceLog(LOG_WARNING, "Unknown capture format: %s (using raw)", fmt);
+    }
+  }
+}
+
+/**
+ * @brief Monotonic clock in milliseconds, safe to call from any thread.
+ */
+static double captureNowMs(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1000000.0;
+}
+
+/**
+ * @brief Flips a bottom-up GL frame in place and forces opaque alpha.
+ *
+ * The back buffer alpha is whatever blending left behind; PNG viewers would
+ * show it as transparency, so it is reset to 255.
+ */
+static void captureFlipFrame(FrameCapture *capture, unsigned char *pixels)
+{
+  size_t stride = (size_t)capture->width * 4;
+
+  for (int y = 0; y < capture->height / 2; y++)
+  {
+    unsigned char *top = pixels + (size_t)y * stride;
+    unsigned char *bottom = pixels + (size_t)(capture->height - 1 - y) * stride;
+    memcpy(capture->row, top, stride);
+    memcpy(top, bottom, stride);
+    memcpy(bottom, capture->row, stride);
+  }
+
+  for (size_t i = 3; i < capture->frame_bytes; i += 4)
+  {
+    pixels[i] = 255;
+  }
+}
+
+/**
+ * @brief Writes one frame to the configured output (encoder thread only).
+ */
+static void captureWriteFrame(FrameCapture *capture, CaptureFrame *frame)
+{
+  captureFlipFrame(capture, frame->pixels);
+
+  if (capture->format == CAPTURE_FORMAT_PNG)
+  {
+    // TextFormat uses shared static buffers, so build the name locally.
+    char path[1024];
+    snprintf(path, sizeof(path), "%s/frame_%06llu.png", capture->target,
+             (unsigned long long)frame->index);
+    Image image = {
+        .data = frame->pixels,
+        .width = capture->width,
+        .height = capture->height,
+        .mipmaps = 1,
+        .format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8,
+    };
+    ExportImage(image, path);
+    return;
+  }
+
+  if (capture->out &&
+      fwrite(frame->pixels, 1, capture->frame_bytes, capture->out) !=
+          capture->frame_bytes)
+  {
+    TraceLog(LOG_WARNING, "Capture: write failed (%s), output closed",
+             strerror(errno));
+    if (capture->format == CAPTURE_FORMAT_PIPE)
+      pclose(capture->out);
+    else
+      fclose(capture->out);
+    capture->out = NULL;
+  }
+}
+
+/**
+ * @brief Encoder thread: pops queued frames and writes them until stopped
+ * and the queue is empty.
+ */
+static void *captureEncoderMain(void *arg)
+{
+  FrameCapture *capture = (FrameCapture *)arg;
+
+  for (;;)
+  {
+    pthread_mutex_lock(&capture->lock);
+    while (capture->queue_count == 0 && capture->running)
+    {
+      pthread_cond_wait(&capture->ready, &capture->lock);
+    }
+    if (capture->queue_count == 0)
+    {
+      pthread_mutex_unlock(&capture->lock);
+      break;
+    }
+    // The head slot stays owned by the encoder until queue_count drops, so
+    // the producer (which writes at head + count) never touches it.
+    CaptureFrame *frame = &capture->queue[capture->queue_head];
+    pthread_mutex_unlock(&capture->lock);
+
+    double start = captureNowMs();
+    captureWriteFrame(capture, frame);
+    double elapsed = captureNowMs() - start;
+
+    pthread_mutex_lock(&capture->lock);
+    capture->queue_head = (capture->queue_head + 1) % CAPTURE_QUEUE_LEN;
+    capture->queue_count -= 1;
+    capture->stats.written += 1;
+    capture->stats.encode_ms_total += elapsed;
+    pthread_cond_signal(&capture->space);
+    pthread_mutex_unlock(&capture->lock);
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief Copies mapped PBO contents into the encoder queue, or drops the
+ * frame when the queue is full (non-blocking mode).
+ */
+static void captureEnqueue(FrameCapture *capture, const void *pixels,
+                           uint64_t index)
+{
+  pthread_mutex_lock(&capture->lock);
+  capture->stats.read_back += 1;
+  while (capture->blocking && capture->queue_count == CAPTURE_QUEUE_LEN)
+  {
+    pthread_cond_wait(&capture->space, &capture->lock);
+  }
+  if (capture->queue_count == CAPTURE_QUEUE_LEN)
+  {
+    capture->stats.dropped_queue += 1;
+    pthread_mutex_unlock(&capture->lock);
+    return;
+  }
+  int slot = (capture->queue_head + capture->queue_count) % CAPTURE_QUEUE_LEN;
+  pthread_mutex_unlock(&capture->lock);
+
+  // Only the producer writes free slots, so the copy can run unlocked.
+  memcpy(capture->queue[slot].pixels, pixels, capture->frame_bytes);
+  capture->queue[slot].index = index;
+
+  pthread_mutex_lock(&capture->lock);
+  capture->queue_count += 1;
+  pthread_cond_signal(&capture->ready);
+  pthread_mutex_unlock(&capture->lock);
+}
+
+/**
+ * @brief Collects the readback held by one ring slot.
+ *
+ * @param wait Wait until the readback is done instead of polling; the
+ * frame is then never dropped, however long the GPU takes.
+ * @return true if the slot was collected (or dropped) and is free again.
+ */
+static bool captureCollect(FrameCapture *capture, int slot, bool wait)
+{
+  if (!capture->pbo_pending[slot])
+    return true;
+
+  GLenum status = glClientWaitSync(capture->fence[slot],
+                                   GL_SYNC_FLUSH_COMMANDS_BIT,
+                                   wait ? CAPTURE_WAIT_STEP_NS : 0);
+  while (wait && status == GL_TIMEOUT_EXPIRED)
+  {
+    status = glClientWaitSync(capture->fence[slot], GL_SYNC_FLUSH_COMMANDS_BIT,
+                              CAPTURE_WAIT_STEP_NS);
+  }
+  // A failed wait leaves the map to synchronise with the readback.
+  bool ready = wait || status == GL_ALREADY_SIGNALED ||
+               status == GL_CONDITION_SATISFIED;
+
+  if (ready)
+  {
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, capture->pbo[slot]);
+    const void *pixels = glMapBufferRange(
+        GL_PIXEL_PACK_BUFFER, 0, (GLsizeiptr)capture->frame_bytes,
+        GL_MAP_READ_BIT);
+    if (pixels)
+    {
+      captureEnqueue(capture, pixels, capture->pbo_frame[slot]);
+      glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  }
+  else
+  {
+    // The GPU is a whole ring behind; dropping keeps the frame time flat.
+    pthread_mutex_lock(&capture->lock);
+    capture->stats.dropped_readback += 1;
+    pthread_mutex_unlock(&capture->lock);
+  }
+
+  glDeleteSync(capture->fence[slot]);
+  capture->fence[slot] = NULL;
+  capture->pbo_pending[slot] = false;
+  return true;
+}
+
+/**
+ * @brief Opens the raw file, PNG directory or encoder pipe.
+ */
+static bool captureOpenOutput(FrameCapture *capture)
+{
+  switch (capture->format)
+  {
+  case CAPTURE_FORMAT_PNG:
+    if (mkdir(capture->target, 0755) != 0 && errno != EEXIST)
+    {
+      TraceLog(LOG_WARNING, "Capture: cannot create directory %s",
+               capture->target);
+      return false;
+    }
+    return true;
+  case CAPTURE_FORMAT_PIPE:
+    // An encoder that exits would otherwise kill the game with SIGPIPE on
+    // the next write; ignored, the write fails with EPIPE instead.
+    signal(SIGPIPE, SIG_IGN);
+    capture->out = popen(capture->target, "w");
+    break;
+  case CAPTURE_FORMAT_RAW:
+  default:
+    capture->out = fopen(capture->target, "wb");
+    break;
+  }
+
+  if (!capture->out)
+  {
+    TraceLog(LOG_WARNING, "Capture: cannot open %s", capture->target);
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Frees buffers and closes the output (no GL or thread state).
+ */
+static void captureFreeBuffers(FrameCapture *capture)
+{
+  for (int i = 0; i < CAPTURE_QUEUE_LEN; i++)
+  {
+    free(capture->queue[i].pixels);
+  }
+  free(capture->row);
+  if (capture->out)
+  {
+    if (capture->format == CAPTURE_FORMAT_PIPE)
+      pclose(capture->out);
+    else
+      fclose(capture->out);
+  }
+  free(capture);
+}
+
+/**
+ * @brief Creates the readback ring and starts the encoder thread.
+ *
+ * @param width Width of the framebuffer to capture.
+ * @param height Height of the framebuffer to capture.
+ * @param format Output format.
+ * @param target Raw file path, PNG directory or encoder command.
+ * @param blocking Wait for readbacks and queue space instead of dropping.
+ * @return Pointer to the capture, or NULL on failure.
+ */
+FrameCapture *newFrameCapture(int width, int height, CaptureFormat format,
+                              const char *target, bool blocking)
+{
+  if (!target || width <= 0 || height <= 0)
+    return NULL;
+
+  FrameCapture *capture = calloc(1, sizeof(FrameCapture));
+  if (!capture)
+  {
+    TraceLog(LOG_WARNING, "Capture: failed to allocate state");
+    return NULL;
+  }
+
+  capture->width = width;
+  capture->height = height;
+  capture->frame_bytes = (size_t)width * (size_t)height * 4;
+  capture->format = format;
+  capture->target = target;
+  capture->blocking = blocking;
+  capture->running = true;
+
+  capture->row = malloc((size_t)width * 4);
+  bool allocated = capture->row != NULL;
+  for (int i = 0; i < CAPTURE_QUEUE_LEN && allocated; i++)
+  {
+    capture->queue[i].pixels = malloc(capture->frame_bytes);
+    allocated = capture->queue[i].pixels != NULL;
+  }
+  if (!allocated)
+  {
+    TraceLog(LOG_WARNING, "Capture: failed to allocate frame buffers");
+    captureFreeBuffers(capture);
+    return NULL;
+  }
+
+  if (!captureOpenOutput(capture))
+  {
+    captureFreeBuffers(capture);
+    return NULL;
+  }
+
+  pthread_mutex_init(&capture->lock, NULL);
+  pthread_cond_init(&capture->ready, NULL);
+  pthread_cond_init(&capture->space, NULL);
+  if (pthread_create(&capture->thread, NULL, captureEncoderMain, capture) != 0)
+  {
+    TraceLog(LOG_WARNING, "Capture: failed to start encoder thread");
+    pthread_cond_destroy(&capture->space);
+    pthread_cond_destroy(&capture->ready);
+    pthread_mutex_destroy(&capture->lock);
+    captureFreeBuffers(capture);
+    return NULL;
+  }
+
+  glGenBuffers(CAPTURE_PBO_RING, capture->pbo);
+  for (int i = 0; i < CAPTURE_PBO_RING; i++)
+  {
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, capture->pbo[i]);
+    glBufferData(GL_PIXEL_PACK_BUFFER, (GLsizeiptr)capture->frame_bytes, NULL,
+                 GL_STREAM_READ);
+  }
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+  TraceLog(LOG_INFO, "Capture: %dx%d -> %s (%s%s)", width, height, target,
+           format == CAPTURE_FORMAT_PNG    ? "png"
+           : format == CAPTURE_FORMAT_PIPE ? "pipe"
+                                           : "raw",
+           blocking ? ", lossless" : "");
+  return capture;
+}
+
+/**
+ * @brief Queues readback of the currently bound read framebuffer.
+ *
+ * @param capture Pointer to the capture.
+ */
+void captureFrame(FrameCapture *capture)
+{
+  if (!capture)
+    return;
+
+  double start = captureNowMs();
+  int slot = (int)(capture->frame_counter % CAPTURE_PBO_RING);
+
+  // The slot still holds the readback from CAPTURE_PBO_RING frames ago.
+  captureCollect(capture, slot, capture->blocking);
+
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, capture->pbo[slot]);
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+  glReadPixels(0, 0, capture->width, capture->height, GL_RGBA,
+               GL_UNSIGNED_BYTE, NULL);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  capture->fence[slot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  capture->pbo_frame[slot] = capture->frame_counter;
+  capture->pbo_pending[slot] = true;
+  capture->frame_counter += 1;
+
+  double elapsed = captureNowMs() - start;
+  pthread_mutex_lock(&capture->lock);
+  capture->stats.requested += 1;
+  capture->stats.cpu_ms_last = elapsed;
+  capture->stats.cpu_ms_total += elapsed;
+  if (elapsed > capture->stats.cpu_ms_max)
+    capture->stats.cpu_ms_max = elapsed;
+  pthread_mutex_unlock(&capture->lock);
+}
+
+/**
+ * @brief Returns a consistent snapshot of the capture counters.
+ *
+ * @param capture Pointer to the capture.
+ * @return Copy of the statistics.
+ */
+CaptureStats getCaptureStats(FrameCapture *capture)
+{
+  CaptureStats stats = {0};
+  if (!capture)
+    return stats;
+
+  pthread_mutex_lock(&capture->lock);
+  stats = capture->stats;
+  pthread_mutex_unlock(&capture->lock);
+  return stats;
+}
+
+/**
+ * @brief Draws a one-line capture status (frames, drops, cost) on screen.
+ *
+ * @param capture Pointer to the capture.
+ * @param x Screen X position.
+ * @param y Screen Y position.
+ */
+void captureDrawStats(FrameCapture *capture, int x, int y)
+{
+  if (!capture)
+    return;
+
+  CaptureStats stats = getCaptureStats(capture);
+  DrawText(TextFormat("REC %llu  drop %llu/%llu  %.2f ms",
+                      (unsigned long long)stats.written,
+                      (unsigned long long)stats.dropped_readback,
+                      (unsigned long long)stats.dropped_queue,
+                      stats.cpu_ms_last),
+           x, y, 16, RED);
+}
+
+/**
+ * @brief Collects pending readbacks, drains the encoder and frees resources.
+ *
+ * @param capture Pointer to the capture to destroy.
+ */
+void destroyFrameCapture(FrameCapture *capture)
+{
+  if (!capture)
+    return;
+
+  // Collect outstanding readbacks oldest first so the tail of the recording
+  // is not lost; at shutdown waiting is fine.
+  for (int i = 0; i < CAPTURE_PBO_RING; i++)
+  {
+    int slot = (int)((capture->frame_counter + (uint64_t)i) % CAPTURE_PBO_RING);
+    captureCollect(capture, slot, true);
+  }
+  glDeleteBuffers(CAPTURE_PBO_RING, capture->pbo);
+
+  pthread_mutex_lock(&capture->lock);
+  capture->running = false;
+  pthread_cond_signal(&capture->ready);
+  pthread_mutex_unlock(&capture->lock);
+  pthread_join(capture->thread, NULL);
+
+  CaptureStats stats = capture->stats;
+  double frames = stats.requested > 0 ? (double)stats.requested : 1.0;
+  double written = stats.written > 0 ? (double)stats.written : 1.0;
+  TraceLog(LOG_INFO,
+           "Capture: %llu frames written of %llu, dropped %llu (readback) "
+           "%llu (queue); main thread %.3f ms avg %.3f ms max; encoder %.3f "
+           "ms/frame",
+           (unsigned long long)stats.written,
+           (unsigned long long)stats.requested,
+           (unsigned long long)stats.dropped_readback,
+           (unsigned long long)stats.dropped_queue,
+           stats.cpu_ms_total / frames, stats.cpu_ms_max,
+           stats.encode_ms_total / written);
+
+  pthread_cond_destroy(&capture->space);
+  pthread_cond_destroy(&capture->ready);
+  pthread_mutex_destroy(&capture->lock);
+  captureFreeBuffers(capture);
+}
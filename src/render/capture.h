@@ -0,0 +1,155 @@
+/**
+ * @file capture.h
+ * @brief Declares asynchronous frame capture: pixel-buffer-object readback a
+ * few frames late and a background encoder thread writing frames to disk or
+ * to a local encoder process.
+ */
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+#include "gl.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/// Number of pixel buffer objects in the readback ring (frames of latency).
+#define CAPTURE_PBO_RING 3
+
+/// Number of frames the encoder queue can hold before frames are dropped.
+#define CAPTURE_QUEUE_LEN 8
+
+/**
+ * @brief Output written by the encoder thread.
+ */
+typedef enum CaptureFormat
+{
+  CAPTURE_FORMAT_RAW = 0,  /// All frames appended to one raw RGBA file.
+  CAPTURE_FORMAT_PNG = 1,  /// One PNG per frame inside a directory.
+  CAPTURE_FORMAT_PIPE = 2, /// Raw RGBA frames written to a command's stdin.
+} CaptureFormat;
+
+// Capture target given by --capture (file, directory or command); NULL when
+// capture is disabled.
+extern const char *capture_target;
+
+// Output format given by --capture-format (raw by default).
+extern CaptureFormat capture_format;
+
+// True when --render was given: the replay is rendered off-screen, as fast
+// as possible and without dropping frames.
+extern bool capture_offline;
+
+/**
+ * @brief Parses --capture <target>, --render <target> and
+ * --capture-format <raw|png|pipe>.
+ *
+ * @param argc The count of command-line arguments.
+ * @param argv The array of command-line argument strings.
+ */
+void checkCaptureFlags(int argc, char *argv[]);
+
+/**
+ * @brief Counters describing capture cost and losses.
+ */
+typedef struct CaptureStats
+{
+  uint64_t requested;        /// Frames passed to captureFrame.
+  uint64_t read_back;        /// Frames whose readback completed.
+  uint64_t written;          /// Frames written by the encoder.
+  uint64_t dropped_readback; /// Frames dropped: readback not ready yet.
+  uint64_t dropped_queue;    /// Frames dropped: encoder queue full.
+  double cpu_ms_last;        /// Main-thread cost of the last captureFrame.
+  double cpu_ms_max;         /// Worst main-thread cost of captureFrame.
+  double cpu_ms_total;       /// Total main-thread cost of captureFrame.
+  double encode_ms_total;    /// Total encoder-thread time spent writing.
+} CaptureStats;
+
+/**
+ * @brief A frame waiting in the encoder queue.
+ */
+typedef struct CaptureFrame
+{
+  unsigned char *pixels; /// RGBA pixels, bottom-up rows as read from GL.
+  uint64_t index;        /// Frame number since the capture started.
+} CaptureFrame;
+
+/**
+ * @brief Asynchronous capture state.
+ */
+typedef struct FrameCapture
+{
+  int width;                             /// Captured width in pixels.
+  int height;                            /// Captured height in pixels.
+  size_t frame_bytes;                    /// Size of one RGBA frame.
+  CaptureFormat format;                  /// Output format.
+  const char *target;                    /// File, directory or command.
+  bool blocking;                         /// Wait instead of dropping frames.
+  GLuint pbo[CAPTURE_PBO_RING];          /// Readback ring.
+  GLsync fence[CAPTURE_PBO_RING];        /// Fence per pending readback.
+  uint64_t pbo_frame[CAPTURE_PBO_RING];  /// Frame number held by each PBO.
+  bool pbo_pending[CAPTURE_PBO_RING];    /// Readback issued, not collected.
+  uint64_t frame_counter;                /// Frames requested so far.
+  CaptureFrame queue[CAPTURE_QUEUE_LEN]; /// Frames handed to the encoder.
+  int queue_head;                        /// Oldest queued frame.
+  int queue_count;                       /// Number of queued frames.
+  unsigned char *row;                    /// Encoder scratch row for flips.
+  FILE *out;                             /// Raw file or pipe.
+  pthread_t thread;                      /// Encoder thread.
+  pthread_mutex_t lock;                  /// Guards queue and stats.
+  pthread_cond_t ready;                  /// Signalled when a frame is queued.
+  pthread_cond_t space;                  /// Signalled when a slot frees up.
+  bool running;                          /// Encoder should keep waiting.
+  CaptureStats stats;                    /// Cost and loss accounting.
+} FrameCapture;
+
+/**
+ * @brief Creates the readback ring and starts the encoder thread.
+ *
+ * @param width Width of the framebuffer to capture.
+ * @param height Height of the framebuffer to capture.
+ * @param format Output format.
+ * @param target Raw file path, PNG directory or encoder command.
+ * @param blocking Wait for readbacks and queue space instead of dropping.
+ * @return Pointer to the capture, or NULL on failure.
+ */
+FrameCapture *newFrameCapture(int width, int height, CaptureFormat format,
+                              const char *target, bool blocking);
+
+/**
+ * @brief Queues readback of the currently bound read framebuffer.
+ *
+ * Call after the frame is fully drawn (batch flushed) and before swapping.
+ * Readbacks issued CAPTURE_PBO_RING frames earlier are collected here and
+ * handed to the encoder thread.
+ *
+ * @param capture Pointer to the capture.
+ */
+void captureFrame(FrameCapture *capture);
+
+/**
+ * @brief Returns a consistent snapshot of the capture counters.
+ *
+ * @param capture Pointer to the capture.
+ * @return Copy of the statistics.
+ */
+CaptureStats getCaptureStats(FrameCapture *capture);
+
+/**
+ * @brief Draws a one-line capture status (frames, drops, cost) on screen.
+ *
+ * @param capture Pointer to the capture.
+ * @param x Screen X position.
+ * @param y Screen Y position.
+ */
+void captureDrawStats(FrameCapture *capture, int x, int y);
+
+/**
+ * @brief Collects pending readbacks, drains the encoder and frees resources.
+ *
+ * @param capture Pointer to the capture to destroy.
+ */
+void destroyFrameCapture(FrameCapture *capture);
+
+#endif
@@ -0,0 +1,383 @@
+/**
+ * @file debugdraw.c
+ * @brief Implements the batched debug draw layer.
+ */
+#include "debugdraw.h"
+#include "../utils/arena.h"
+#include "../utils/resolution.h"
+#include "raylib.h"
+#include "raymath.h"
+#include "rlgl.h"
+#include "stream.h"
+#include <math.h>
+#include <string.h>
+
+/// Lines per frame arena allocation, submitted between two batch capacity
+/// checks.
+#define DEBUG_DRAW_LINES_PER_CHUNK 1024
+
+// Bit set of enabled DebugLayer values; --debug starts with the AABB layer.
+unsigned debug_draw_layers = 0;
+
+/**
+ * @brief A queued line segment.
+ */
+typedef struct DebugLine
+{
+  Vector3 from; /// Start point.
+  Vector3 to;   /// End point.
+  Color color;  /// Line color.
+} DebugLine;
+
+/**
+ * @brief Lines allocated from the frame arena together; one chunk is also
+ * one batch capacity check when flushing.
+ */
+typedef struct DebugLineChunk
+{
+  struct DebugLineChunk *next;                /// Next chunk of the frame.
+  int count;                                  /// Lines used in this chunk.
+  DebugLine lines[DEBUG_DRAW_LINES_PER_CHUNK]; /// Queued lines.
+} DebugLineChunk;
+
+/**
+ * @brief A queued text label.
+ */
+typedef struct DebugLabel
+{
+  struct DebugLabel *next; /// Next label of the frame.
+  Vector3 position;        /// World anchor.
+  Color color;             /// Text color.
+  const char *text;        /// Label text, in the frame arena.
+} DebugLabel;
+
+/**
+ * @brief Frame queues of the debug draw layer; all nodes live in the frame
+ * arena and are released with it.
+ */
+typedef struct DebugDraw
+{
+  DebugLineChunk *first_chunk; /// First line chunk of this frame.
+  DebugLineChunk *last_chunk;  /// Chunk receiving new lines.
+  int line_count;              /// Queued lines.
+  DebugLabel *first_label;     /// First label of this frame.
+  DebugLabel *last_label;      /// Last queued label.
+  int label_count;             /// Queued labels.
+  int dropped;                 /// Shapes lost to full queues or arena.
+  uint64_t frame;              /// Arena frame the queues belong to.
+} DebugDraw;
+
+static DebugDraw debug_draw = {0};
+
+/**
+ * @brief Hotkey and legend name of each layer, in bit order.
+ */
+static const struct
+{
+  int key;
+  const char *name;
+} layer_keys[] = {{KEY_F5, "aabb"},
+                  {KEY_F6, "cells"},
+                  {KEY_F7, "culling"},
+                  {KEY_F8, "velocity"},
+                  {KEY_F9, "labels"}};
+
+#define DEBUG_LAYER_COUNT ((int)(sizeof(layer_keys) / sizeof(layer_keys[0])))
+
+/**
+ * @brief Toggles layers with F5..F9. Call once per frame.
+ */
+void debugDrawHandleKeys(void)
+{
+  for (int i = 0; i < DEBUG_LAYER_COUNT; i++)
+  {
+    if (IsKeyPressed(layer_keys[i].key))
+    {
+      debug_draw_layers ^= 1u << i;
+    }
+  }
+}
+
+/**
+ * @brief Tells whether a layer is enabled, so callers can skip the work of
+ * computing shapes nobody will see.
+ *
+ * @param layer One DebugLayer value.
+ * @return True when the layer is on.
+ */
+bool debugDrawEnabled(DebugLayer layer)
+{
+  return (debug_draw_layers & (unsigned)layer) != 0;
+}
+
+/**
+ * @brief Empties the queues when the arena has started a new frame since
+ * they were filled, as their memory is gone.
+ */
+static void debugDrawSyncFrame(void)
+{
+  uint64_t frame = frameArenaFrame();
+  if (debug_draw.frame != frame)
+  {
+    memset(&debug_draw, 0, sizeof(debug_draw));
+    debug_draw.frame = frame;
+  }
+}
+
+/**
+ * @brief Queues a line segment.
+ *
+ * @param layer Layer the line belongs to.
+ * @param from Start point in world space.
+ * @param to End point in world space.
+ * @param color Line color.
+ */
+void debugDrawLine(DebugLayer layer, Vector3 from, Vector3 to, Color color)
+{
+  if (!debugDrawEnabled(layer))
+  {
+    return;
+  }
+  debugDrawSyncFrame();
+  DebugLineChunk *chunk = debug_draw.last_chunk;
+  if (!chunk || chunk->count == DEBUG_DRAW_LINES_PER_CHUNK)
+  {
+    chunk = debug_draw.line_count < DEBUG_DRAW_MAX_LINES
+                ? frameAlloc(sizeof(DebugLineChunk))
+                : NULL;
+    if (!chunk)
+    {
+      debug_draw.dropped++;
+      return;
+    }
+    chunk->next = NULL;
+    chunk->count = 0;
+    if (debug_draw.last_chunk)
+    {
+      debug_draw.last_chunk->next = chunk;
+    }
+    else
+    {
+      debug_draw.first_chunk = chunk;
+    }
+    debug_draw.last_chunk = chunk;
+  }
+  chunk->lines[chunk->count++] = (DebugLine){from, to, color};
+  debug_draw.line_count++;
+}
+
+/**
+ * @brief Queues the 12 edges of an axis-aligned box.
+ *
+ * @param layer Layer the box belongs to.
+ * @param box Box in world space.
+ * @param color Line color.
+ */
+void debugDrawBox(DebugLayer layer, BoundingBox box, Color color)
+{
+  if (!debugDrawEnabled(layer))
+  {
+    return;
+  }
+  Vector3 a = box.min;
+  Vector3 b = box.max;
+  Vector3 c[8] = {{a.x, a.y, a.z}, {b.x, a.y, a.z}, {b.x, a.y, b.z},
+                  {a.x, a.y, b.z}, {a.x, b.y, a.z}, {b.x, b.y, a.z},
+                  {b.x, b.y, b.z}, {a.x, b.y, b.z}};
+  for (int i = 0; i < 4; i++)
+  {
+    debugDrawLine(layer, c[i], c[(i + 1) % 4], color);
+    debugDrawLine(layer, c[i + 4], c[(i + 1) % 4 + 4], color);
+    debugDrawLine(layer, c[i], c[i + 4], color);
+  }
+}
+
+/**
+ * @brief Queues a sphere as three axis-aligned circles.
+ *
+ * @param layer Layer the sphere belongs to.
+ * @param center Center in world space.
+ * @param radius Sphere radius.
+ * @param color Line color.
+ */
+void debugDrawSphere(DebugLayer layer, Vector3 center, float radius,
+                     Color color)
+{
+  if (!debugDrawEnabled(layer))
+  {
+    return;
+  }
+  float step = 2.0f * PI / DEBUG_DRAW_CIRCLE_SEGMENTS;
+  for (int i = 0; i < DEBUG_DRAW_CIRCLE_SEGMENTS; i++)
+  {
+    float a0 = step * (float)i;
+    float a1 = step * (float)(i + 1);
+    float s0 = sinf(a0) * radius;
+    float c0 = cosf(a0) * radius;
+    float s1 = sinf(a1) * radius;
+    float c1 = cosf(a1) * radius;
+    debugDrawLine(layer, Vector3Add(center, (Vector3){c0, s0, 0}),
+                  Vector3Add(center, (Vector3){c1, s1, 0}), color);
+    debugDrawLine(layer, Vector3Add(center, (Vector3){c0, 0, s0}),
+                  Vector3Add(center, (Vector3){c1, 0, s1}), color);
+    debugDrawLine(layer, Vector3Add(center, (Vector3){0, c0, s0}),
+                  Vector3Add(center, (Vector3){0, c1, s1}), color);
+  }
+}
+
+/**
+ * @brief Queues the outline of a grid cell on the XZ plane.
+ *
+ * @param layer Layer the cell belongs to.
+ * @param min Corner of the cell with the smallest X and Z.
+ * @param size_x Cell extent along X.
+ * @param size_z Cell extent along Z.
+ * @param color Line color.
+ */
+void debugDrawCell(DebugLayer layer, Vector3 min, float size_x, float size_z,
+                   Color color)
+{
+  if (!debugDrawEnabled(layer))
+  {
+    return;
+  }
+  Vector3 c[4] = {min,
+                  {min.x + size_x, min.y, min.z},
+                  {min.x + size_x, min.y, min.z + size_z},
+                  {min.x, min.y, min.z + size_z}};
+  for (int i = 0; i < 4; i++)
+  {
+    debugDrawLine(layer, c[i], c[(i + 1) % 4], color);
+  }
+}
+
+/**
+ * @brief Queues a text label anchored at a world position.
+ *
+ * @param layer Layer the label belongs to.
+ * @param position Anchor in world space.
+ * @param text Label text; copied, so TextFormat results can be passed.
+ * @param color Text color.
+ */
+void debugDrawLabel(DebugLayer layer, Vector3 position, const char *text,
+                    Color color)
+{
+  if (!debugDrawEnabled(layer) || !text)
+  {
+    return;
+  }
+  debugDrawSyncFrame();
+  size_t length = strlen(text);
+  DebugLabel *label = debug_draw.label_count < DEBUG_DRAW_MAX_LABELS
+                          ? frameAlloc(sizeof(DebugLabel) + length + 1)
+                          : NULL;
+  if (!label)
+  {
+    debug_draw.dropped++;
+    return;
+  }
+  char *copy = (char *)(label + 1);
+  memcpy(copy, text, length + 1);
+  label->next = NULL;
+  label->position = position;
+  label->color = color;
+  label->text = copy;
+  if (debug_draw.last_label)
+  {
+    debug_draw.last_label->next = label;
+  }
+  else
+  {
+    debug_draw.first_label = label;
+  }
+  debug_draw.last_label = label;
+  debug_draw.label_count++;
+}
+
+/**
+ * @brief Draws every queued line in one stream ring draw, or one RL_LINES
+ * batch when the ring is off or full.
+ *
+ * Call inside BeginMode3D, after the scene.
+ */
+void debugDrawFlushLines(void)
+{
+  debugDrawSyncFrame();
+  const DebugLineChunk *chunk = debug_draw.first_chunk;
+  if (chunk && streamBegin(STREAM_LINES, 0))
+  {
+    for (; chunk; chunk = chunk->next)
+    {
+      StreamVertex *v = streamReserve(chunk->count * 2);
+      if (!v)
+      {
+        break;
+      }
+      for (int i = 0; i < chunk->count; i++)
+      {
+        const DebugLine *line = &chunk->lines[i];
+        Color c = line->color;
+        v[2 * i] = (StreamVertex){line->from.x, line->from.y, line->from.z,
+                                  0.0f, 0.0f, c.r, c.g, c.b, c.a};
+        v[2 * i + 1] = (StreamVertex){line->to.x, line->to.y, line->to.z,
+                                      0.0f, 0.0f, c.r, c.g, c.b, c.a};
+      }
+    }
+    streamEnd();
+  }
+  // Whatever did not fit in the ring
+  for (; chunk; chunk = chunk->next)
+  {
+    // Flushes the active batch only when the chunk would not fit
+    rlCheckRenderBatchLimit(chunk->count * 2);
+    rlBegin(RL_LINES);
+    for (int i = 0; i < chunk->count; i++)
+    {
+      const DebugLine *line = &chunk->lines[i];
+      rlColor4ub(line->color.r, line->color.g, line->color.b, line->color.a);
+      rlVertex3f(line->from.x, line->from.y, line->from.z);
+      rlVertex3f(line->to.x, line->to.y, line->to.z);
+    }
+    rlEnd();
+  }
+}
+
+/**
+ * @brief Draws queued labels and the layer legend, then clears the queues.
+ *
+ * Call after EndMode3D.
+ *
+ * @param camera Camera the lines were drawn with, to project labels.
+ */
+void debugDrawFlushLabels(Camera3D camera)
+{
+  debugDrawSyncFrame();
+  for (const DebugLabel *label = debug_draw.first_label; label;
+       label = label->next)
+  {
+    Vector2 at = GetWorldToScreenEx(label->position, camera, render_width,
+                                    render_height);
+    DrawText(label->text, (int)at.x, (int)at.y, 10, label->color);
+  }
+  if (debug_draw_layers != 0)
+  {
+    int x = 10;
+    int y = render_height - 46;
+    for (int i = 0; i < DEBUG_LAYER_COUNT; i++)
+    {
+      bool on = (debug_draw_layers & (1u << i)) != 0;
+      const char *text = TextFormat("F%d %s", 5 + i, layer_keys[i].name);
+      DrawText(text, x, y, 10, on ? YELLOW : GRAY);
+      x += MeasureText(text, 10) + 12;
+    }
+    FrameArenaStats arena = frameArenaStats();
+    DrawText(frameFormat("lines %d  labels %d  dropped %d  arena %.1f/%zu "
+                         "KiB peak %.1f",
+                         debug_draw.line_count, debug_draw.label_count,
+                         debug_draw.dropped, (double)arena.used / 1024.0,
+                         arena.budget / 1024, (double)arena.peak / 1024.0),
+             x, y, 10, GRAY);
+  }
+  memset(&debug_draw, 0, sizeof(debug_draw));
+  debug_draw.frame = frameArenaFrame();
+}
@@ -0,0 +1,121 @@
+/**
+ * @file debugdraw.h
+ * @brief Declares an immediate-mode debug draw layer: lines, boxes, spheres,
+ * grid cells and labels are queued in the frame arena during the frame and
+ * flushed as a single line batch, grouped in layers that can be toggled at
+ * runtime.
+ */
+#ifndef DEBUGDRAW_H
+#define DEBUGDRAW_H
+
+#include "raylib.h"
+#include <stdbool.h>
+
+/// Maximum number of queued line segments per frame; extra lines are dropped.
+#define DEBUG_DRAW_MAX_LINES 16384
+
+/// Maximum number of queued labels per frame.
+#define DEBUG_DRAW_MAX_LABELS 256
+
+/// Segments used to draw each circle of a sphere.
+#define DEBUG_DRAW_CIRCLE_SEGMENTS 16
+
+/**
+ * @brief Independently switchable groups of debug shapes.
+ */
+typedef enum DebugLayer
+{
+  DEBUG_LAYER_AABB = 1 << 0,     /// World AABBs of ships and bullets (F5).
+  DEBUG_LAYER_CELLS = 1 << 1,    /// Formation / broadphase grid cells (F6).
+  DEBUG_LAYER_CULLING = 1 << 2,  /// Per-ship light culling results (F7).
+  DEBUG_LAYER_VELOCITY = 1 << 3, /// Bullet velocity vectors (F8).
+  DEBUG_LAYER_LABELS = 1 << 4,   /// Text labels next to objects (F9).
+} DebugLayer;
+
+// Bit set of enabled DebugLayer values; --debug starts with the AABB layer.
+extern unsigned debug_draw_layers;
+
+/**
+ * @brief Toggles layers with F5..F9. Call once per frame.
+ */
+void debugDrawHandleKeys(void);
+
+/**
+ * @brief Tells whether a layer is enabled, so callers can skip the work of
+ * computing shapes nobody will see.
+ *
+ * @param layer One DebugLayer value.
+ * @return True when the layer is on.
+ */
+bool debugDrawEnabled(DebugLayer layer);
+
+/**
+ * @brief Queues a line segment.
+ *
+ * @param layer Layer the line belongs to.
+ * @param from Start point in world space.
+ * @param to End point in world space.
+ * @param color Line color.
+ */
+void debugDrawLine(DebugLayer layer, Vector3 from, Vector3 to, Color color);
+
+/**
+ * @brief Queues the 12 edges of an axis-aligned box.
+ *
+ * @param layer Layer the box belongs to.
+ * @param box Box in world space.
+ * @param color Line color.
+ */
+void debugDrawBox(DebugLayer layer, BoundingBox box, Color color);
+
+/**
+ * @brief Queues a sphere as three axis-aligned circles.
+ *
+ * @param layer Layer the sphere belongs to.
+ * @param center Center in world space.
+ * @param radius Sphere radius.
+ * @param color Line color.
+ */
+void debugDrawSphere(DebugLayer layer, Vector3 center, float radius,
+                     Color color);
+
+/**
+ * @brief Queues the outline of a grid cell on the XZ plane.
+ *
+ * @param layer Layer the cell belongs to.
+ * @param min Corner of the cell with the smallest X and Z.
+ * @param size_x Cell extent along X.
+ * @param size_z Cell extent along Z.
+ * @param color Line color.
+ */
+void debugDrawCell(DebugLayer layer, Vector3 min, float size_x, float size_z,
+                   Color color);
+
+/**
+ * @brief Queues a text label anchored at a world position.
+ *
+ * @param layer Layer the label belongs to.
+ * @param position Anchor in world space.
+ * @param text Label text; copied, so TextFormat results can be passed.
+ * @param color Text color.
+ */
+void debugDrawLabel(DebugLayer layer, Vector3 position, const char *text,
+                    Color color);
+
+/**
+ * @brief Draws every queued line in one RL_LINES batch.
+ *
+ * Call inside BeginMode3D, after the scene.
+ */
+void debugDrawFlushLines(void);
+
+/**
+ * @brief Draws queued labels and the layer legend, then clears the queues.
+ *
+ * Call after EndMode3D.
+ *
+ * @param camera Camera the lines were drawn with, to project labels.
+ */
+void debugDrawFlushLabels(Camera3D camera);
+
+#endif
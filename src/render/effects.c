@@ -0,0 +1,220 @@
+/**
+ * @file effects.c
+ * @brief Implements the reduced-resolution effects pass (see effects.h).
+ */
+#include "effects.h"
+#include "bloom.h"
+#include "fillrate.h"
+#include "gl.h"
+#include "raylib.h"
+#include "rlgl.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Scene pixels per effects pixel, per axis (1 = the pass is off).
+int effects_downscale = 1;
+
+/**
+ * @brief Parses command-line arguments for --effects-res
+ * <full|half|quarter>.
+ *
+ * @param argc The count of command-line arguments.
+ * @param argv The array of command-line argument strings.
+ */
+void checkEffectsFlag(int argc, char *argv[])
+{
+  for (int i = 1; i < argc - 1; i++)
+  {
+    if (strcmp(argv[i], "--effects-res") != 0)
+    {
+      continue;
+    }
+    const char *value = argv[i + 1];
+    if (strcmp(value, "full") == 0)
+    {
+      effects_downscale = 1;
+    }
+    else if (strcmp(value, "half") == 0)
+    {
+      effects_downscale = 2;
+    }
+    else if (strcmp(value, "quarter") == 0)
+    {
+      effects_downscale = 4;
+    }
+    else
+    {
+      TraceLog(LOG_WARNING,
+               "[Effects] unknown --effects-res \"%s\" (full, half, quarter)",
+               value);
+    }
+  }
+}
+
+/**
+ * @brief Creates the targets and loads the shaders.
+ *
+ * @param width Width of the scene in pixels.
+ * @param height Height of the scene in pixels.
+ * @param downscale Scene pixels per effects pixel, per axis (2 or 4).
+ * @return Pointer to the pass, or NULL on failure.
+ */
+EffectsPass *newEffectsPass(int width, int height, int downscale)
+{
+  EffectsPass *pass = calloc(1, sizeof(EffectsPass));
+  if (!pass)
+  {
+    return NULL;
+  }
+  pass->width = width;
+  pass->height = height;
+  pass->downscale = downscale;
+  // Later passes sample both depths, texel by texel.
+  pass->scene =
+      loadHdrTarget(width, height, HDR_DEPTH_TEXTURE, TEXTURE_FILTER_POINT);
+  // Rounded up: the last column and row cover a partial block.
+  pass->effects = loadHdrTarget((width + downscale - 1) / downscale,
+                                (height + downscale - 1) / downscale,
+                                HDR_DEPTH_TEXTURE, TEXTURE_FILTER_POINT);
+  pass->depth = loadPostShader("effects_depth.fs");
+  pass->composite = loadPostShader("effects_composite.fs");
+  if (pass->scene.id == 0 || pass->effects.id == 0 || pass->depth.id == 0 ||
+      pass->composite.id == 0)
+  {
+    TraceLog(LOG_WARNING, "[Effects] Failed to create the effects pass");
+    destroyEffectsPass(pass);
+    return NULL;
+  }
+  pass->depth_scene_loc = GetShaderLocation(pass->depth, "sceneDepth");
+  pass->depth_block_loc = GetShaderLocation(pass->depth, "blockSize");
+  pass->scene_color_loc = GetShaderLocation(pass->composite, "sceneColor");
+  pass->scene_depth_loc = GetShaderLocation(pass->composite, "sceneDepth");
+  pass->effects_color_loc =
+      GetShaderLocation(pass->composite, "effectsColor");
+  pass->effects_depth_loc =
+      GetShaderLocation(pass->composite, "effectsDepth");
+  pass->block_loc = GetShaderLocation(pass->composite, "blockSize");
+  pass->clip_loc = GetShaderLocation(pass->composite, "clipPlanes");
+  TraceLog(LOG_INFO, "[Effects] %dx%d effects over a %dx%d scene",
+           pass->effects.texture.width, pass->effects.texture.height, width,
+           height);
+  return pass;
+}
+
+/**
+ * @brief Redirects the scene into the full-resolution scene target.
+ *
+ * @param pass Pointer to the effects pass.
+ */
+void effectsBeginScene(EffectsPass *pass)
+{
+  BeginTextureMode(pass->scene);
+}
+
+/**
+ * @brief Starts drawing effects; call inside BeginMode3D, after every
+ * opaque draw.
+ *
+ * @param pass Pointer to the effects pass.
+ * @param camera Camera of the frame.
+ */
+void effectsBeginParticles(EffectsPass *pass, Camera3D camera)
+{
+  EndMode3D();
+  BeginTextureMode(pass->effects);
+  fillRateNoteMatrix();
+
+  // One quad writes the downsampled depth and clears the colour. Depth
+  // writes only happen with the test on, so it is on and always passes.
+  rlEnableDepthTest();
+  glDepthFunc(GL_ALWAYS);
+  BeginShaderMode(pass->depth);
+  SetShaderValueTexture(pass->depth, pass->depth_scene_loc,
+                        pass->scene.depth);
+  SetShaderValue(pass->depth, pass->depth_block_loc, &pass->downscale,
+                 SHADER_UNIFORM_INT);
+  DrawRectangle(0, 0, pass->effects.texture.width,
+                pass->effects.texture.height, WHITE);
+  EndShaderMode();
+  glDepthFunc(GL_LEQUAL);
+
+  BeginMode3D(camera);
+  fillRateNoteMatrix();
+  // Particles are tested against the scene but never occlude each other.
+  rlDisableDepthMask();
+  fillRateSetEffectsBlend(true);
+}
+
+/**
+ * @brief Stops drawing effects and returns to the scene target, still in
+ * BeginMode3D with the same camera.
+ *
+ * @param pass Pointer to the effects pass.
+ * @param camera Camera of the frame.
+ */
+void effectsEndParticles(EffectsPass *pass, Camera3D camera)
+{
+  fillRateSetEffectsBlend(false);
+  rlEnableDepthMask();
+  EndMode3D();
+  BeginTextureMode(pass->scene);
+  BeginMode3D(camera);
+  fillRateNoteMatrix();
+}
+
+/**
+ * @brief Finishes the scene target; call after EndMode3D.
+ *
+ * @param pass Pointer to the effects pass.
+ */
+void effectsEndScene(EffectsPass *pass)
+{
+  (void)pass;
+  EndTextureMode();
+}
+
+/**
+ * @brief Draws the scene with the upsampled effects on top into the current
+ * target (screen, bloom scene or offline frame).
+ *
+ * The composite reads every texture with texelFetch at gl_FragCoord, so the
+ * destination needs the size of the scene and nothing is flipped.
+ *
+ * @param pass Pointer to the effects pass.
+ */
+void effectsComposite(EffectsPass *pass)
+{
+  float clip[2] = {(float)RL_CULL_DISTANCE_NEAR, (float)RL_CULL_DISTANCE_FAR};
+  BeginShaderMode(pass->composite);
+  SetShaderValueTexture(pass->composite, pass->scene_color_loc,
+                        pass->scene.texture);
+  SetShaderValueTexture(pass->composite, pass->scene_depth_loc,
+                        pass->scene.depth);
+  SetShaderValueTexture(pass->composite, pass->effects_color_loc,
+                        pass->effects.texture);
+  SetShaderValueTexture(pass->composite, pass->effects_depth_loc,
+                        pass->effects.depth);
+  SetShaderValue(pass->composite, pass->block_loc, &pass->downscale,
+                 SHADER_UNIFORM_INT);
+  SetShaderValue(pass->composite, pass->clip_loc, clip, SHADER_UNIFORM_VEC2);
+  DrawRectangle(0, 0, pass->width, pass->height, WHITE);
+  EndShaderMode();
+}
+
+/**
+ * @brief Frees the targets and shaders.
+ *
+ * @param pass Pointer to the effects pass to destroy.
+ */
+void destroyEffectsPass(EffectsPass *pass)
+{
+  if (!pass)
+    return;
+  unloadHdrTarget(pass->scene);
+  unloadHdrTarget(pass->effects);
+  if (pass->depth.id != 0)
+    UnloadShader(pass->depth);
+  if (pass->composite.id != 0)
+    UnloadShader(pass->composite);
+  free(pass);
+}
@@ -0,0 +1,115 @@
+/**
+ * @file effects.h
+ * @brief Declares the reduced-resolution pass for blended effects: explosion,
+ * trail, sprite and starfield particles are drawn into a half- or
+ * quarter-resolution target, depth-tested against a downsampled copy of the
+ * scene depth, and composited back with a depth-aware upsample.
+ *
+ * The effects target holds the particle colour in rgb and, in alpha, how
+ * much of the scene behind still shows through (transmittance). The blend
+ * hooks in fillrate.h switch to matching blend factors while the pass is
+ * open, so alpha-blended and additive particles can share it.
+ */
+#ifndef EFFECTS_H
+#define EFFECTS_H
+
+#include "raylib.h"
+#include <stdbool.h>
+
+// Scene pixels per effects pixel, per axis: 1 (full resolution, the pass is
+// off), 2 (half) or 4 (quarter). Set by --effects-res.
+extern int effects_downscale;
+
+/**
+ * @brief Parses command-line arguments for --effects-res
+ * <full|half|quarter>.
+ *
+ * @param argc The count of command-line arguments.
+ * @param argv The array of command-line argument strings.
+ */
+void checkEffectsFlag(int argc, char *argv[]);
+
+/**
+ * @brief Targets and shaders of the reduced-resolution effects pass.
+ */
+typedef struct EffectsPass
+{
+  int width;               /// Scene width in pixels.
+  int height;              /// Scene height in pixels.
+  int downscale;           /// Scene pixels per effects pixel, per axis.
+  RenderTexture2D scene;   /// Full-resolution half-float scene, depth texture.
+  RenderTexture2D effects; /// Reduced-resolution effects, depth texture.
+  Shader depth;            /// Downsamples the scene depth.
+  Shader composite;        /// Depth-aware upsample over the scene.
+  int depth_scene_loc;     /// "sceneDepth" uniform of the depth shader.
+  int depth_block_loc;     /// "blockSize" uniform of the depth shader.
+  int scene_color_loc;     /// "sceneColor" uniform of the composite.
+  int scene_depth_loc;     /// "sceneDepth" uniform of the composite.
+  int effects_color_loc;   /// "effectsColor" uniform of the composite.
+  int effects_depth_loc;   /// "effectsDepth" uniform of the composite.
+  int block_loc;           /// "blockSize" uniform of the composite.
+  int clip_loc;            /// "clipPlanes" uniform of the composite.
+} EffectsPass;
+
+/**
+ * @brief Creates the targets and loads the shaders.
+ *
+ * @param width Width of the scene in pixels.
+ * @param height Height of the scene in pixels.
+ * @param downscale Scene pixels per effects pixel, per axis (2 or 4).
+ * @return Pointer to the pass, or NULL on failure.
+ */
+EffectsPass *newEffectsPass(int width, int height, int downscale);
+
+/**
+ * @brief Redirects the scene into the full-resolution scene target, whose
+ * depth the effects are tested against.
+ *
+ * @param pass Pointer to the effects pass.
+ */
+void effectsBeginScene(EffectsPass *pass);
+
+/**
+ * @brief Starts drawing effects; call inside BeginMode3D, after every
+ * opaque draw.
+ *
+ * Downsamples the scene depth, switches to the effects target with the same
+ * camera and turns depth writes off.
+ *
+ * @param pass Pointer to the effects pass.
+ * @param camera Camera of the frame.
+ */
+void effectsBeginParticles(EffectsPass *pass, Camera3D camera);
+
+/**
+ * @brief Stops drawing effects and returns to the scene target, still in
+ * BeginMode3D with the same camera.
+ *
+ * @param pass Pointer to the effects pass.
+ * @param camera Camera of the frame.
+ */
+void effectsEndParticles(EffectsPass *pass, Camera3D camera);
+
+/**
+ * @brief Finishes the scene target; call after EndMode3D.
+ *
+ * @param pass Pointer to the effects pass.
+ */
+void effectsEndScene(EffectsPass *pass);
+
+/**
+ * @brief Draws the scene with the upsampled effects on top into the current
+ * target (screen, bloom scene or offline frame).
+ *
+ * @param pass Pointer to the effects pass.
+ */
+void effectsComposite(EffectsPass *pass);
+
+/**
+ * @brief Frees the targets and shaders.
+ *
+ * @param pass Pointer to the effects pass to destroy.
+ */
+void destroyEffectsPass(EffectsPass *pass);
+
+#endif
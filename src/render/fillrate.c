@@ -0,0 +1,442 @@
+/**
+ * @file fillrate.c
+ * @brief Implements the overdraw heat map and the batch-break overlay.
+ */
+#include "fillrate.h"
+#include "../utils/profiler.h"
+#include "bloom.h"
+#include "gl.h"
+#include "raylib.h"
+#include "rlgl.h"
+#include "stream.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Overdraw heat map on (F10 or --overdraw).
+bool is_overdraw_view = false;
+
+// Batch-break overlay on (F11 or --batch-breaks).
+bool is_batch_break_view = false;
+
+/**
+ * @brief One recorded draw call.
+ */
+typedef struct BatchBreakEntry
+{
+  const char *pass; /// Render pass it belongs to (profiler pass name).
+  uint8_t reason;   /// BatchBreak that started it.
+} BatchBreakEntry;
+
+/**
+ * @brief Draw calls of the current frame and the state they are compared
+ * against.
+ */
+typedef struct BatchBreaks
+{
+  BatchBreakEntry items[BATCH_BREAK_MAX]; /// Draw calls, in order.
+  int count;                              /// Entries in items.
+  int total[BATCH_BREAK_COUNT];           /// All draw calls per reason.
+  unsigned int texture;                   /// Texture of the last batched draw.
+  int blend;                              /// Current blend mode.
+  unsigned int shader;                    /// Shader of the last model, 0 if none.
+} BatchBreaks;
+
+static BatchBreaks breaks = {0};
+
+// True between overdrawBeginScene and overdrawEndScene.
+static bool overdraw_active = false;
+
+// True while drawing into the effects target (see effects.h).
+static bool effects_blend = false;
+
+/// Labels of BatchBreak values.
+static const char *const BATCH_BREAK_NAMES[BATCH_BREAK_COUNT] = {
+    "texture", "blend", "shader", "matrix", "model"};
+
+/// Overlay colour of each BatchBreak value (sky blue, orange, violet,
+/// yellow, light gray).
+static const Color BATCH_BREAK_COLORS[BATCH_BREAK_COUNT] = {
+    {102, 191, 255, 255},
+    {255, 161, 0, 255},
+    {135, 60, 190, 255},
+    {253, 249, 0, 255},
+    {200, 200, 200, 255}};
+
+/**
+ * @brief Parses command-line arguments for --overdraw and --batch-breaks.
+ *
+ * @param argc The count of command-line arguments.
+ * @param argv The array of command-line argument strings.
+ */
+void checkFillRateFlags(int argc, char *argv[])
+{
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--overdraw") == 0)
+    {
+      is_overdraw_view = true;
+    }
+    else if (strcmp(argv[i], "--batch-breaks") == 0)
+    {
+      is_batch_break_view = true;
+    }
+  }
+}
+
+/**
+ * @brief Toggles the heat map with F10 and the overlay with F11.
+ */
+void fillRateHandleKeys(void)
+{
+  if (IsKeyPressed(KEY_F10))
+  {
+    is_overdraw_view = !is_overdraw_view;
+  }
+  if (IsKeyPressed(KEY_F11))
+  {
+    is_batch_break_view = !is_batch_break_view;
+  }
+}
+
+/**
+ * @brief Records a draw call started for the given reason.
+ */
+static void batchBreakRecord(BatchBreak reason)
+{
+  if (!is_batch_break_view)
+  {
+    return;
+  }
+  breaks.total[reason]++;
+  if (breaks.count < BATCH_BREAK_MAX)
+  {
+    breaks.items[breaks.count++] =
+        (BatchBreakEntry){profilerGpuPassName(), (uint8_t)reason};
+  }
+}
+
+/**
+ * @brief Creates the heat map target and loads its shaders.
+ *
+ * @param width Width of the scene in pixels.
+ * @param height Height of the scene in pixels.
+ * @return Pointer to the heat map state, or NULL on failure.
+ */
+Overdraw *newOverdraw(int width, int height)
+{
+  Overdraw *overdraw = calloc(1, sizeof(Overdraw));
+  if (!overdraw)
+  {
+    return NULL;
+  }
+  overdraw->width = width;
+  overdraw->height = height;
+  // Half floats count exactly up to 2048 layers; 8 bits would clip at 255.
+  overdraw->layers =
+      loadHdrTarget(width, height, HDR_DEPTH_BUFFER, TEXTURE_FILTER_BILINEAR);
+  overdraw->count = loadPostShader("overdraw_count.fs");
+  overdraw->heat = loadPostShader("overdraw_heat.fs");
+  if (overdraw->layers.id == 0 || overdraw->count.id == 0 ||
+      overdraw->heat.id == 0)
+  {
+    TraceLog(LOG_WARNING, "[Overdraw] Failed to create the heat map");
+    destroyOverdraw(overdraw);
+    return NULL;
+  }
+  overdraw->max_layers_loc = GetShaderLocation(overdraw->heat, "maxLayers");
+  return overdraw;
+}
+
+/**
+ * @brief Redirects the scene into the layer target.
+ *
+ * @param overdraw Pointer to the heat map state.
+ */
+void overdrawBeginScene(Overdraw *overdraw)
+{
+  BeginTextureMode(overdraw->layers);
+  // Every batched fragment adds one: the count shader writes 1 with alpha 1,
+  // and additive blending sums it into the target.
+  BeginShaderMode(overdraw->count);
+  streamSetShader(overdraw->count);
+  BeginBlendMode(BLEND_ADDITIVE);
+  overdraw_active = true;
+}
+
+/**
+ * @brief Finishes the layer target and restores normal drawing.
+ *
+ * @param overdraw Pointer to the heat map state.
+ */
+void overdrawEndScene(Overdraw *overdraw)
+{
+  (void)overdraw;
+  overdraw_active = false;
+  EndBlendMode();
+  streamSetShader((Shader){0});
+  EndShaderMode();
+  EndTextureMode();
+}
+
+/**
+ * @brief Draws the colour-mapped layers and a legend into the current
+ * target (screen or texture).
+ *
+ * @param overdraw Pointer to the heat map state.
+ */
+void overdrawComposite(Overdraw *overdraw)
+{
+  float max_layers = OVERDRAW_MAX_LAYERS;
+  BeginShaderMode(overdraw->heat);
+  SetShaderValue(overdraw->heat, overdraw->max_layers_loc, &max_layers,
+                 SHADER_UNIFORM_FLOAT);
+  DrawTexturePro(overdraw->layers.texture,
+                 (Rectangle){0.0f, 0.0f, (float)overdraw->width,
+                             -(float)overdraw->height},
+                 (Rectangle){0.0f, 0.0f, (float)overdraw->width,
+                             (float)overdraw->height},
+                 (Vector2){0.0f, 0.0f}, 0.0f, WHITE);
+  EndShaderMode();
+
+  // Legend: the ramp of the heat shader, labelled in layers
+  const Color ramp[6] = {BLACK,
+                         {0, 51, 255, 255},
+                         {0, 230, 230, 255},
+                         {26, 230, 26, 255},
+                         {255, 230, 0, 255},
+                         {255, 26, 0, 255}};
+  const int step = 40;
+  int x = 10;
+  int y = overdraw->height - 60;
+  DrawRectangle(x - 6, y - 26, 5 * step + 12, 58, Fade(BLACK, 0.6f));
+  DrawText("overdraw (blended layers)", x, y - 20, 16, RAYWHITE);
+  for (int i = 0; i < 5; i++)
+  {
+    DrawRectangleGradientH(x + i * step, y, step, 10, ramp[i], ramp[i + 1]);
+    DrawText(TextFormat("%.0f", OVERDRAW_MAX_LAYERS * (float)i / 5.0f),
+             x + i * step, y + 14, 10, RAYWHITE);
+  }
+  DrawText(TextFormat("%.0f+", OVERDRAW_MAX_LAYERS), x + 5 * step - 12, y + 14,
+           10, RAYWHITE);
+}
+
+/**
+ * @brief Frees the heat map target and shaders.
+ *
+ * @param overdraw Pointer to the heat map state to destroy.
+ */
+void destroyOverdraw(Overdraw *overdraw)
+{
+  if (!overdraw)
+    return;
+  unloadHdrTarget(overdraw->layers);
+  if (overdraw->count.id != 0)
+    UnloadShader(overdraw->count);
+  if (overdraw->heat.id != 0)
+    UnloadShader(overdraw->heat);
+  free(overdraw);
+}
+
+/**
+ * @brief Applies a blend mode, remapped for the effects target when it is
+ * bound.
+ *
+ * The effects target keeps the transmittance of the scene behind in alpha:
+ * every layer scales it by its own (1 - alpha), and additive layers leave it
+ * alone. Colour blends as usual.
+ */
+static void applyBlend(int mode)
+{
+  if (!effects_blend)
+  {
+    BeginBlendMode(mode);
+    return;
+  }
+  bool additive = mode == BLEND_ADDITIVE;
+  rlSetBlendFactorsSeparate(RL_SRC_ALPHA,
+                            additive ? RL_ONE : RL_ONE_MINUS_SRC_ALPHA,
+                            RL_ZERO,
+                            additive ? RL_ONE : RL_ONE_MINUS_SRC_ALPHA,
+                            RL_FUNC_ADD, RL_FUNC_ADD);
+  BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+}
+
+/**
+ * @brief Switches the blend hooks to the factors of the effects target.
+ *
+ * @param enabled True right after binding the effects target, false right
+ * before leaving it.
+ */
+void fillRateSetEffectsBlend(bool enabled)
+{
+  rlDrawRenderBatchActive();
+  effects_blend = enabled;
+  // Draws that never call the hooks (sprites, starfield) use the default
+  // alpha blending, which has to be remapped as well.
+  applyBlend(BLEND_ALPHA);
+}
+
+/**
+ * @brief Sets a blend mode for a pass; replaces BeginBlendMode.
+ *
+ * The heat map keeps its additive counting, whatever the pass asks for.
+ *
+ * @param mode BLEND_* mode.
+ */
+void fillRateBlendBegin(int mode)
+{
+  if (overdraw_active)
+  {
+    return;
+  }
+  if (mode != breaks.blend)
+  {
+    breaks.blend = mode;
+    batchBreakRecord(BATCH_BREAK_BLEND);
+  }
+  applyBlend(mode);
+}
+
+/**
+ * @brief Restores the default blend mode; replaces EndBlendMode.
+ */
+void fillRateBlendEnd(void)
+{
+  if (overdraw_active)
+  {
+    return;
+  }
+  if (breaks.blend != BLEND_ALPHA)
+  {
+    breaks.blend = BLEND_ALPHA;
+    batchBreakRecord(BATCH_BREAK_BLEND);
+  }
+  applyBlend(BLEND_ALPHA);
+}
+
+/**
+ * @brief Call before drawing a model with the given shader.
+ *
+ * In the heat map the pending batch is flushed and colour writes are turned
+ * off, so the model only occludes the fragments behind it.
+ *
+ * @param shader_id GL id of the model's shader.
+ */
+void fillRateModelBegin(unsigned int shader_id)
+{
+  if (overdraw_active)
+  {
+    rlDrawRenderBatchActive();
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+  }
+  batchBreakRecord(shader_id != breaks.shader ? BATCH_BREAK_SHADER
+                                              : BATCH_BREAK_MODEL);
+  breaks.shader = shader_id;
+}
+
+/**
+ * @brief Call after drawing a model.
+ */
+void fillRateModelEnd(void)
+{
+  if (overdraw_active)
+  {
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+  }
+}
+
+/**
+ * @brief Reports a batched draw sampling the given texture.
+ *
+ * @param texture_id GL id of the texture (0 = default white texture).
+ */
+void fillRateNoteTexture(unsigned int texture_id)
+{
+  // Batched draws use the default shader; the next model switches again
+  breaks.shader = 0;
+  if (texture_id != breaks.texture)
+  {
+    breaks.texture = texture_id;
+    batchBreakRecord(BATCH_BREAK_TEXTURE);
+  }
+}
+
+/**
+ * @brief Reports a projection or render target change.
+ */
+void fillRateNoteMatrix(void)
+{
+  batchBreakRecord(BATCH_BREAK_MATRIX);
+}
+
+/**
+ * @brief Clears the draw calls recorded in the previous frame.
+ */
+void fillRateBeginFrame(void)
+{
+  breaks.count = 0;
+  memset(breaks.total, 0, sizeof(breaks.total));
+  breaks.texture = 0;
+  breaks.blend = BLEND_ALPHA;
+  breaks.shader = 0;
+}
+
+/**
+ * @brief Draws the batch-break overlay.
+ *
+ * Consecutive draw calls of the same pass and reason share a row, so a
+ * pass that breaks on every particle shows up as one long run.
+ *
+ * @param x Left edge in pixels.
+ * @param y Top edge in pixels.
+ */
+void fillRateDrawBreaks(int x, int y)
+{
+  if (!is_batch_break_view)
+  {
+    return;
+  }
+  const int font = 16;
+  const int line = font + 4;
+  int calls = 0;
+  for (int r = 0; r < BATCH_BREAK_COUNT; r++)
+  {
+    calls += breaks.total[r];
+  }
+  DrawRectangle(x - 6, y - 6, 300, (BATCH_BREAK_ROWS + 4) * line + 8,
+                Fade(BLACK, 0.6f));
+  DrawText(TextFormat("draw calls %d", calls), x, y, font, RAYWHITE);
+  y += line;
+  for (int r = 0; r < BATCH_BREAK_COUNT; r++)
+  {
+    DrawText(TextFormat("%s %d", BATCH_BREAK_NAMES[r], breaks.total[r]),
+             x + (r % 3) * 96, y + (r / 3) * line, font,
+             BATCH_BREAK_COLORS[r]);
+  }
+  y += 2 * line;
+
+  int rows = 0;
+  int shown = 0;
+  for (int i = 0; i < breaks.count && rows < BATCH_BREAK_ROWS; rows++)
+  {
+    const BatchBreakEntry *entry = &breaks.items[i];
+    int run = 1;
+    while (i + run < breaks.count &&
+           breaks.items[i + run].reason == entry->reason &&
+           breaks.items[i + run].pass == entry->pass)
+    {
+      run++;
+    }
+    DrawText(TextFormat("#%-4d %-11s %-7s x%d", i + 1, entry->pass,
+                        BATCH_BREAK_NAMES[entry->reason], run),
+             x, y + rows * line, font, BATCH_BREAK_COLORS[entry->reason]);
+    i += run;
+    shown = i;
+  }
+  if (shown < calls)
+  {
+    DrawText(TextFormat("... %d more", calls - shown), x,
+             y + rows * line, font, GRAY);
+  }
+}
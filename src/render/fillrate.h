@@ -0,0 +1,173 @@
+/**
+ * @file fillrate.h
+ * @brief Declares the fill-rate and draw-call debug views: an overdraw heat
+ * map of the 3D scene and an overlay listing every draw call with the reason
+ * the previous batch was flushed.
+ *
+ * Passes that change blending, textures or shaders report it through the
+ * fillRate* hooks below instead of calling raylib directly; the hooks cost a
+ * comparison while both views are off.
+ */
+#ifndef FILLRATE_H
+#define FILLRATE_H
+
+#include "raylib.h"
+#include <stdbool.h>
+
+/// Layer count shown as the last colour of the heat map ramp (red).
+#define OVERDRAW_MAX_LAYERS 16.0f
+
+/// Draw calls recorded per frame for the overlay; extra ones are counted.
+#define BATCH_BREAK_MAX 1024
+
+/// Rows of the overlay list (consecutive identical draws share a row).
+#define BATCH_BREAK_ROWS 32
+
+// Overdraw heat map on (F10 or --overdraw).
+extern bool is_overdraw_view;
+
+// Batch-break overlay on (F11 or --batch-breaks).
+extern bool is_batch_break_view;
+
+/**
+ * @brief Parses command-line arguments for --overdraw and --batch-breaks.
+ *
+ * @param argc The count of command-line arguments.
+ * @param argv The array of command-line argument strings.
+ */
+void checkFillRateFlags(int argc, char *argv[]);
+
+/**
+ * @brief Toggles the heat map with F10 and the overlay with F11. Call once
+ * per frame.
+ */
+void fillRateHandleKeys(void);
+
+/**
+ * @brief Why a draw call did not join the previous batch.
+ */
+typedef enum BatchBreak
+{
+  BATCH_BREAK_TEXTURE = 0, /// Different texture: new draw in the batch.
+  BATCH_BREAK_BLEND,       /// Blend mode change: batch flushed.
+  BATCH_BREAK_SHADER,      /// Shader change: batch flushed.
+  BATCH_BREAK_MATRIX,      /// Projection or target change: batch flushed.
+  BATCH_BREAK_MODEL,       /// Model mesh: drawn directly, never batched.
+  BATCH_BREAK_COUNT
+} BatchBreak;
+
+/**
+ * @brief Overdraw heat map target and shaders.
+ */
+typedef struct Overdraw
+{
+  int width;               /// Target width in pixels.
+  int height;              /// Target height in pixels.
+  RenderTexture2D layers;  /// Half-float layer counts, with depth.
+  Shader count;            /// Adds one layer per fragment.
+  Shader heat;             /// Maps layer counts to colours.
+  int max_layers_loc;      /// "maxLayers" uniform.
+} Overdraw;
+
+/**
+ * @brief Creates the heat map target and loads its shaders.
+ *
+ * @param width Width of the scene in pixels.
+ * @param height Height of the scene in pixels.
+ * @return Pointer to the heat map state, or NULL on failure.
+ */
+Overdraw *newOverdraw(int width, int height);
+
+/**
+ * @brief Redirects the scene into the layer target.
+ *
+ * Until overdrawEndScene every batched fragment adds one layer, whatever
+ * the pass asks for, and model meshes only write depth (they are opaque).
+ *
+ * @param overdraw Pointer to the heat map state.
+ */
+void overdrawBeginScene(Overdraw *overdraw);
+
+/**
+ * @brief Finishes the layer target and restores normal drawing.
+ *
+ * @param overdraw Pointer to the heat map state.
+ */
+void overdrawEndScene(Overdraw *overdraw);
+
+/**
+ * @brief Draws the colour-mapped layers and a legend into the current
+ * target (screen or texture).
+ *
+ * @param overdraw Pointer to the heat map state.
+ */
+void overdrawComposite(Overdraw *overdraw);
+
+/**
+ * @brief Frees the heat map target and shaders.
+ *
+ * @param overdraw Pointer to the heat map state to destroy.
+ */
+void destroyOverdraw(Overdraw *overdraw);
+
+/**
+ * @brief Sets a blend mode for a pass; replaces BeginBlendMode.
+ *
+ * @param mode BLEND_* mode.
+ */
+void fillRateBlendBegin(int mode);
+
+/**
+ * @brief Restores the default blend mode; replaces EndBlendMode.
+ */
+void fillRateBlendEnd(void);
+
+/**
+ * @brief Switches the blend hooks to the factors of the effects target,
+ * whose alpha holds the transmittance of the scene behind (see effects.h).
+ *
+ * @param enabled True right after binding the effects target, false right
+ * before leaving it.
+ */
+void fillRateSetEffectsBlend(bool enabled);
+
+/**
+ * @brief Call before drawing a model with the given shader.
+ *
+ * @param shader_id GL id of the model's shader.
+ */
+void fillRateModelBegin(unsigned int shader_id);
+
+/**
+ * @brief Call after drawing a model.
+ */
+void fillRateModelEnd(void);
+
+/**
+ * @brief Reports a batched draw sampling the given texture.
+ *
+ * @param texture_id GL id of the texture (0 = default white texture).
+ */
+void fillRateNoteTexture(unsigned int texture_id);
+
+/**
+ * @brief Reports a projection or render target change (BeginMode3D,
+ * EndMode3D, BeginTextureMode...).
+ */
+void fillRateNoteMatrix(void);
+
+/**
+ * @brief Clears the draw calls recorded in the previous frame.
+ */
+void fillRateBeginFrame(void);
+
+/**
+ * @brief Draws the batch-break overlay: totals per reason and the draw
+ * calls of the frame in order, labelled with their pass.
+ *
+ * @param x Left edge in pixels.
+ * @param y Top edge in pixels.
+ */
+void fillRateDrawBreaks(int x, int y);
+
+#endif
@@ -0,0 +1,45 @@
+/**
+ * @file gl.c
+ * @brief Loads the GL functions the renderer calls directly (see gl.h).
+ */
+#include "gl.h"
+#include "raylib.h"
+#include <stddef.h>
+
+#if !defined(__APPLE__)
+
+// raylib links GLFW but does not install its header.
+typedef void (*GLFWglproc)(void);
+GLFWglproc glfwGetProcAddress(const char *procname);
+
+#define GL_DEFINE_FUNCTION(type, name) type loaded_##name = NULL;
+GL_FUNCTIONS(GL_DEFINE_FUNCTION)
+#undef GL_DEFINE_FUNCTION
+
+#endif
+
+/**
+ * @brief Loads the GL functions called outside raylib from the current
+ * context; call once right after InitWindow, before any of them is used.
+ *
+ * @return False when a function is missing; nothing in gl.h may be called
+ * then.
+ */
+bool loadGlFunctions(void)
+{
+#if defined(__APPLE__)
+  return true;
+#else
+  bool complete = true;
+#define GL_LOAD_FUNCTION(type, name)                                           \
+  loaded_##name = (type)glfwGetProcAddress(#name);                             \
+  if (!loaded_##name)                                                          \
+  {                                                                            \
+    TraceLog(LOG_ERROR, "[GL] %s is not available", #name);                    \
+    complete = false;                                                          \
+  }
+  GL_FUNCTIONS(GL_LOAD_FUNCTION)
+#undef GL_LOAD_FUNCTION
+  return complete;
+#endif
+}
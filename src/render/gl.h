@@ -0,0 +1,149 @@
+/**
+ * @file gl.h
+ * @brief Platform GL header for the few renderer features raylib does not
+ * wrap (pixel buffer objects, fences, queries, framebuffers).
+ *
+ * raylib creates a desktop OpenGL 3.3 context and loads its own functions
+ * through GLFW. On macOS the OpenGL framework is called directly. Elsewhere
+ * the functions called here are loaded the same way, through GLFW, by
+ * loadGlFunctions: calls made through libGL reach only the contexts libGL
+ * dispatches to, which excludes the OSMesa context of headless builds.
+ */
+#ifndef RENDER_GL_H
+#define RENDER_GL_H
+
+#include <stdbool.h>
+
+#if defined(__APPLE__)
+#define GL_SILENCE_DEPRECATION
+#include <OpenGL/gl3.h>
+#else
+#include <GL/glcorearb.h>
+
+/**
+ * @brief GL functions called outside raylib, with their pointer types.
+ *
+ * Every name is redirected to a loaded_ pointer below; add new functions to
+ * both lists.
+ */
+#define GL_FUNCTIONS(X)                                                        \
+  X(PFNGLACTIVETEXTUREPROC, glActiveTexture)                                   \
+  X(PFNGLBINDBUFFERPROC, glBindBuffer)                                         \
+  X(PFNGLBINDFRAMEBUFFERPROC, glBindFramebuffer)                               \
+  X(PFNGLBINDRENDERBUFFERPROC, glBindRenderbuffer)                             \
+  X(PFNGLBINDTEXTUREPROC, glBindTexture)                                       \
+  X(PFNGLBINDVERTEXARRAYPROC, glBindVertexArray)                               \
+  X(PFNGLBUFFERDATAPROC, glBufferData)                                         \
+  X(PFNGLCHECKFRAMEBUFFERSTATUSPROC, glCheckFramebufferStatus)                 \
+  X(PFNGLCLIENTWAITSYNCPROC, glClientWaitSync)                                 \
+  X(PFNGLCOLORMASKPROC, glColorMask)                                           \
+  X(PFNGLDELETEBUFFERSPROC, glDeleteBuffers)                                   \
+  X(PFNGLDELETEFRAMEBUFFERSPROC, glDeleteFramebuffers)                         \
+  X(PFNGLDELETEQUERIESPROC, glDeleteQueries)                                   \
+  X(PFNGLDELETERENDERBUFFERSPROC, glDeleteRenderbuffers)                       \
+  X(PFNGLDELETESYNCPROC, glDeleteSync)                                         \
+  X(PFNGLDELETETEXTURESPROC, glDeleteTextures)                                 \
+  X(PFNGLDELETEVERTEXARRAYSPROC, glDeleteVertexArrays)                         \
+  X(PFNGLDEPTHFUNCPROC, glDepthFunc)                                           \
+  X(PFNGLDRAWARRAYSPROC, glDrawArrays)                                         \
+  X(PFNGLDRAWELEMENTSBASEVERTEXPROC, glDrawElementsBaseVertex)                 \
+  X(PFNGLENABLEVERTEXATTRIBARRAYPROC, glEnableVertexAttribArray)               \
+  X(PFNGLFENCESYNCPROC, glFenceSync)                                           \
+  X(PFNGLFINISHPROC, glFinish)                                                 \
+  X(PFNGLFLUSHMAPPEDBUFFERRANGEPROC, glFlushMappedBufferRange)                 \
+  X(PFNGLFRAMEBUFFERRENDERBUFFERPROC, glFramebufferRenderbuffer)               \
+  X(PFNGLFRAMEBUFFERTEXTURE2DPROC, glFramebufferTexture2D)                     \
+  X(PFNGLGENBUFFERSPROC, glGenBuffers)                                         \
+  X(PFNGLGENFRAMEBUFFERSPROC, glGenFramebuffers)                               \
+  X(PFNGLGENQUERIESPROC, glGenQueries)                                         \
+  X(PFNGLGENRENDERBUFFERSPROC, glGenRenderbuffers)                             \
+  X(PFNGLGENTEXTURESPROC, glGenTextures)                                       \
+  X(PFNGLGENVERTEXARRAYSPROC, glGenVertexArrays)                               \
+  X(PFNGLGETERRORPROC, glGetError)                                             \
+  X(PFNGLGETFRAMEBUFFERATTACHMENTPARAMETERIVPROC,                              \
+    glGetFramebufferAttachmentParameteriv)                                     \
+  X(PFNGLGETQUERYIVPROC, glGetQueryiv)                                         \
+  X(PFNGLGETQUERYOBJECTIVPROC, glGetQueryObjectiv)                             \
+  X(PFNGLGETQUERYOBJECTUI64VPROC, glGetQueryObjectui64v)                       \
+  X(PFNGLGETSTRINGPROC, glGetString)                                           \
+  X(PFNGLMAPBUFFERRANGEPROC, glMapBufferRange)                                 \
+  X(PFNGLPIXELSTOREIPROC, glPixelStorei)                                       \
+  X(PFNGLQUERYCOUNTERPROC, glQueryCounter)                                     \
+  X(PFNGLREADPIXELSPROC, glReadPixels)                                         \
+  X(PFNGLRENDERBUFFERSTORAGEPROC, glRenderbufferStorage)                       \
+  X(PFNGLTEXIMAGE2DPROC, glTexImage2D)                                         \
+  X(PFNGLTEXPARAMETERIPROC, glTexParameteri)                                   \
+  X(PFNGLUNIFORM1IPROC, glUniform1i)                                           \
+  X(PFNGLUNIFORM4FPROC, glUniform4f)                                           \
+  X(PFNGLUNIFORMMATRIX4FVPROC, glUniformMatrix4fv)                             \
+  X(PFNGLUNMAPBUFFERPROC, glUnmapBuffer)                                       \
+  X(PFNGLUSEPROGRAMPROC, glUseProgram)                                         \
+  X(PFNGLVERTEXATTRIBPOINTERPROC, glVertexAttribPointer)
+
+#define GL_DECLARE_FUNCTION(type, name) extern type loaded_##name;
+GL_FUNCTIONS(GL_DECLARE_FUNCTION)
+#undef GL_DECLARE_FUNCTION
+
+#define glActiveTexture loaded_glActiveTexture
+#define glBindBuffer loaded_glBindBuffer
+#define glBindFramebuffer loaded_glBindFramebuffer
+#define glBindRenderbuffer loaded_glBindRenderbuffer
+#define glBindTexture loaded_glBindTexture
+#define glBindVertexArray loaded_glBindVertexArray
+#define glBufferData loaded_glBufferData
+#define glCheckFramebufferStatus loaded_glCheckFramebufferStatus
+#define glClientWaitSync loaded_glClientWaitSync
+#define glColorMask loaded_glColorMask
+#define glDeleteBuffers loaded_glDeleteBuffers
+#define glDeleteFramebuffers loaded_glDeleteFramebuffers
+#define glDeleteQueries loaded_glDeleteQueries
+#define glDeleteRenderbuffers loaded_glDeleteRenderbuffers
+#define glDeleteSync loaded_glDeleteSync
+#define glDeleteTextures loaded_glDeleteTextures
+#define glDeleteVertexArrays loaded_glDeleteVertexArrays
+#define glDepthFunc loaded_glDepthFunc
+#define glDrawArrays loaded_glDrawArrays
+#define glDrawElementsBaseVertex loaded_glDrawElementsBaseVertex
+#define glEnableVertexAttribArray loaded_glEnableVertexAttribArray
+#define glFenceSync loaded_glFenceSync
+#define glFinish loaded_glFinish
+#define glFlushMappedBufferRange loaded_glFlushMappedBufferRange
+#define glFramebufferRenderbuffer loaded_glFramebufferRenderbuffer
+#define glFramebufferTexture2D loaded_glFramebufferTexture2D
+#define glGenBuffers loaded_glGenBuffers
+#define glGenFramebuffers loaded_glGenFramebuffers
+#define glGenQueries loaded_glGenQueries
+#define glGenRenderbuffers loaded_glGenRenderbuffers
+#define glGenTextures loaded_glGenTextures
+#define glGenVertexArrays loaded_glGenVertexArrays
+#define glGetError loaded_glGetError
+#define glGetFramebufferAttachmentParameteriv                                  \
+  loaded_glGetFramebufferAttachmentParameteriv
+#define glGetQueryiv loaded_glGetQueryiv
+#define glGetQueryObjectiv loaded_glGetQueryObjectiv
+#define glGetQueryObjectui64v loaded_glGetQueryObjectui64v
+#define glGetString loaded_glGetString
+#define glMapBufferRange loaded_glMapBufferRange
+#define glPixelStorei loaded_glPixelStorei
+#define glQueryCounter loaded_glQueryCounter
+#define glReadPixels loaded_glReadPixels
+#define glRenderbufferStorage loaded_glRenderbufferStorage
+#define glTexImage2D loaded_glTexImage2D
+#define glTexParameteri loaded_glTexParameteri
+#define glUniform1i loaded_glUniform1i
+#define glUniform4f loaded_glUniform4f
+#define glUniformMatrix4fv loaded_glUniformMatrix4fv
+#define glUnmapBuffer loaded_glUnmapBuffer
+#define glUseProgram loaded_glUseProgram
+#define glVertexAttribPointer loaded_glVertexAttribPointer
+#endif
+
+/**
+ * @brief Loads the GL functions above from the current context; call once
+ * right after InitWindow, before any of them is used.
+ *
+ * @return False when a function is missing; nothing here may be called then.
+ */
+bool loadGlFunctions(void);
+
+#endif
@@ -0,0 +1,62 @@
+#define _POSIX_C_SOURCE 200809L
+/**
+ * @file headless.c
+ * @brief Implements the headless backend (see headless.h).
+ */
+#include "headless.h"
+#include "raylib.h"
+#include <stdlib.h>
+
+#if defined(HEADLESS)
+
+// raylib links GLFW but does not install its header; GLFW 3.4 values of the
+// platform init hint.
+#define GLFW_PLATFORM 0x00050003
+#define GLFW_PLATFORM_NULL 0x00060005
+
+void glfwInitHint(int hint, int value);
+
+bool is_headless = true;
+
+#else
+
+bool is_headless = false;
+
+#endif
+
+/**
+ * @brief Prepares a display-less context; call right before InitWindow.
+ */
+void headlessBeforeInit(void)
+{
+#if defined(HEADLESS)
+  // Init hints survive until glfwInit, which InitWindow calls.
+  glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+  // Any hardware driver would make golden images machine-dependent; an
+  // explicit value in the environment still wins.
+  setenv("GALLIUM_DRIVER", "llvmpipe", 0);
+  setenv("LIBGL_ALWAYS_SOFTWARE", "1", 0);
+  TraceLog(LOG_INFO, "[Headless] GLFW null platform, Mesa llvmpipe");
+#endif
+}
+
+/**
+ * @brief Checks that InitWindow produced a context; call right after it.
+ *
+ * @return False when no context could be created.
+ */
+bool headlessAfterInit(void)
+{
+  if (!is_headless)
+  {
+    return true;
+  }
+  if (!IsWindowReady())
+  {
+    TraceLog(LOG_ERROR,
+             "[Headless] no GL context: raylib must be built with GLFW 3.4 "
+             "and Mesa's off-screen driver (OSMesa) must be installed");
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,35 @@
+/**
+ * @file headless.h
+ * @brief Declares the headless backend: no window and no display, frames are
+ * drawn into an off-screen target by Mesa's llvmpipe rasterizer.
+ *
+ * Enabled at build time with `make HEADLESS=1` (defines HEADLESS). raylib
+ * still creates its context through GLFW; the backend selects GLFW's null
+ * platform before InitWindow, which needs no display server and creates the
+ * GL context with Mesa's off-screen driver.
+ */
+#ifndef HEADLESS_H
+#define HEADLESS_H
+
+#include <stdbool.h>
+
+// True in headless builds: there is no window to present frames to.
+extern bool is_headless;
+
+/**
+ * @brief Prepares a display-less context; call right before InitWindow.
+ *
+ * Selects GLFW's null platform and pins Mesa to llvmpipe, so the same
+ * binary renders the same pixels on every CI machine. Does nothing in
+ * windowed builds.
+ */
+void headlessBeforeInit(void);
+
+/**
+ * @brief Checks that InitWindow produced a context; call right after it.
+ *
+ * @return False when no context could be created.
+ */
+bool headlessAfterInit(void);
+
+#endif
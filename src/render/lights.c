@@ -0,0 +1,241 @@
+/**
+ * @file lights.c
+ * @brief Implements pooled point lights with per-object CPU culling.
+ */
+#include "lights.h"
+#include "raymath.h"
+#include <stdlib.h>
+
+/**
+ * @brief Current intensity of a timed light (linear fade over its TTL).
+ */
+static float timedIntensity(const PointLight *light, double now)
+{
+  float age = (float)(now - light->start);
+  if (light->ttl <= 0.0f || age >= light->ttl)
+    return 0.0f;
+  return light->intensity * (1.0f - age / light->ttl);
+}
+
+static Vector3 colorToVector(Color color)
+{
+  return (Vector3){(float)color.r / 255.0f, (float)color.g / 255.0f,
+                   (float)color.b / 255.0f};
+}
+
+/**
+ * @brief Creates an empty light manager.
+ *
+ * @return Pointer to the manager, or NULL on allocation failure.
+ */
+LightManager *newLightManager(void)
+{
+  return calloc(1, sizeof(LightManager));
+}
+
+/**
+ * @brief Frees the light manager.
+ *
+ * @param lights Pointer to the manager to destroy.
+ */
+void destroyLightManager(LightManager *lights) { free(lights); }
+
+/**
+ * @brief Expires timed lights and flips the per-frame buffers.
+ *
+ * @param lights Pointer to the manager.
+ * @param now Game time of the new frame.
+ */
+void lightsBeginFrame(LightManager *lights, double now)
+{
+  lights->now = now;
+
+  int w = 0;
+  for (int r = 0; r < lights->timed_count; ++r)
+  {
+    if (timedIntensity(&lights->timed[r], now) > 0.0f)
+    {
+      lights->timed[w++] = lights->timed[r];
+    }
+  }
+  lights->timed_count = w;
+
+  // Lights written last frame are read this frame; the other buffer is
+  // cleared for new lights.
+  lights->frame_read ^= 1;
+  lights->frame_count[lights->frame_read ^ 1] = 0;
+}
+
+/**
+ * @brief Adds a light that fades out over its lifetime.
+ *
+ * @param lights Pointer to the manager.
+ * @param position World position.
+ * @param color Light color.
+ * @param intensity Peak intensity.
+ * @param radius Range of the light.
+ * @param ttl Lifetime in seconds.
+ */
+void lightsSpawn(LightManager *lights, Vector3 position, Color color,
+                 float intensity, float radius, float ttl)
+{
+  if (!lights)
+    return;
+
+  int slot = lights->timed_count;
+  if (slot == LIGHTS_TIMED_MAX)
+  {
+    // Pool full: replace the light that currently contributes least.
+    slot = 0;
+    float weakest = timedIntensity(&lights->timed[0], lights->now);
+    for (int i = 1; i < LIGHTS_TIMED_MAX; ++i)
+    {
+      float value = timedIntensity(&lights->timed[i], lights->now);
+      if (value < weakest)
+      {
+        weakest = value;
+        slot = i;
+      }
+    }
+  }
+  else
+  {
+    lights->timed_count += 1;
+  }
+
+  lights->timed[slot] = (PointLight){.position = position,
+                                     .color = colorToVector(color),
+                                     .intensity = intensity,
+                                     .radius = radius,
+                                     .start = lights->now,
+                                     .ttl = ttl};
+}
+
+/**
+ * @brief Adds a light that lives for one frame (moving sources).
+ *
+ * @param lights Pointer to the manager.
+ * @param position World position.
+ * @param color Light color.
+ * @param intensity Intensity.
+ * @param radius Range of the light.
+ */
+void lightsAddFrameLight(LightManager *lights, Vector3 position, Color color,
+                         float intensity, float radius)
+{
+  if (!lights)
+    return;
+
+  int write = lights->frame_read ^ 1;
+  if (lights->frame_count[write] == LIGHTS_FRAME_MAX)
+    return;
+
+  lights->frame[write][lights->frame_count[write]++] =
+      (PointLight){.position = position,
+                   .color = colorToVector(color),
+                   .intensity = intensity,
+                   .radius = radius};
+}
+
+/**
+ * @brief Keeps the LIGHTS_PER_OBJECT best candidates, sorted by score.
+ */
+static void rankLight(const PointLight *light, float intensity, Vector3 center,
+                      float radius, const PointLight **best, float *weight,
+                      float *score, int *count)
+{
+  if (intensity <= 0.0f)
+    return;
+
+  float reach = light->radius + radius;
+  float dist = Vector3Distance(light->position, center);
+  if (dist >= reach)
+    return;
+
+  float falloff = 1.0f - dist / reach;
+  float value = intensity * falloff * falloff;
+
+  int i = *count < LIGHTS_PER_OBJECT ? (*count)++ : LIGHTS_PER_OBJECT;
+  if (i == LIGHTS_PER_OBJECT)
+  {
+    if (value <= score[LIGHTS_PER_OBJECT - 1])
+      return;
+    i = LIGHTS_PER_OBJECT - 1;
+  }
+  while (i > 0 && score[i - 1] < value)
+  {
+    best[i] = best[i - 1];
+    weight[i] = weight[i - 1];
+    score[i] = score[i - 1];
+    --i;
+  }
+  best[i] = light;
+  weight[i] = intensity;
+  score[i] = value;
+}
+
+/**
+ * @brief Picks the lights that affect an object most.
+ *
+ * @param lights Pointer to the manager (NULL selects nothing).
+ * @param center Object center.
+ * @param radius Object bounding radius.
+ * @return The selection, brightest first.
+ */
+LightSelection lightsSelectForObject(LightManager *lights, Vector3 center,
+                                     float radius)
+{
+  LightSelection selection = {0};
+  if (!lights)
+    return selection;
+
+  const PointLight *best[LIGHTS_PER_OBJECT] = {0};
+  float weight[LIGHTS_PER_OBJECT] = {0};
+  float score[LIGHTS_PER_OBJECT] = {0};
+  int count = 0;
+
+  for (int i = 0; i < lights->timed_count; ++i)
+  {
+    const PointLight *light = &lights->timed[i];
+    rankLight(light, timedIntensity(light, lights->now), center, radius, best,
+              weight, score, &count);
+  }
+  int read = lights->frame_read;
+  for (int i = 0; i < lights->frame_count[read]; ++i)
+  {
+    const PointLight *light = &lights->frame[read][i];
+    rankLight(light, light->intensity, center, radius, best, weight, score,
+              &count);
+  }
+
+  selection.count = count;
+  for (int i = 0; i < count; ++i)
+  {
+    selection.position[i * 4 + 0] = best[i]->position.x;
+    selection.position[i * 4 + 1] = best[i]->position.y;
+    selection.position[i * 4 + 2] = best[i]->position.z;
+    selection.position[i * 4 + 3] = best[i]->radius;
+    selection.color[i * 4 + 0] = best[i]->color.x * weight[i];
+    selection.color[i * 4 + 1] = best[i]->color.y * weight[i];
+    selection.color[i * 4 + 2] = best[i]->color.z * weight[i];
+    selection.color[i * 4 + 3] = 1.0f;
+  }
+  return selection;
+}
+
+/**
+ * @brief Uploads a selection to a variant compiled for its light count.
+ *
+ * @param selection Lights to upload.
+ * @param variant Variant with SHADER_POINT_LIGHTS(selection->count).
+ */
+void lightsUpload(const LightSelection *selection,
+                  const ShaderVariant *variant)
+{
+  if (selection->count == 0 || variant->point_position_loc < 0)
+    return;
+  SetShaderValueV(variant->shader, variant->point_position_loc,
+                  selection->position, SHADER_UNIFORM_VEC4, selection->count);
+  SetShaderValueV(variant->shader, variant->point_color_loc, selection->color,
+                  SHADER_UNIFORM_VEC4, selection->count);
+}
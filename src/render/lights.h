@@ -0,0 +1,141 @@
+/**
+ * @file lights.h
+ * @brief Declares the dynamic point-light manager.
+ *
+ * Explosions and bullets register short-lived point lights in fixed pools.
+ * Before a ship is drawn, the few lights that affect it most are picked on
+ * the CPU and uploaded to a lighting shader variant compiled for exactly
+ * that many lights, so per-pixel cost is bounded by LIGHTS_PER_OBJECT
+ * however many lights exist.
+ */
+#ifndef LIGHTS_H
+#define LIGHTS_H
+
+#include "raylib.h"
+#include "shaders.h"
+#include <stdbool.h>
+
+/// Maximum lights uploaded per drawn object.
+#define LIGHTS_PER_OBJECT 4
+
+/// Capacity of the timed light pool (explosions).
+#define LIGHTS_TIMED_MAX 64
+
+/// Capacity of the per-frame light pool (bullets, burning debris).
+#define LIGHTS_FRAME_MAX 256
+
+/**
+ * @brief A point light with linear-squared falloff to zero at its radius.
+ */
+typedef struct PointLight
+{
+  Vector3 position; /// World position.
+  Vector3 color;    /// Linear RGB, 0..1.
+  float intensity;  /// Peak intensity.
+  float radius;     /// Distance where the light reaches zero.
+  double start;     /// Spawn time (timed lights).
+  float ttl;        /// Lifetime in seconds (timed lights).
+} PointLight;
+
+/**
+ * @brief Lights picked for one object, packed for upload.
+ */
+typedef struct LightSelection
+{
+  int count;                              /// Number of lights picked.
+  float position[LIGHTS_PER_OBJECT * 4];  /// xyz position, w radius.
+  float color[LIGHTS_PER_OBJECT * 4];     /// rgb color * intensity.
+} LightSelection;
+
+/**
+ * @brief Pools of active lights.
+ *
+ * Per-frame lights are double-buffered: lights added while frame N is drawn
+ * light the scene of frame N+1, so the result does not depend on the order
+ * objects are drawn in.
+ */
+typedef struct LightManager
+{
+  PointLight timed[LIGHTS_TIMED_MAX];    /// Lights fading out over a TTL.
+  int timed_count;                       /// Active timed lights.
+  PointLight frame[2][LIGHTS_FRAME_MAX]; /// Per-frame lights (read/write).
+  int frame_count[2];                    /// Lights in each buffer.
+  int frame_read;                        /// Buffer used for shading.
+  double now;                            /// Time of the current frame.
+} LightManager;
+
+/**
+ * @brief Creates an empty light manager.
+ *
+ * @return Pointer to the manager, or NULL on allocation failure.
+ */
+LightManager *newLightManager(void);
+
+/**
+ * @brief Frees the light manager.
+ *
+ * @param lights Pointer to the manager to destroy.
+ */
+void destroyLightManager(LightManager *lights);
+
+/**
+ * @brief Expires timed lights and flips the per-frame buffers.
+ *
+ * @param lights Pointer to the manager.
+ * @param now Game time of the new frame.
+ */
+void lightsBeginFrame(LightManager *lights, double now);
+
+/**
+ * @brief Adds a light that fades out over its lifetime.
+ *
+ * When the pool is full the weakest remaining light is replaced.
+ *
+ * @param lights Pointer to the manager.
+ * @param position World position.
+ * @param color Light color.
+ * @param intensity Peak intensity.
+ * @param radius Range of the light.
+ * @param ttl Lifetime in seconds.
+ */
+void lightsSpawn(LightManager *lights, Vector3 position, Color color,
+                 float intensity, float radius, float ttl);
+
+/**
+ * @brief Adds a light that lives for one frame (moving sources).
+ *
+ * Silently ignored when the per-frame pool is full.
+ *
+ * @param lights Pointer to the manager.
+ * @param position World position.
+ * @param color Light color.
+ * @param intensity Intensity.
+ * @param radius Range of the light.
+ */
+void lightsAddFrameLight(LightManager *lights, Vector3 position, Color color,
+                         float intensity, float radius);
+
+/**
+ * @brief Picks the lights that affect an object most.
+ *
+ * Lights are ranked by intensity attenuated at the object's distance; the
+ * best LIGHTS_PER_OBJECT are kept.
+ *
+ * @param lights Pointer to the manager (NULL selects nothing).
+ * @param center Object center.
+ * @param radius Object bounding radius.
+ * @return The selection, brightest first.
+ */
+LightSelection lightsSelectForObject(LightManager *lights, Vector3 center,
+                                     float radius);
+
+/**
+ * @brief Uploads a selection to a variant compiled for its light count.
+ *
+ * @param selection Lights to upload.
+ * @param variant Variant with SHADER_POINT_LIGHTS(selection->count).
+ */
+void lightsUpload(const LightSelection *selection,
+                  const ShaderVariant *variant);
+
+#endif
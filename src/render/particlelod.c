@@ -0,0 +1,167 @@
+/**
+ * @file particlelod.c
+ * @brief Implements screen-size based particle LOD.
+ */
+#include "particlelod.h"
+#include "../utils/profiler.h"
+#include "../utils/resolution.h"
+#include "raylib.h"
+#include "raymath.h"
+#include <math.h>
+#include <string.h>
+
+// Global flag: LOD is on unless --no-particle-lod is given.
+bool is_particle_lod_enabled = true;
+
+/**
+ * @brief Parses command-line arguments to check for --no-particle-lod.
+ *
+ * @param argc The count of command-line arguments.
+ * @param argv The array of command-line argument strings.
+ */
+void checkParticleLodFlag(int argc, char *argv[])
+{
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--no-particle-lod") == 0)
+    {
+      is_particle_lod_enabled = false;
+      break;
+    }
+  }
+}
+
+/**
+ * @brief Captures the camera for the particles of one pass.
+ *
+ * @param camera Active camera.
+ * @return LOD parameters for the pass.
+ */
+ParticleLod particleLodBegin(const Camera3D *camera)
+{
+  ParticleLod lod = {0};
+  lod.eye = camera->position;
+  lod.focal =
+      (float)render_height / (2.0f * tanf(camera->fovy * 0.5f * DEG2RAD));
+  lod.enabled = is_particle_lod_enabled;
+  return lod;
+}
+
+/**
+ * @brief Returns the projected side length of a particle, in pixels.
+ *
+ * @param lod LOD parameters.
+ * @param position Particle center.
+ * @param size Particle side length in world units.
+ * @return Side length on screen in pixels.
+ */
+float particleLodPixels(const ParticleLod *lod, Vector3 position, float size)
+{
+  float dist = fmaxf(Vector3Distance(lod->eye, position), 0.001f);
+  return size * lod->focal / dist;
+}
+
+/**
+ * @brief Returns how much of its spawn rate an emitter keeps at its
+ * distance, in [PARTICLE_LOD_MIN_RATE, 1].
+ *
+ * @param lod LOD parameters.
+ * @param origin Emitter position.
+ * @param reference_size Typical particle size of the emitter.
+ * @return Spawn rate scale; 1 when LOD is off.
+ */
+float particleLodSpawnScale(const ParticleLod *lod, Vector3 origin,
+                            float reference_size)
+{
+  if (!lod->enabled)
+  {
+    return 1.0f;
+  }
+  float pixels = particleLodPixels(lod, origin, reference_size);
+  return Clamp(pixels / PARTICLE_LOD_FULL_RATE_PIXELS, PARTICLE_LOD_MIN_RATE,
+               1.0f);
+}
+
+/**
+ * @brief Gathers one tiny particle.
+ *
+ * @param merge Accumulator.
+ * @param position Particle center.
+ * @param size Particle side length.
+ * @param color Particle color.
+ * @return True when PARTICLE_LOD_MERGE_GROUP particles are gathered and the
+ * merged quad should be emitted.
+ */
+static bool particleMergeAdd(ParticleMerge *merge, Vector3 position,
+                             float size, Color color)
+{
+  merge->position = Vector3Add(merge->position, position);
+  merge->area += size * size;
+  merge->r += color.r;
+  merge->g += color.g;
+  merge->b += color.b;
+  merge->a += color.a;
+  merge->count++;
+  return merge->count == PARTICLE_LOD_MERGE_GROUP;
+}
+
+/**
+ * @brief Classifies one particle by projected size.
+ *
+ * Sub-pixel particles are dropped, tiny ones are gathered into `merge`.
+ * Skipped and merged particles are added to the profiler counters. When
+ * PARTICLE_LOD_MERGED is returned, fetch the quad with particleMergeTake;
+ * after the last particle, take whatever is left in `merge` as well.
+ *
+ * @param lod LOD parameters.
+ * @param merge Accumulator of the current emitter.
+ * @param position Particle center.
+ * @param size Particle side length.
+ * @param color Particle color.
+ * @return The action for this particle.
+ */
+ParticleLodResult particleLodFilter(const ParticleLod *lod,
+                                    ParticleMerge *merge, Vector3 position,
+                                    float size, Color color)
+{
+  if (!lod->enabled)
+  {
+    return PARTICLE_LOD_DRAW;
+  }
+  float pixels = particleLodPixels(lod, position, size);
+  if (pixels >= PARTICLE_LOD_MERGE_PIXELS)
+  {
+    return PARTICLE_LOD_DRAW;
+  }
+  if (pixels < PARTICLE_LOD_CULL_PIXELS)
+  {
+    profilerCount(PROFILE_PARTICLES_CULLED, 1.0);
+    return PARTICLE_LOD_SKIP;
+  }
+  profilerCount(PROFILE_PARTICLES_MERGED, 1.0);
+  return particleMergeAdd(merge, position, size, color) ? PARTICLE_LOD_MERGED
+                                                        : PARTICLE_LOD_SKIP;
+}
+
+/**
+ * @brief Produces the merged quad and resets the accumulator.
+ *
+ * The quad sits at the average position, covers the summed area of the
+ * gathered particles and has their average color.
+ *
+ * @param merge Accumulator; must hold at least one particle.
+ * @param position Merged center (out).
+ * @param size Merged side length (out).
+ * @param color Merged color (out).
+ */
+void particleMergeTake(ParticleMerge *merge, Vector3 *position, float *size,
+                       Color *color)
+{
+  float n = (float)merge->count;
+  *position = Vector3Scale(merge->position, 1.0f / n);
+  *size = sqrtf(merge->area);
+  *color = (Color){(unsigned char)(merge->r / n), (unsigned char)(merge->g / n),
+                   (unsigned char)(merge->b / n),
+                   (unsigned char)(merge->a / n)};
+  memset(merge, 0, sizeof(*merge));
+}
@@ -0,0 +1,135 @@
+/**
+ * @file particlelod.h
+ * @brief Declares screen-size based particle LOD: particles are measured in
+ * projected pixels, sub-pixel ones are skipped, tiny ones are merged into
+ * fewer larger quads and distant emitters spawn fewer particles.
+ */
+#ifndef PARTICLELOD_H
+#define PARTICLELOD_H
+
+#include "raylib.h"
+#include <stdbool.h>
+
+/// Particles projected smaller than this (pixels) are not drawn.
+#define PARTICLE_LOD_CULL_PIXELS 1.0f
+
+/// Particles projected smaller than this (pixels) are merged in groups.
+#define PARTICLE_LOD_MERGE_PIXELS 3.0f
+
+/// Tiny particles folded into one merged quad.
+#define PARTICLE_LOD_MERGE_GROUP 4
+
+/// Projected size (pixels) of an emitter's reference particle at which the
+/// emitter spawns at its full rate; smaller means proportionally fewer.
+#define PARTICLE_LOD_FULL_RATE_PIXELS 6.0f
+
+/// Lowest spawn rate scale for distant emitters.
+#define PARTICLE_LOD_MIN_RATE 0.25f
+
+// Global flag: LOD is on unless --no-particle-lod is given. Spawn counts
+// depend on it, so it is not toggled at runtime (replays would diverge).
+extern bool is_particle_lod_enabled;
+
+/**
+ * @brief Parses command-line arguments to check for --no-particle-lod.
+ *
+ * @param argc The count of command-line arguments.
+ * @param argv The array of command-line argument strings.
+ */
+void checkParticleLodFlag(int argc, char *argv[]);
+
+/**
+ * @brief Camera data needed to project particle sizes.
+ */
+typedef struct ParticleLod
+{
+  Vector3 eye;   /// Camera position.
+  float focal;   /// Pixels covered by one world unit at distance one.
+  bool enabled;  /// Copy of is_particle_lod_enabled.
+} ParticleLod;
+
+/**
+ * @brief Accumulates tiny particles into one merged quad.
+ */
+typedef struct ParticleMerge
+{
+  Vector3 position; /// Sum of positions.
+  float area;       /// Sum of squared sizes.
+  float r, g, b, a; /// Sums of color channels.
+  int count;        /// Particles gathered.
+} ParticleMerge;
+
+/**
+ * @brief Captures the camera for the particles of one pass.
+ *
+ * @param camera Active camera.
+ * @return LOD parameters for the pass.
+ */
+ParticleLod particleLodBegin(const Camera3D *camera);
+
+/**
+ * @brief Returns the projected side length of a particle, in pixels.
+ *
+ * @param lod LOD parameters.
+ * @param position Particle center.
+ * @param size Particle side length in world units.
+ * @return Side length on screen in pixels.
+ */
+float particleLodPixels(const ParticleLod *lod, Vector3 position, float size);
+
+/**
+ * @brief Returns how much of its spawn rate an emitter keeps at its
+ * distance, in [PARTICLE_LOD_MIN_RATE, 1].
+ *
+ * @param lod LOD parameters.
+ * @param origin Emitter position.
+ * @param reference_size Typical particle size of the emitter.
+ * @return Spawn rate scale; 1 when LOD is off.
+ */
+float particleLodSpawnScale(const ParticleLod *lod, Vector3 origin,
+                            float reference_size);
+
+/**
+ * @brief What to do with a particle after the LOD test.
+ */
+typedef enum ParticleLodResult
+{
+  PARTICLE_LOD_DRAW = 0, /// Large enough: draw it as is.
+  PARTICLE_LOD_SKIP,     /// Sub-pixel or gathered for merging: draw nothing.
+  PARTICLE_LOD_MERGED,   /// Gathered and the group is full: draw the merge.
+} ParticleLodResult;
+
+/**
+ * @brief Classifies one particle by projected size.
+ *
+ * Sub-pixel particles are dropped, tiny ones are gathered into `merge`.
+ * Skipped and merged particles are added to the profiler counters. When
+ * PARTICLE_LOD_MERGED is returned, fetch the quad with particleMergeTake;
+ * after the last particle, take whatever is left in `merge` as well.
+ *
+ * @param lod LOD parameters.
+ * @param merge Accumulator of the current emitter.
+ * @param position Particle center.
+ * @param size Particle side length.
+ * @param color Particle color.
+ * @return The action for this particle.
+ */
+ParticleLodResult particleLodFilter(const ParticleLod *lod,
+                                    ParticleMerge *merge, Vector3 position,
+                                    float size, Color color);
+
+/**
+ * @brief Produces the merged quad and resets the accumulator.
+ *
+ * The quad sits at the average position, covers the summed area of the
+ * gathered particles and has their average color.
+ *
+ * @param merge Accumulator; must hold at least one particle.
+ * @param position Merged center (out).
+ * @param size Merged side length (out).
+ * @param color Merged color (out).
+ */
+void particleMergeTake(ParticleMerge *merge, Vector3 *position, float *size,
+                       Color *color);
+
+#endif
@@ -0,0 +1,116 @@
+/**
+ * @file quality.c
+ * @brief Implements the rendering quality tiers.
+ */
+#include "quality.h"
+#include "bloom.h"
+#include "gl.h"
+#include "raylib.h"
+#include <stddef.h>
+#include <string.h>
+
+// Tier given by --quality; QUALITY_AUTO until resolved.
+QualityTier quality_tier = QUALITY_AUTO;
+
+/// Names accepted by --quality, indexed by QualityTier.
+static const char *const QUALITY_NAMES[] = {"low", "medium", "high", "auto"};
+
+/// Substrings of GL_RENDERER identifying software rasterizers.
+static const char *const SOFTWARE_RENDERERS[] = {
+    "llvmpipe", "softpipe", "SwiftShader", "Software Rasterizer",
+    "Basic Render"};
+
+/**
+ * @brief Parses command-line arguments for --quality <low|medium|high|auto>.
+ *
+ * @param argc The count of command-line arguments.
+ * @param argv The array of command-line argument strings.
+ */
+void checkQualityFlag(int argc, char *argv[])
+{
+  for (int i = 1; i < argc - 1; i++)
+  {
+    if (strcmp(argv[i], "--quality") != 0)
+    {
+      continue;
+    }
+    for (int tier = QUALITY_LOW; tier <= QUALITY_AUTO; tier++)
+    {
+      if (strcmp(argv[i + 1], QUALITY_NAMES[tier]) == 0)
+      {
+        quality_tier = (QualityTier)tier;
+        return;
+      }
+    }
+    TraceLog(LOG_WARNING,
+             "Invalid quality '%s', expected low, medium, high or auto.",
+             argv[i + 1]);
+    return;
+  }
+}
+
+/**
+ * @brief Checks whether the current GL context is a software rasterizer.
+ *
+ * @return True when GL_RENDERER names a known software implementation.
+ */
+static bool isSoftwareRenderer(void)
+{
+  const char *renderer = (const char *)glGetString(GL_RENDERER);
+  if (!renderer)
+  {
+    return false;
+  }
+  size_t count = sizeof(SOFTWARE_RENDERERS) / sizeof(SOFTWARE_RENDERERS[0]);
+  for (size_t i = 0; i < count; i++)
+  {
+    if (strstr(renderer, SOFTWARE_RENDERERS[i]))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Resolves QUALITY_AUTO and applies the tier's settings.
+ *
+ * Software rasterizers (llvmpipe, softpipe, SwiftShader, ...) get the low
+ * tier, anything else the high one. Must be called after InitWindow.
+ */
+void resolveQualityTier(void)
+{
+  if (quality_tier == QUALITY_AUTO)
+  {
+    quality_tier = isSoftwareRenderer() ? QUALITY_LOW : QUALITY_HIGH;
+  }
+  if (quality_tier < QUALITY_HIGH)
+  {
+    is_bloom_enabled = false;
+  }
+  const char *renderer = (const char *)glGetString(GL_RENDERER);
+  TraceLog(LOG_INFO, "[Quality] %s tier on %s", qualityTierName(quality_tier),
+           renderer ? renderer : "unknown renderer");
+}
+
+/**
+ * @brief Tells whether enemy ships use the lighting baked into their meshes.
+ *
+ * @return True at the low tier.
+ */
+bool qualityBakesShipLighting(void)
+{
+  return quality_tier == QUALITY_LOW;
+}
+
+/**
+ * @brief Returns the lowercase name of a tier, as accepted by --quality.
+ *
+ * @param tier Tier to name.
+ * @return Static string.
+ */
+const char *qualityTierName(QualityTier tier)
+{
+  return (tier >= QUALITY_LOW && tier <= QUALITY_AUTO) ? QUALITY_NAMES[tier]
+                                                        : "unknown";
+}
@@ -0,0 +1,56 @@
+/**
+ * @file quality.h
+ * @brief Declares the rendering quality tiers and their selection, either
+ * from the command line or from the GL renderer on start-up.
+ */
+#ifndef QUALITY_H
+#define QUALITY_H
+
+#include <stdbool.h>
+
+/**
+ * @brief Rendering quality tiers, cheapest first.
+ */
+typedef enum QualityTier
+{
+  QUALITY_LOW = 0,    /// Baked enemy lighting, no bloom.
+  QUALITY_MEDIUM = 1, /// Per-pixel lighting, no bloom.
+  QUALITY_HIGH = 2,   /// Everything enabled.
+  QUALITY_AUTO = 3,   /// Pick from the GL renderer once the window exists.
+} QualityTier;
+
+// Tier given by --quality; QUALITY_AUTO until resolved.
+extern QualityTier quality_tier;
+
+/**
+ * @brief Parses command-line arguments for --quality <low|medium|high|auto>.
+ *
+ * @param argc The count of command-line arguments.
+ * @param argv The array of command-line argument strings.
+ */
+void checkQualityFlag(int argc, char *argv[]);
+
+/**
+ * @brief Resolves QUALITY_AUTO and applies the tier's settings.
+ *
+ * Software rasterizers (llvmpipe, softpipe, SwiftShader, ...) get the low
+ * tier, anything else the high one. Must be called after InitWindow.
+ */
+void resolveQualityTier(void);
+
+/**
+ * @brief Tells whether enemy ships use the lighting baked into their meshes.
+ *
+ * @return True at the low tier.
+ */
+bool qualityBakesShipLighting(void);
+
+/**
+ * @brief Returns the lowercase name of a tier, as accepted by --quality.
+ *
+ * @param tier Tier to name.
+ * @return Static string.
+ */
+const char *qualityTierName(QualityTier tier);
+
+#endif
@@ -0,0 +1,218 @@
+/**
+ * @file shaders.c
+ * @brief Implements compile-time shader specialisation with a variant cache.
+ */
+#include "shaders.h"
+#include "rlgl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Builds the #define block for a feature key.
+ */
+static void variantDefines(unsigned key, char *out, size_t size)
+{
+  snprintf(out, size, "%s%s%s#define N_POINT_LIGHTS %u\n",
+           (key & SHADER_HIT_TINT) ? "#define HIT_TINT\n" : "",
+           (key & SHADER_UNLIT) ? "#define UNLIT\n" : "",
+           (key & SHADER_INSTANCED) ? "#define INSTANCED\n" : "",
+           SHADER_POINT_LIGHTS_OF(key));
+}
+
+/**
+ * @brief Inserts the defines right after the #version line.
+ *
+ * GLSL requires #version to come first, so the defines cannot simply be
+ * prepended. The result is heap-allocated.
+ */
+static char *injectDefines(const char *source, const char *defines)
+{
+  const char *version = strstr(source, "#version");
+  const char *split = source;
+  if (version)
+  {
+    const char *eol = strchr(version, '\n');
+    split = eol ? eol + 1 : version + strlen(version);
+  }
+
+  size_t head = (size_t)(split - source);
+  size_t len = strlen(source) + strlen(defines) + 2;
+  char *result = malloc(len);
+  if (!result)
+    return NULL;
+  memcpy(result, source, head);
+  result[head] = '\0';
+  if (version && split == version + strlen(version))
+    strcat(result, "\n");
+  strcat(result, defines);
+  strcat(result, split);
+  return result;
+}
+
+/**
+ * @brief Applies one preset to one variant.
+ */
+static void applyPreset(const ShaderVariant *variant,
+                        const ShaderPreset *preset)
+{
+  int loc = GetShaderLocation(variant->shader, preset->name);
+  if (loc >= 0)
+    SetShaderValue(variant->shader, loc, preset->value, preset->type);
+}
+
+/**
+ * @brief Compiles one variant into the next free slot.
+ *
+ * @return Pointer to the new variant, or NULL on failure.
+ */
+static ShaderVariant *compileVariant(ShaderVariantCache *cache, unsigned key)
+{
+  if (cache->count == SHADER_VARIANTS_MAX)
+  {
+    TraceLog(LOG_WARNING, "[shaders] Variant cache full, key 0x%x", key);
+    return NULL;
+  }
+
+  char defines[160];
+  variantDefines(key, defines, sizeof(defines));
+  char *vs = injectDefines(cache->vs_source, defines);
+  char *fs = injectDefines(cache->fs_source, defines);
+  Shader shader = {0};
+  if (vs && fs)
+    shader = LoadShaderFromMemory(vs, fs);
+  free(vs);
+  free(fs);
+
+  // raylib falls back to its default shader when compilation fails.
+  if (shader.id == 0 || shader.id == rlGetShaderIdDefault())
+  {
+    TraceLog(LOG_WARNING, "[shaders] Failed to compile variant 0x%x", key);
+    return NULL;
+  }
+  if (key & SHADER_INSTANCED)
+  {
+    shader.locs[SHADER_LOC_MATRIX_MODEL] =
+        GetShaderLocationAttrib(shader, "instanceTransform");
+  }
+
+  ShaderVariant *variant = &cache->variants[cache->count++];
+  variant->key = key;
+  variant->shader = shader;
+  variant->point_position_loc =
+      GetShaderLocation(shader, "pointLightPosition");
+  variant->point_color_loc = GetShaderLocation(shader, "pointLightColor");
+  for (int i = 0; i < cache->preset_count; i++)
+  {
+    applyPreset(variant, &cache->presets[i]);
+  }
+  TraceLog(LOG_INFO, "[shaders] Compiled variant 0x%x (%d cached)", key,
+           cache->count);
+  return variant;
+}
+
+/**
+ * @brief Loads shader sources for later specialisation.
+ *
+ * @param vs_path Vertex shader file.
+ * @param fs_path Fragment shader file.
+ * @return Pointer to the cache, or NULL on failure.
+ */
+ShaderVariantCache *newShaderVariantCache(const char *vs_path,
+                                          const char *fs_path)
+{
+  ShaderVariantCache *cache = calloc(1, sizeof(ShaderVariantCache));
+  if (!cache)
+  {
+    return NULL;
+  }
+  cache->vs_source = LoadFileText(vs_path);
+  cache->fs_source = LoadFileText(fs_path);
+  if (!cache->vs_source || !cache->fs_source || !compileVariant(cache, 0))
+  {
+    destroyShaderVariantCache(cache);
+    return NULL;
+  }
+  return cache;
+}
+
+/**
+ * @brief Returns the variant for a feature key, compiling it on first use.
+ *
+ * @param cache Pointer to the cache.
+ * @param key Bitwise OR of SHADER_* features.
+ * @return Pointer to the variant (owned by the cache).
+ */
+const ShaderVariant *getShaderVariant(ShaderVariantCache *cache, unsigned key)
+{
+  // A handful of variants: a linear scan beats hashing here.
+  for (int i = 0; i < cache->count; i++)
+  {
+    if (cache->variants[i].key == key)
+      return &cache->variants[i];
+  }
+  ShaderVariant *variant = compileVariant(cache, key);
+  return variant ? variant : &cache->variants[0];
+}
+
+/**
+ * @brief Sets a uniform on every compiled and future variant.
+ *
+ * @param cache Pointer to the cache.
+ * @param name Uniform name.
+ * @param value Pointer to the value (up to four floats).
+ * @param type SHADER_UNIFORM_FLOAT .. SHADER_UNIFORM_VEC4.
+ */
+void setShaderVariantsValue(ShaderVariantCache *cache, const char *name,
+                            const void *value, int type)
+{
+  ShaderPreset *preset = NULL;
+  for (int i = 0; i < cache->preset_count; i++)
+  {
+    if (strcmp(cache->presets[i].name, name) == 0)
+      preset = &cache->presets[i];
+  }
+  if (!preset)
+  {
+    if (cache->preset_count == SHADER_PRESETS_MAX)
+    {
+      TraceLog(LOG_WARNING, "[shaders] Too many shared uniforms (%s)", name);
+      return;
+    }
+    preset = &cache->presets[cache->preset_count++];
+    snprintf(preset->name, sizeof(preset->name), "%s", name);
+  }
+
+  int components = type == SHADER_UNIFORM_VEC4   ? 4
+                   : type == SHADER_UNIFORM_VEC3 ? 3
+                   : type == SHADER_UNIFORM_VEC2 ? 2
+                                                 : 1;
+  memset(preset->value, 0, sizeof(preset->value));
+  memcpy(preset->value, value, sizeof(float) * (size_t)components);
+  preset->type = type;
+
+  for (int i = 0; i < cache->count; i++)
+  {
+    applyPreset(&cache->variants[i], preset);
+  }
+}
+
+/**
+ * @brief Unloads every variant and frees the sources.
+ *
+ * @param cache Pointer to the cache to destroy.
+ */
+void destroyShaderVariantCache(ShaderVariantCache *cache)
+{
+  if (!cache)
+    return;
+  for (int i = 0; i < cache->count; i++)
+  {
+    UnloadShader(cache->variants[i].shader);
+  }
+  if (cache->vs_source)
+    UnloadFileText(cache->vs_source);
+  if (cache->fs_source)
+    UnloadFileText(cache->fs_source);
+  free(cache);
+}
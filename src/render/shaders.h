@@ -0,0 +1,111 @@
+/**
+ * @file shaders.h
+ * @brief Declares the shader variant cache.
+ *
+ * One shader source is specialised at compile time by injecting #define
+ * lines after its #version line. Each feature key compiles once, on first
+ * use, and draws pick the variant matching exactly the features they need
+ * instead of paying for runtime branches in a single uber-shader.
+ */
+#ifndef SHADERS_H
+#define SHADERS_H
+
+#include "raylib.h"
+#include <stdbool.h>
+
+/// Multiply by the draw tint (colDiffuse), used for the red hit flash.
+#define SHADER_HIT_TINT (1u << 0)
+
+/// Texture only, no lighting.
+#define SHADER_UNLIT (1u << 1)
+
+/// Per-instance transforms (DrawMeshInstanced).
+#define SHADER_INSTANCED (1u << 2)
+
+/// Number of point lights compiled in (0..15), stored in bits 8..11.
+#define SHADER_POINT_LIGHTS(n) ((unsigned)(n) << 8)
+#define SHADER_POINT_LIGHTS_OF(key) (((key) >> 8) & 0xFu)
+
+/// Maximum number of compiled variants kept in a cache.
+#define SHADER_VARIANTS_MAX 32
+
+/// Maximum number of uniform values replayed on every variant.
+#define SHADER_PRESETS_MAX 8
+
+/**
+ * @brief A compiled permutation and the locations draws need.
+ */
+typedef struct ShaderVariant
+{
+  unsigned key;             /// Feature key it was compiled with.
+  Shader shader;            /// Compiled program.
+  int point_position_loc;   /// "pointLightPosition" uniform (or -1).
+  int point_color_loc;      /// "pointLightColor" uniform (or -1).
+} ShaderVariant;
+
+/**
+ * @brief A uniform value shared by every variant (e.g. ambient light).
+ */
+typedef struct ShaderPreset
+{
+  char name[32];  /// Uniform name.
+  float value[4]; /// Value (up to vec4).
+  int type;       /// SHADER_UNIFORM_* type.
+} ShaderPreset;
+
+/**
+ * @brief Sources of one shader and the variants compiled from it.
+ */
+typedef struct ShaderVariantCache
+{
+  char *vs_source;                             /// Vertex shader source.
+  char *fs_source;                             /// Fragment shader source.
+  ShaderVariant variants[SHADER_VARIANTS_MAX]; /// Compiled variants.
+  int count;                                   /// Number of variants.
+  ShaderPreset presets[SHADER_PRESETS_MAX];    /// Shared uniform values.
+  int preset_count;                            /// Number of presets.
+} ShaderVariantCache;
+
+/**
+ * @brief Loads shader sources for later specialisation.
+ *
+ * The base variant (key 0) is compiled immediately so a broken source is
+ * reported at startup.
+ *
+ * @param vs_path Vertex shader file.
+ * @param fs_path Fragment shader file.
+ * @return Pointer to the cache, or NULL on failure.
+ */
+ShaderVariantCache *newShaderVariantCache(const char *vs_path,
+                                          const char *fs_path);
+
+/**
+ * @brief Returns the variant for a feature key, compiling it on first use.
+ *
+ * Falls back to the base variant if the cache is full or compilation fails.
+ *
+ * @param cache Pointer to the cache.
+ * @param key Bitwise OR of SHADER_* features.
+ * @return Pointer to the variant (owned by the cache).
+ */
+const ShaderVariant *getShaderVariant(ShaderVariantCache *cache, unsigned key);
+
+/**
+ * @brief Sets a uniform on every compiled and future variant.
+ *
+ * @param cache Pointer to the cache.
+ * @param name Uniform name.
+ * @param value Pointer to the value (up to four floats).
+ * @param type SHADER_UNIFORM_FLOAT .. SHADER_UNIFORM_VEC4.
+ */
+void setShaderVariantsValue(ShaderVariantCache *cache, const char *name,
+                            const void *value, int type);
+
+/**
+ * @brief Unloads every variant and frees the sources.
+ *
+ * @param cache Pointer to the cache to destroy.
+ */
+void destroyShaderVariantCache(ShaderVariantCache *cache);
+
+#endif
@@ -0,0 +1,321 @@
+/**
+ * @file stream.c
+ * @brief Implements the streaming vertex ring (see stream.h).
+ */
+#include "stream.h"
+#include "../utils/profiler.h"
+#include "gl.h"
+#include "raylib.h"
+#include "rlgl.h"
+#include <raymath.h>
+#include <string.h>
+
+/// Vertices of one region; regions start on whole vertices so base vertex
+/// offsets stay exact.
+#define STREAM_REGION_VERTICES \
+  ((int)(STREAM_REGION_BYTES / sizeof(StreamVertex)))
+
+/// Bytes of one region, rounded down to whole vertices.
+#define STREAM_REGION_SIZE \
+  ((GLsizeiptr)STREAM_REGION_VERTICES * (GLsizeiptr)sizeof(StreamVertex))
+
+/// Quads of one region; the shared index buffer covers that many.
+#define STREAM_REGION_QUADS (STREAM_REGION_VERTICES / 4)
+
+/// Longest wait for a region, in nanoseconds, before it is reused anyway.
+#define STREAM_WAIT_NS 1000000000ull
+
+// Streamed passes on (--no-stream turns them off).
+bool is_stream_enabled = true;
+
+/**
+ * @brief Ring buffers, the region of the current frame and the open pass.
+ */
+typedef struct StreamRing
+{
+  GLuint vao;                   /// Vertex layout over vbo and ebo.
+  GLuint vbo;                   /// STREAM_FRAMES regions of vertices.
+  GLuint ebo;                   /// Quad indices, shared by every quad pass.
+  GLsync fence[STREAM_FRAMES];  /// End of the frame that wrote each region.
+  int region;                   /// Region of the current frame, -1 if none.
+  int used;                     /// Vertices written to the region so far.
+  bool full;                    /// A pass did not fit; rlgl until next frame.
+  StreamVertex *mapped;         /// Mapped range of the open pass, or NULL.
+  int first;                    /// First vertex of the open pass.
+  int count;                    /// Vertices reserved in the open pass.
+  StreamPrimitive primitive;    /// Primitive of the open pass.
+  unsigned int texture;         /// Texture of the open pass.
+  Shader shader;                /// Shader of streamed passes (id 0: default).
+} StreamRing;
+
+static StreamRing ring = {.region = -1};
+
+/**
+ * @brief Parses command-line arguments for --no-stream.
+ *
+ * @param argc The count of command-line arguments.
+ * @param argv The array of command-line argument strings.
+ */
+void checkStreamFlag(int argc, char *argv[])
+{
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--no-stream") == 0)
+    {
+      is_stream_enabled = false;
+    }
+  }
+}
+
+/**
+ * @brief Creates the ring; call once after InitWindow.
+ *
+ * @return False when the buffers could not be created.
+ */
+bool streamInit(void)
+{
+  if (ring.vbo != 0)
+    return true;
+
+  glGenVertexArrays(1, &ring.vao);
+  glGenBuffers(1, &ring.vbo);
+  glGenBuffers(1, &ring.ebo);
+  glBindVertexArray(ring.vao);
+
+  glBindBuffer(GL_ARRAY_BUFFER, ring.vbo);
+  glBufferData(GL_ARRAY_BUFFER, STREAM_REGION_SIZE * STREAM_FRAMES, NULL,
+               GL_STREAM_DRAW);
+  // raylib binds these locations in every shader it loads
+  glEnableVertexAttribArray(RL_DEFAULT_SHADER_ATTRIB_LOCATION_POSITION);
+  glVertexAttribPointer(RL_DEFAULT_SHADER_ATTRIB_LOCATION_POSITION, 3,
+                        GL_FLOAT, GL_FALSE, sizeof(StreamVertex),
+                        (const void *)offsetof(StreamVertex, x));
+  glEnableVertexAttribArray(RL_DEFAULT_SHADER_ATTRIB_LOCATION_TEXCOORD);
+  glVertexAttribPointer(RL_DEFAULT_SHADER_ATTRIB_LOCATION_TEXCOORD, 2,
+                        GL_FLOAT, GL_FALSE, sizeof(StreamVertex),
+                        (const void *)offsetof(StreamVertex, u));
+  glEnableVertexAttribArray(RL_DEFAULT_SHADER_ATTRIB_LOCATION_COLOR);
+  glVertexAttribPointer(RL_DEFAULT_SHADER_ATTRIB_LOCATION_COLOR, 4,
+                        GL_UNSIGNED_BYTE, GL_TRUE, sizeof(StreamVertex),
+                        (const void *)offsetof(StreamVertex, r));
+
+  // Two triangles per quad; base vertices move each draw to its own quads.
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ring.ebo);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+               (GLsizeiptr)STREAM_REGION_QUADS * 6 * sizeof(GLuint), NULL,
+               GL_STATIC_DRAW);
+  GLuint *indices = glMapBufferRange(
+      GL_ELEMENT_ARRAY_BUFFER, 0,
+      (GLsizeiptr)STREAM_REGION_QUADS * 6 * sizeof(GLuint),
+      GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+  if (indices)
+  {
+    for (GLuint q = 0; q < (GLuint)STREAM_REGION_QUADS; q++)
+    {
+      GLuint *at = indices + q * 6;
+      GLuint v = q * 4;
+      at[0] = v;
+      at[1] = v + 1;
+      at[2] = v + 2;
+      at[3] = v;
+      at[4] = v + 2;
+      at[5] = v + 3;
+    }
+    glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER);
+  }
+  glBindVertexArray(0);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  if (!indices)
+  {
+    TraceLog(LOG_WARNING, "[Stream] Failed to create the vertex ring");
+    streamShutdown();
+    return false;
+  }
+  TraceLog(LOG_INFO, "[Stream] %d x %u KiB vertex ring", STREAM_FRAMES,
+           STREAM_REGION_BYTES / 1024u);
+  return true;
+}
+
+/**
+ * @brief Moves to the next region, waiting for the GPU to release it.
+ */
+void streamBeginFrame(void)
+{
+  if (ring.vbo == 0)
+    return;
+  if (ring.region >= 0)
+  {
+    // Every draw of the closing frame has been issued
+    ring.fence[ring.region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  }
+  ring.region = (ring.region + 1) % STREAM_FRAMES;
+  ring.used = 0;
+  ring.full = false;
+  GLsync fence = ring.fence[ring.region];
+  if (fence)
+  {
+    GLenum status = glClientWaitSync(fence, 0, 0);
+    if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+    {
+      // The GPU is a whole ring behind: wait rather than overwrite
+      profilerCount(PROFILE_STREAM_STALLS, 1.0);
+      glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, STREAM_WAIT_NS);
+    }
+    glDeleteSync(fence);
+    ring.fence[ring.region] = NULL;
+  }
+}
+
+/**
+ * @brief Opens a streamed pass.
+ *
+ * Maps the rest of the frame's region unsynchronized: its fence has already
+ * been waited for, so nothing the GPU still reads can be overwritten.
+ *
+ * @param primitive Primitive of the pass.
+ * @param texture_id GL id of the texture (0 = default white texture).
+ * @return False when the ring is off, full or unavailable.
+ */
+bool streamBegin(StreamPrimitive primitive, unsigned int texture_id)
+{
+  if (!is_stream_enabled || ring.vbo == 0 || ring.region < 0 || ring.full)
+    return false;
+  if (ring.mapped)
+    streamEnd();
+
+  rlDrawRenderBatchActive();
+  GLintptr region = (GLintptr)ring.region * STREAM_REGION_SIZE;
+  GLintptr offset = (GLintptr)ring.used * (GLintptr)sizeof(StreamVertex);
+  glBindBuffer(GL_ARRAY_BUFFER, ring.vbo);
+  ring.mapped = glMapBufferRange(
+      GL_ARRAY_BUFFER, region + offset,
+      STREAM_REGION_SIZE - offset,
+      GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT |
+          GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_FLUSH_EXPLICIT_BIT);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  if (!ring.mapped)
+  {
+    ring.full = true;
+    return false;
+  }
+  ring.first = ring.used;
+  ring.count = 0;
+  ring.primitive = primitive;
+  ring.texture = texture_id;
+  return true;
+}
+
+/**
+ * @brief Reserves vertices in the open pass.
+ *
+ * @param count Number of vertices.
+ * @return Where to write them, or NULL when the region is full.
+ */
+StreamVertex *streamReserve(int count)
+{
+  if (!ring.mapped || ring.used + count > STREAM_REGION_VERTICES)
+  {
+    if (ring.mapped && !ring.full)
+    {
+      TraceLog(LOG_DEBUG, "[Stream] region full, rest of frame via rlgl");
+      profilerCount(PROFILE_STREAM_SPILLS, 1.0);
+    }
+    ring.full = true;
+    return NULL;
+  }
+  StreamVertex *at = ring.mapped + ring.count;
+  ring.used += count;
+  ring.count += count;
+  return at;
+}
+
+/**
+ * @brief Closes the open pass and draws what it wrote with rlgl's current
+ * camera, blending and depth state.
+ */
+void streamEnd(void)
+{
+  if (!ring.mapped)
+    return;
+  glBindBuffer(GL_ARRAY_BUFFER, ring.vbo);
+  if (ring.count > 0)
+  {
+    glFlushMappedBufferRange(
+        GL_ARRAY_BUFFER, 0,
+        (GLsizeiptr)ring.count * (GLsizeiptr)sizeof(StreamVertex));
+  }
+  glUnmapBuffer(GL_ARRAY_BUFFER);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  ring.mapped = NULL;
+  if (ring.count == 0)
+    return;
+
+  unsigned int program = ring.shader.id;
+  int *locs = ring.shader.locs;
+  if (program == 0)
+  {
+    program = rlGetShaderIdDefault();
+    locs = rlGetShaderLocsDefault();
+  }
+  // Same uniforms rlgl sets for its batch
+  Matrix m = MatrixMultiply(rlGetMatrixModelview(), rlGetMatrixProjection());
+  float mvp[16] = {m.m0, m.m1, m.m2,  m.m3,  m.m4,  m.m5,  m.m6,  m.m7,
+                   m.m8, m.m9, m.m10, m.m11, m.m12, m.m13, m.m14, m.m15};
+  glUseProgram(program);
+  glUniformMatrix4fv(locs[SHADER_LOC_MATRIX_MVP], 1, GL_FALSE, mvp);
+  glUniform4f(locs[SHADER_LOC_COLOR_DIFFUSE], 1.0f, 1.0f, 1.0f, 1.0f);
+  glUniform1i(locs[SHADER_LOC_MAP_DIFFUSE], 0);
+  glActiveTexture(GL_TEXTURE0);
+  glBindTexture(GL_TEXTURE_2D,
+                ring.texture ? ring.texture : rlGetTextureIdDefault());
+
+  GLint base = ring.region * STREAM_REGION_VERTICES + ring.first;
+  glBindVertexArray(ring.vao);
+  if (ring.primitive == STREAM_QUADS)
+  {
+    glDrawElementsBaseVertex(GL_TRIANGLES, ring.count / 4 * 6,
+                             GL_UNSIGNED_INT, NULL, base);
+  }
+  else
+  {
+    glDrawArrays(GL_LINES, base, ring.count);
+  }
+  glBindVertexArray(0);
+  glBindTexture(GL_TEXTURE_2D, 0);
+  glUseProgram(0);
+
+  profilerCount(PROFILE_STREAM_BYTES,
+                (double)ring.count * (double)sizeof(StreamVertex));
+  profilerCount(PROFILE_STREAM_DRAWS, 1.0);
+}
+
+/**
+ * @brief Draws streamed passes with the given shader.
+ *
+ * @param shader Shader loaded by raylib; an id of 0 restores the default.
+ */
+void streamSetShader(Shader shader)
+{
+  ring.shader = shader;
+}
+
+/**
+ * @brief Frees the ring; call before CloseWindow.
+ */
+void streamShutdown(void)
+{
+  for (int i = 0; i < STREAM_FRAMES; i++)
+  {
+    if (ring.fence[i])
+      glDeleteSync(ring.fence[i]);
+  }
+  if (ring.vao)
+    glDeleteVertexArrays(1, &ring.vao);
+  if (ring.vbo)
+    glDeleteBuffers(1, &ring.vbo);
+  if (ring.ebo)
+    glDeleteBuffers(1, &ring.ebo);
+  memset(&ring, 0, sizeof(ring));
+  ring.region = -1;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file stream.h
+ * @brief Declares the streaming vertex ring for geometry rebuilt every frame
+ * (particles, sprites, debug lines).
+ *
+ * One large vertex buffer is split into STREAM_FRAMES regions; each frame
+ * writes into its own region and a fence placed at the end of the frame
+ * tells when the GPU is done with it. Passes write vertices straight into
+ * the mapped region, without rlgl's intermediate batch copy and without the
+ * driver synchronising with draws still in flight. A pass that does not fit
+ * falls back to the rlgl batch.
+ */
+#ifndef STREAM_H
+#define STREAM_H
+
+#include "raylib.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/// Regions of the ring: frames the GPU may still be reading from.
+#define STREAM_FRAMES 3
+
+/// Bytes of one region (one frame of streamed vertices).
+#define STREAM_REGION_BYTES (4u << 20)
+
+// Streamed passes on (the default); --no-stream sends them through the rlgl
+// batch, for comparison.
+extern bool is_stream_enabled;
+
+/**
+ * @brief Parses command-line arguments for --no-stream.
+ *
+ * @param argc The count of command-line arguments.
+ * @param argv The array of command-line argument strings.
+ */
+void checkStreamFlag(int argc, char *argv[]);
+
+/**
+ * @brief Vertex layout of the ring, matching raylib's default shader
+ * attributes.
+ */
+typedef struct StreamVertex
+{
+  float x, y, z;      /// Position.
+  float u, v;         /// Texture coordinates.
+  uint8_t r, g, b, a; /// Colour.
+} StreamVertex;
+
+/**
+ * @brief Primitive drawn by a streamed pass.
+ */
+typedef enum StreamPrimitive
+{
+  STREAM_LINES = 0, /// Two vertices per line.
+  STREAM_QUADS,     /// Four vertices per quad, counter-clockwise.
+} StreamPrimitive;
+
+/**
+ * @brief Creates the ring; call once after InitWindow.
+ *
+ * @return False when the buffers could not be created; every pass then
+ * uses the rlgl batch.
+ */
+bool streamInit(void);
+
+/**
+ * @brief Moves to the next region, waiting for the GPU to release it; call
+ * once per frame before drawing.
+ */
+void streamBeginFrame(void);
+
+/**
+ * @brief Opens a streamed pass; flushes the rlgl batch so draws keep their
+ * order.
+ *
+ * Blending, depth state, the camera and the shader (see streamSetShader)
+ * are taken from rlgl when the pass ends.
+ *
+ * @param primitive Primitive of the pass.
+ * @param texture_id GL id of the texture (0 = default white texture).
+ * @return False when the ring is off, full or unavailable; use rlgl instead.
+ */
+bool streamBegin(StreamPrimitive primitive, unsigned int texture_id);
+
+/**
+ * @brief Reserves vertices in the open pass.
+ *
+ * The memory is write-only (write every field, never read it back).
+ *
+ * @param count Number of vertices.
+ * @return Where to write them, or NULL when the region is full; end the
+ * pass and draw the rest through rlgl.
+ */
+StreamVertex *streamReserve(int count);
+
+/**
+ * @brief Closes the open pass and draws what it wrote.
+ */
+void streamEnd(void);
+
+/**
+ * @brief Draws streamed passes with the given shader instead of raylib's
+ * default one, like BeginShaderMode does for the rlgl batch.
+ *
+ * @param shader Shader loaded by raylib; an id of 0 restores the default.
+ */
+void streamSetShader(Shader shader);
+
+/**
+ * @brief Frees the ring; call before CloseWindow.
+ */
+void streamShutdown(void);
+
+#endif
@@ -0,0 +1,316 @@
+/**
+ * @file animation.c
+ * @brief Implements the pooled, time-driven sprite-sheet animation system.
+ */
+#include "animation.h"
+#include "../render/billboard.h"
+#include "raylib.h"
+#include "sprites.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/**
+ * @brief Finds the slot a handle refers to.
+ *
+ * @param pool Pointer to the pool.
+ * @param handle Handle to resolve.
+ * @return Slot index of the playing animation, or -1 if the handle is stale.
+ */
+static int findSpriteAnimSlot(const SpriteAnimPool *pool,
+                              SpriteAnimHandle handle)
+{
+  uint32_t index = (handle & 0xFFFFu);
+  if (!pool || index == 0 || index > SPRITE_ANIM_MAX)
+  {
+    return -1;
+  }
+  const SpriteAnim *anim = &pool->items[index - 1];
+  if (!anim->active || anim->generation != (uint16_t)(handle >> 16))
+  {
+    return -1;
+  }
+  return (int)index - 1;
+}
+
+/**
+ * @brief Resolves a handle into its slot, or NULL if the handle is stale.
+ *
+ * @param pool Pointer to the pool.
+ * @param handle Handle to resolve.
+ * @return Pointer to the playing animation, or NULL.
+ */
+static SpriteAnim *resolveSpriteAnim(SpriteAnimPool *pool,
+                                     SpriteAnimHandle handle)
+{
+  int slot = findSpriteAnimSlot(pool, handle);
+  return slot < 0 ? NULL : &pool->items[slot];
+}
+
+/**
+ * @brief Returns a slot to the free stack.
+ *
+ * @param pool Pointer to the pool.
+ * @param index Slot index to release.
+ */
+static void releaseSpriteAnim(SpriteAnimPool *pool, uint16_t index)
+{
+  SpriteAnim *anim = &pool->items[index];
+  anim->active = false;
+  anim->generation++;
+  pool->free[pool->free_count++] = index;
+  pool->active_count--;
+}
+
+/**
+ * @brief Allocates an empty animation pool.
+ *
+ * @return Pointer to the pool, or NULL on failure.
+ */
+SpriteAnimPool *newSpriteAnimPool(void)
+{
+  SpriteAnimPool *pool = malloc(sizeof(SpriteAnimPool));
+  if (!pool)
+  {
+    return NULL;
+  }
+  pool->active_count = 0;
+  pool->free_count = SPRITE_ANIM_MAX;
+  for (uint16_t i = 0; i < SPRITE_ANIM_MAX; i++)
+  {
+    pool->items[i].active = false;
+    pool->items[i].generation = 1;
+    // Pop order: slot 0 first
+    pool->free[i] = (uint16_t)(SPRITE_ANIM_MAX - 1 - i);
+  }
+  return pool;
+}
+
+/**
+ * @brief Frees the animation pool.
+ *
+ * @param pool Pointer to the pool to destroy.
+ */
+void destroySpriteAnimPool(SpriteAnimPool *pool)
+{
+  if (!pool)
+  {
+    return;
+  }
+  free(pool);
+}
+
+/**
+ * @brief Starts a new animation.
+ *
+ * @param pool Pointer to the pool.
+ * @param sheet Sheet to play.
+ * @param position World position of the billboard center.
+ * @param repeats Extra loops after the first one.
+ * @param size Billboard height in world units.
+ * @param opacity Requested opacity (0.0 to 1.0).
+ * @param now Current time in seconds.
+ * @return Handle of the animation, or SPRITE_ANIM_NONE if the pool is full.
+ */
+SpriteAnimHandle spriteAnimStart(SpriteAnimPool *pool, SpriteSheet *sheet,
+                                 Vector3 position, int repeats, float size,
+                                 float opacity, double now)
+{
+  if (!pool || !sheet || pool->free_count == 0)
+  {
+    return SPRITE_ANIM_NONE;
+  }
+  uint16_t index = pool->free[--pool->free_count];
+  SpriteAnim *anim = &pool->items[index];
+  anim->sheet = sheet;
+  anim->position = position;
+  anim->start = now;
+  anim->size = size;
+  anim->opacity = opacity;
+  anim->repeats = repeats;
+  anim->active = true;
+  pool->active_count++;
+  return ((SpriteAnimHandle)anim->generation << 16) | (uint32_t)(index + 1);
+}
+
+/**
+ * @brief Starts an animation only if the handle is not already playing.
+ *
+ * @param pool Pointer to the pool.
+ * @param handle In/out handle of the animation.
+ * @param sheet Sheet to play.
+ * @param position World position of the billboard center.
+ * @param repeats Extra loops after the first one.
+ * @param size Billboard height in world units.
+ * @param opacity Requested opacity (0.0 to 1.0).
+ * @param now Current time in seconds.
+ * @return true if a new animation was started.
+ */
+bool spriteAnimRestartIfIdle(SpriteAnimPool *pool, SpriteAnimHandle *handle,
+                             SpriteSheet *sheet, Vector3 position, int repeats,
+                             float size, float opacity, double now)
+{
+  if (!handle || resolveSpriteAnim(pool, *handle))
+  {
+    return false;
+  }
+  *handle = spriteAnimStart(pool, sheet, position, repeats, size, opacity, now);
+  return *handle != SPRITE_ANIM_NONE;
+}
+
+/**
+ * @brief Checks whether the handle refers to a playing animation.
+ *
+ * @param pool Pointer to the pool.
+ * @param handle Handle to check.
+ * @return true if the animation is still playing.
+ */
+bool spriteAnimIsPlaying(const SpriteAnimPool *pool, SpriteAnimHandle handle)
+{
+  return findSpriteAnimSlot(pool, handle) >= 0;
+}
+
+/**
+ * @brief Moves a playing animation; ignored for stale handles.
+ *
+ * @param pool Pointer to the pool.
+ * @param handle Handle of the animation.
+ * @param position New world position of the billboard center.
+ */
+void spriteAnimSetPosition(SpriteAnimPool *pool, SpriteAnimHandle handle,
+                           Vector3 position)
+{
+  SpriteAnim *anim = resolveSpriteAnim(pool, handle);
+  if (anim)
+  {
+    anim->position = position;
+  }
+}
+
+/**
+ * @brief Stops an animation and releases its slot; ignored for stale handles.
+ *
+ * @param pool Pointer to the pool.
+ * @param handle Handle of the animation.
+ */
+void spriteAnimStop(SpriteAnimPool *pool, SpriteAnimHandle handle)
+{
+  SpriteAnim *anim = resolveSpriteAnim(pool, handle);
+  if (anim)
+  {
+    releaseSpriteAnim(pool, (uint16_t)(anim - pool->items));
+  }
+}
+
+/**
+ * @brief Computes the frame an animation shows at the given time.
+ *
+ * @param anim Playing animation.
+ * @param now Current time in seconds.
+ * @return Absolute frame number (may exceed frame_count when looping), or -1
+ * once every loop has been played.
+ */
+static int spriteAnimFrameAt(const SpriteAnim *anim, double now)
+{
+  double elapsed = now - anim->start;
+  if (elapsed < 0.0)
+  {
+    elapsed = 0.0;
+  }
+  int frame = (int)(elapsed * (double)anim->sheet->fps);
+  int total = anim->sheet->frame_count * (anim->repeats + 1);
+  return frame < total ? frame : -1;
+}
+
+/**
+ * @brief Releases every animation whose playback time has elapsed.
+ *
+ * @param pool Pointer to the pool.
+ * @param now Current time in seconds.
+ */
+void spriteAnimUpdate(SpriteAnimPool *pool, double now)
+{
+  if (!pool)
+  {
+    return;
+  }
+  for (uint16_t i = 0; i < SPRITE_ANIM_MAX && pool->active_count > 0; i++)
+  {
+    if (pool->items[i].active && spriteAnimFrameAt(&pool->items[i], now) < 0)
+    {
+      releaseSpriteAnim(pool, i);
+    }
+  }
+}
+
+/**
+ * @brief Draws all playing animations in one batched pass.
+ *
+ * Instances are grouped by texture so each texture is bound once, even when
+ * several sheets share an atlas; frames are picked from the elapsed time and
+ * the sheet's precomputed UV table.
+ *
+ * @param pool Pointer to the pool.
+ * @param camera Active camera.
+ * @param now Current time in seconds.
+ */
+void spriteAnimDrawAll(SpriteAnimPool *pool, const Camera3D *camera,
+                       double now)
+{
+  if (!pool || !camera || pool->active_count == 0)
+  {
+    return;
+  }
+  // Collect playing slots grouped by texture id (insertion sort; few
+  // textures). Sheet pointers are not compared: they may point into
+  // unrelated objects.
+  int count = 0;
+  for (uint16_t i = 0; i < SPRITE_ANIM_MAX; i++)
+  {
+    if (!pool->items[i].active)
+    {
+      continue;
+    }
+    unsigned int texture_id = pool->items[i].sheet->texture.id;
+    int j = count++;
+    while (j > 0 &&
+           pool->items[pool->order[j - 1]].sheet->texture.id > texture_id)
+    {
+      pool->order[j] = pool->order[j - 1];
+      j--;
+    }
+    pool->order[j] = i;
+  }
+
+  BillboardBasis basis = billboardBasis(camera);
+  bool open = false;
+  unsigned int bound = 0;
+  for (int k = 0; k < count; k++)
+  {
+    SpriteAnim *anim = &pool->items[pool->order[k]];
+    int frame = spriteAnimFrameAt(anim, now);
+    if (frame < 0)
+    {
+      continue;
+    }
+    const SpriteSheet *sheet = anim->sheet;
+    if (!open || sheet->texture.id != bound)
+    {
+      if (open)
+      {
+        billboardEnd();
+      }
+      bound = sheet->texture.id;
+      billboardBegin(bound);
+      open = true;
+    }
+    float aspect = sheet->frame_width / sheet->frame_height;
+    Vector2 size = {anim->size * aspect, anim->size};
+    billboardQuad(&basis, anim->position, size, 0.0f,
+                  sheet->frames[frame % sheet->frame_count], WHITE);
+  }
+  if (open)
+  {
+    billboardEnd();
+  }
+}
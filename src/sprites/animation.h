@@ -0,0 +1,154 @@
+/**
+ * @file animation.h
+ * @brief Declares a pooled, time-driven sprite-sheet animation system.
+ *
+ * Animations are addressed by handles instead of pointers; a handle whose
+ * animation has finished (and whose slot was reused) simply stops resolving.
+ */
+#ifndef ANIMATION_H
+#define ANIMATION_H
+
+#include "raylib.h"
+#include "sprites.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/// Maximum number of simultaneously playing sprite animations.
+#define SPRITE_ANIM_MAX 256
+
+/// Handle value that never refers to an animation.
+#define SPRITE_ANIM_NONE 0u
+
+/**
+ * @brief Handle of an animation: slot index + 1 (low 16 bits) and slot
+ * generation (high 16 bits).
+ */
+typedef uint32_t SpriteAnimHandle;
+
+/**
+ * @brief A single playing instance of a sprite sheet.
+ */
+typedef struct
+{
+  SpriteSheet *sheet;  /// Sheet being played.
+  Vector3 position;    /// World position of the billboard center.
+  double start;        /// Time at which playback started (seconds).
+  float size;          /// Billboard height in world units.
+  float opacity;       /// Requested opacity (0.0 to 1.0).
+  int repeats;         /// Extra loops after the first one.
+  uint16_t generation; /// Incremented every time the slot is reused.
+  bool active;         /// Whether the slot is playing.
+} SpriteAnim;
+
+/**
+ * @brief Fixed-size pool of animation instances.
+ */
+typedef struct
+{
+  SpriteAnim items[SPRITE_ANIM_MAX];  /// Animation slots.
+  uint16_t free[SPRITE_ANIM_MAX];     /// Stack of free slot indices.
+  uint16_t free_count;                /// Number of entries in `free`.
+  uint16_t order[SPRITE_ANIM_MAX];    /// Scratch draw order (by texture).
+  uint16_t active_count;              /// Number of playing animations.
+} SpriteAnimPool;
+
+/**
+ * @brief Allocates an empty animation pool.
+ *
+ * @return Pointer to the pool, or NULL on failure.
+ */
+SpriteAnimPool *newSpriteAnimPool(void);
+
+/**
+ * @brief Frees the animation pool.
+ *
+ * @param pool Pointer to the pool to destroy.
+ */
+void destroySpriteAnimPool(SpriteAnimPool *pool);
+
+/**
+ * @brief Starts a new animation.
+ *
+ * @param pool Pointer to the pool.
+ * @param sheet Sheet to play.
+ * @param position World position of the billboard center.
+ * @param repeats Extra loops after the first one.
+ * @param size Billboard height in world units.
+ * @param opacity Requested opacity (0.0 to 1.0).
+ * @param now Current time in seconds.
+ * @return Handle of the animation, or SPRITE_ANIM_NONE if the pool is full.
+ */
+SpriteAnimHandle spriteAnimStart(SpriteAnimPool *pool, SpriteSheet *sheet,
+                                 Vector3 position, int repeats, float size,
+                                 float opacity, double now);
+
+/**
+ * @brief Starts an animation only if the handle is not already playing.
+ *
+ * A running hit animation is not restarted by further hits. The handle is
+ * updated in place when a new animation is started.
+ *
+ * @param pool Pointer to the pool.
+ * @param handle In/out handle of the animation.
+ * @param sheet Sheet to play.
+ * @param position World position of the billboard center.
+ * @param repeats Extra loops after the first one.
+ * @param size Billboard height in world units.
+ * @param opacity Requested opacity (0.0 to 1.0).
+ * @param now Current time in seconds.
+ * @return true if a new animation was started.
+ */
+bool spriteAnimRestartIfIdle(SpriteAnimPool *pool, SpriteAnimHandle *handle,
+                             SpriteSheet *sheet, Vector3 position, int repeats,
+                             float size, float opacity, double now);
+
+/**
+ * @brief Checks whether the handle refers to a playing animation.
+ *
+ * @param pool Pointer to the pool.
+ * @param handle Handle to check.
+ * @return true if the animation is still playing.
+ */
+bool spriteAnimIsPlaying(const SpriteAnimPool *pool, SpriteAnimHandle handle);
+
+/**
+ * @brief Moves a playing animation; ignored for stale handles.
+ *
+ * @param pool Pointer to the pool.
+ * @param handle Handle of the animation.
+ * @param position New world position of the billboard center.
+ */
+void spriteAnimSetPosition(SpriteAnimPool *pool, SpriteAnimHandle handle,
+                           Vector3 position);
+
+/**
+ * @brief Stops an animation and releases its slot; ignored for stale handles.
+ *
+ * @param pool Pointer to the pool.
+ * @param handle Handle of the animation.
+ */
+void spriteAnimStop(SpriteAnimPool *pool, SpriteAnimHandle handle);
+
+/**
+ * @brief Releases every animation whose playback time has elapsed.
+ *
+ * @param pool Pointer to the pool.
+ * @param now Current time in seconds.
+ */
+void spriteAnimUpdate(SpriteAnimPool *pool, double now);
+
+/**
+ * @brief Draws all playing animations in one batched pass.
+ *
+ * Instances are grouped by texture so each texture is bound once, even when
+ * several sheets share an atlas; frames are picked from the elapsed time and
+ * the sheet's precomputed UV table.
+ *
+ * @param pool Pointer to the pool.
+ * @param camera Active camera.
+ * @param now Current time in seconds.
+ */
+void spriteAnimDrawAll(SpriteAnimPool *pool, const Camera3D *camera,
+                       double now);
+
+#endif
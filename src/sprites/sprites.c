@@ -7,16 +7,18 @@
 /**
  * @brief Creates and initializes a new sprite sheet from an image file.
  *
- * Loads the texture from the specified path and calculates frame dimensions
- * based on the number of frames per line and number of lines.
+ * Loads the texture from the specified path, calculates frame dimensions
+ * based on the number of frames per line and number of lines, and precomputes
+ * the normalized UV rectangle of every frame (row-major playback order).
  *
  * @param path Path to the image file.
  * @param frames_per_line Number of frames in each row of the sprite sheet.
  * @param num_lines Number of rows in the sprite sheet.
+ * @param fps Playback rate of the sheet in frames per second.
  * @return An initialized SpriteSheet structure.
  */
 SpriteSheet newSpriteSheet(const char *path, uint16_t frames_per_line,
-                           uint16_t num_lines)
+                           uint16_t num_lines, float fps)
 {
   Texture2D texture = LoadTexture(path);
   if (texture.id == 0)
@@ -30,123 +32,39 @@ SpriteSheet newSpriteSheet(const char *path, uint16_t frames_per_line,
   model.frames_per_line = frames_per_line;
   model.num_lines = num_lines;
   model.texture = texture;
+  model.fps = fps;
+  model.frame_count = frames_per_line * num_lines;
+  model.frames = malloc(sizeof(Rectangle) * (size_t)model.frame_count);
+  if (!model.frames)
+  {
+    TraceLog(LOG_ERROR, "Fail to allocate frames table: %s", path);
+    exit(1);
+  }
+  const float u = 1.0f / (float)frames_per_line;
+  const float v = 1.0f / (float)num_lines;
+  for (int i = 0; i < model.frame_count; i++)
+  {
+    int col = i % frames_per_line;
+    int line = i / frames_per_line;
+    model.frames[i] = (Rectangle){u * (float)col, v * (float)line, u, v};
+  }
   return model;
 }
 
 #define EXPLOSION_A "assets/textures/explosion_a.png"
 #define EXPLOSION_A_NUM_FRAMES_PER_LINE 5
 #define EXPLOSION_A_NUM_LINES 5
+#define EXPLOSION_A_FPS 60.0f
 
 #define EXPLOSION_B "assets/textures/explosion_b.png"
 #define EXPLOSION_B_NUM_FRAMES_PER_LINE 3
 #define EXPLOSION_B_NUM_LINES 3
+#define EXPLOSION_B_FPS 60.0f
 
 #define SMOKE_A "assets/textures/smoke_a.png"
 #define SMOKE_A_NUM_FRAMES_PER_LINE 5
 #define SMOKE_A_NUM_LINES 3
-
-/**
- * @brief Creates and initializes a new sprite animation state.
- *
- * @param model Pointer to the SpriteSheet to be used for animation.
- * @return Pointer to a newly allocated SpriteSheetState, or NULL on failure.
- */
-SpriteSheetState *newSpriteSheetState(SpriteSheet *model, int repeats,
-                                      float size, float opacity)
-{
-  SpriteSheetState *state = malloc(sizeof(SpriteSheetState));
-  if (!state)
-  {
-    return NULL;
-  }
-  state->counter = 0;
-  state->frame = 0;
-  state->line = 0;
-  state->model = model;
-  state->active = true;
-  state->repeats = repeats;
-  state->opacity = opacity;
-  state->size = size;
-  return state;
-}
-
-/**
- * @brief Frees the memory associated with an sprite state.
- *
- * @param state Pointer to the SpriteSheetState to destroy.
- */
-void destroySpriteSheetState(SpriteSheetState *state)
-{
-  if (!state)
-    return;
-  free(state);
-}
-
-/**
- * @brief Resets and reactivates a sprite animation state.
- *
- * If the animation is already active, this function does nothing.
- * Otherwise, it resets the frame counters and marks the animation as active.
- *
- * @param state Pointer to the SpriteSheetState to reset.
- */
-void dropSpriteSheetState(SpriteSheetState *state)
-{
-  if (!state || state->active)
-    return;
-  state->active = true;
-  state->counter = 0;
-  state->frame = 0;
-  state->line = 0;
-}
-
-/**
- * @brief Draws the sprite animation as a billboard in 3D space.
- *
- * Advances the animation based on a simple frame counter and renders the
- * current frame using DrawBillboardRec.
- *
- * @param state Pointer to the active SpriteSheetState.
- * @param camera The 3D camera used to orient the billboard.
- * @param position The world position where the sprite should be rendered.
- */
-void drawSpriteSheetState(SpriteSheetState *state, Camera3D camera,
-                          Vector3 position)
-{
-  if (!state || !state->active)
-    return;
-
-  state->frame++;
-  if (state->frame >= state->model->frames_per_line)
-  {
-    state->frame = 0;
-    state->line++;
-    if (state->line >= state->model->num_lines)
-    {
-      state->line = 0;
-      state->counter++;
-    }
-  }
-  if (state->counter > state->repeats)
-  {
-    state->active = false;
-  }
-  if (!state->active)
-    return;
-
-  Rectangle frame_rec = {state->model->frame_width * (float)state->frame,
-                         state->model->frame_height * (float)state->line,
-                         state->model->frame_width, state->model->frame_height};
-
-  float aspect =
-      (float)state->model->frame_width / (float)state->model->frame_height;
-
-  float targetWidth = state->size * aspect;
-  Vector2 size = {targetWidth, state->size};
-
-  DrawBillboardRec(camera, state->model->texture, frame_rec, position, size,
-                   WHITE);
-}
+#define SMOKE_A_FPS 30.0f
 
 /**
  * @brief Creates a new node containing a single sprite model.
@@ -157,11 +75,13 @@ void drawSpriteSheetState(SpriteSheetState *state, Camera3D camera,
  * @param frames_per_line Number of frames per horizontal line in the sprite
  * sheet.
  * @param num_lines Number of lines (rows) in the sprite sheet.
+ * @param fps Playback rate of the sheet in frames per second.
  * @param prev Pointer to the previous node in the list.
  * @return Pointer to the newly allocated node, or NULL on failure.
  */
 SpriteSheetNode *newSpriteSheetNode(const char *path, uint16_t frames_per_line,
-                                    uint16_t num_lines, SpriteSheetNode *prev)
+                                    uint16_t num_lines, float fps,
+                                    SpriteSheetNode *prev)
 {
   SpriteSheetNode *node = malloc(sizeof(SpriteSheetNode));
   if (!node)
@@ -169,7 +89,7 @@ SpriteSheetNode *newSpriteSheetNode(const char *path, uint16_t frames_per_line,
     return NULL;
   }
 
-  SpriteSheet model = newSpriteSheet(path, frames_per_line, num_lines);
+  SpriteSheet model = newSpriteSheet(path, frames_per_line, num_lines, fps);
 
   node->prev = prev;
   node->next = NULL;
@@ -189,6 +109,7 @@ void destroySpriteSheetNode(SpriteSheetNode *node)
     return;
   }
   UnloadTexture(node->self.texture);
+  free(node->self.frames);
   free(node);
 }
 
@@ -224,12 +145,16 @@ SpriteSheetList *loadSpriteSheetList()
       EXPLOSION_A_NUM_LINES,
       EXPLOSION_B_NUM_LINES,
   };
+  const float fps[] = {
+      EXPLOSION_A_FPS,
+      EXPLOSION_B_FPS,
+  };
 
   for (int i = 0; list[i] != NULL; i++)
   {
     TraceLog(LOG_INFO, "[Explosion] Loading model %s", list[i]);
     SpriteSheetNode *node =
-        newSpriteSheetNode(list[i], pers[i], nums[i], models->tail);
+        newSpriteSheetNode(list[i], pers[i], nums[i], fps[i], models->tail);
     if (!node)
     {
       destroySpriteSheetList(models);
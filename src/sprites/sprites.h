@@ -15,6 +15,9 @@ typedef struct
   float frame_height;  /// Height of each frame in the sheet.
   int frames_per_line; /// Number of frames in each row.
   int num_lines;       /// Number of rows in the sheet.
+  int frame_count;     /// Total number of frames (frames_per_line * num_lines).
+  float fps;           /// Playback rate in frames per second.
+  Rectangle *frames;   /// Precomputed normalized UV rectangle of each frame.
 } SpriteSheet;
 
 /**
@@ -45,59 +48,19 @@ typedef struct
   uint16_t length;       /// Number of models in the list.
 } SpriteSheetList;
 
-/**
- * @brief Represents the animation state of an explosion instance.
- */
-typedef struct
-{
-  int frame;          /// Current animation frame (column index).
-  int line;           /// Current animation line (row index).
-  int counter;        /// Frame counter for timing.
-  bool active;        /// Whether the animation is currently active.
-  int repeats;        /// How many times to repeat the animation (-1 = infinite)
-  float opacity;      /// Current opacity (0.0 to 1.0)
-  float size;         /// Current size (scale factor)
-  SpriteSheet *model; /// Pointer to the explosion model.
-} SpriteSheetState;
-
-/**
- * @brief Creates and initializes a new explosion animation state.
- *
- * @param model Pointer to the explosion model used for animation.
- * @return Pointer to a newly allocated SpriteSheetState, or NULL on failure.
- */
-SpriteSheetState *newSpriteSheetState(SpriteSheet *model, int repeats,
-                                      float size, float opacity);
-
-/**
- * @brief Destroys and frees the memory used by an explosion animation state.
- *
- * @param state Pointer to the SpriteSheetState to be destroyed.
- */
-void destroySpriteSheetState(SpriteSheetState *state);
-
-void dropSpriteSheetState(SpriteSheetState *state);
-/**
- * @brief Draws the current frame of the explosion as a 3D billboard.
- *
- * @param state Pointer to the active SpriteSheetState.
- * @param camera The active 3D camera.
- * @param position 3D world position where the explosion should be rendered.
- */
-void drawSpriteSheetState(SpriteSheetState *state, Camera3D camera,
-                          Vector3 position);
-
 /**
  * @brief Creates a new explosion model node from a sprite sheet file.
  *
  * @param path Path to the image file.
  * @param frames_per_line Number of frames in each row of the sprite sheet.
  * @param num_lines Number of lines (rows) in the sprite sheet.
+ * @param fps Playback rate of the sheet in frames per second.
  * @param prev Pointer to the previous node in the list (may be NULL).
  * @return Pointer to the newly created SpriteSheetNode, or NULL on failure.
  */
 SpriteSheetNode *newSpriteSheetNode(const char *path, uint16_t frames_per_line,
-                                    uint16_t num_lines, SpriteSheetNode *prev);
+                                    uint16_t num_lines, float fps,
+                                    SpriteSheetNode *prev);
 
 /**
  * @brief Destroys a model node and unloads its associated texture.
@@ -126,9 +89,10 @@ void destroySpriteSheetList(SpriteSheetList *models);
  * @param path Path to the image file.
  * @param frames_per_line Number of frames in each row of the sprite sheet.
  * @param num_lines Number of lines (rows) in the sprite sheet.
+ * @param fps Playback rate of the sheet in frames per second.
  * @return A fully initialized SpriteSheet object.
  */
 SpriteSheet newSpriteSheet(const char *path, uint16_t frames_per_line,
-                           uint16_t num_lines);
+                           uint16_t num_lines, float fps);
 
 #endif
@@ -13,49 +13,43 @@
 const char *TEX_PATHS[] = {TEX_PATH_FIRE_SOFT, TEX_PATH_FIRE_STREAK,
                            TEX_PATH_GLOW, TEX_PATH_SMOKE_SOFT};
 
+/// Width of the particle atlas in pixels; rows are packed on shelves.
+#define ATLAS_WIDTH 512
+
+/// Transparent gap between packed images to avoid bilinear bleeding.
+#define ATLAS_PADDING 2
+
+/// Side of the generated solid dot image used for stars.
+#define ATLAS_DOT_SIZE 4
+
 /**
- * @brief Adds a new texture to the GameTextures list.
+ * @brief Adds a new texture node into the GameTextures list.
  *
- * Loads the texture from the specified path and assigns the given ID.
+ * The node only describes where the image lives inside the atlas; the atlas
+ * texture itself is assigned once packing is finished.
  *
  * @param list Pointer to the GameTextures list.
- * @param path Path to the texture file.
+ * @param src Sub-rectangle of the image inside the atlas (pixels).
  * @param id Unique identifier for the texture.
  * @return true if the texture was added successfully, false otherwise.
  */
-bool addGameTextureIntoList(GameTextures *list, const char *path, int id)
+bool addGameTextureIntoList(GameTextures *list, Rectangle src, int id)
 {
-  if (!list || !path)
-  {
-    return false;
-  }
-
-  Image img = LoadImage(path);
-  if (!img.data)
+  if (!list)
   {
-    TraceLog(LOG_ERROR, "Failed to load image: %s", path);
     return false;
   }
 
   GameTexture *node = malloc(sizeof(GameTexture));
-  node->id = id;
   if (!node)
   {
-    UnloadImage(img);
-    TraceLog(LOG_ERROR, "Failed to allocate memory for: %s", path);
+    TraceLog(LOG_ERROR, "Failed to allocate memory for texture: %i", id);
     return false;
   }
-
-  node->tex = LoadTextureFromImage(img);
-  UnloadImage(img);
-
-  if (node->tex.id == 0)
-  {
-    free(node);
-    TraceLog(LOG_ERROR, "Failed to create texture from image: %s", path);
-    return false;
-  }
-
+  node->id = id;
+  node->src = src;
+  node->uv = (Rectangle){0};
+  node->tex = (Texture2D){0};
   node->next = NULL;
   node->prev = list->tail;
 
@@ -68,13 +62,133 @@ bool addGameTextureIntoList(GameTextures *list, const char *path, int id)
     list->home = node;
   }
   list->tail = node;
-  TraceLog(LOG_INFO, "Texture is loaded: %s", path);
 
   return true;
 }
 
 /**
- * @brief Frees a GameTexture node and unloads its texture.
+ * @brief Loads all particle images (plus the generated star dot).
+ *
+ * @param images Output array of TEX_ID_COUNT images, indexed by texture ID.
+ * @return true on success; on failure all loaded images are released.
+ */
+static bool loadParticleImages(Image images[TEX_ID_COUNT])
+{
+  const int files = (int)(sizeof(TEX_PATHS) / sizeof(TEX_PATHS[0]));
+  for (int i = 0; i < files; ++i)
+  {
+    images[i] = LoadImage(TEX_PATHS[i]);
+    if (!images[i].data)
+    {
+      TraceLog(LOG_ERROR, "Failed to load image: %s", TEX_PATHS[i]);
+      for (int j = 0; j < i; ++j)
+      {
+        UnloadImage(images[j]);
+      }
+      return false;
+    }
+    ImageFormat(&images[i], PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    TraceLog(LOG_INFO, "Texture is loaded: %s", TEX_PATHS[i]);
+  }
+  images[TEX_ID_DOT] = GenImageColor(ATLAS_DOT_SIZE, ATLAS_DOT_SIZE, WHITE);
+  return true;
+}
+
+/**
+ * @brief Packs images into rows ("shelves") of a fixed-width atlas.
+ *
+ * @param images Images to pack, indexed by texture ID.
+ * @param rects Output placement of each image in atlas pixels.
+ * @return Height of the atlas needed (power of two).
+ */
+static int packAtlasShelves(const Image images[TEX_ID_COUNT],
+                            Rectangle rects[TEX_ID_COUNT])
+{
+  int x = ATLAS_PADDING;
+  int y = ATLAS_PADDING;
+  int shelf = 0;
+  for (int i = 0; i < TEX_ID_COUNT; ++i)
+  {
+    int w = images[i].width;
+    int h = images[i].height;
+    if (x + w + ATLAS_PADDING > ATLAS_WIDTH)
+    {
+      x = ATLAS_PADDING;
+      y += shelf + ATLAS_PADDING;
+      shelf = 0;
+    }
+    rects[i] = (Rectangle){(float)x, (float)y, (float)w, (float)h};
+    x += w + ATLAS_PADDING;
+    shelf = h > shelf ? h : shelf;
+  }
+  int used = y + shelf + ATLAS_PADDING;
+  int height = 1;
+  while (height < used)
+  {
+    height <<= 1;
+  }
+  return height;
+}
+
+/**
+ * @brief Builds the particle atlas and registers every texture in the list.
+ *
+ * @param list Pointer to the GameTextures list to fill.
+ * @return true if the atlas was created, false otherwise.
+ */
+static bool buildParticleAtlas(GameTextures *list)
+{
+  Image images[TEX_ID_COUNT];
+  if (!loadParticleImages(images))
+  {
+    return false;
+  }
+  Rectangle rects[TEX_ID_COUNT];
+  int height = packAtlasShelves(images, rects);
+
+  Image atlas = GenImageColor(ATLAS_WIDTH, height, BLANK);
+  for (int i = 0; i < TEX_ID_COUNT; ++i)
+  {
+    Rectangle from = {0, 0, (float)images[i].width, (float)images[i].height};
+    ImageDraw(&atlas, images[i], from, rects[i], WHITE);
+    UnloadImage(images[i]);
+  }
+  list->atlas = LoadTextureFromImage(atlas);
+  UnloadImage(atlas);
+  if (list->atlas.id == 0)
+  {
+    TraceLog(LOG_ERROR, "Failed to create particle atlas texture");
+    return false;
+  }
+  SetTextureFilter(list->atlas, TEXTURE_FILTER_BILINEAR);
+
+  // Sample the solid dot away from its edges so filtering never reaches the
+  // transparent padding.
+  rects[TEX_ID_DOT].x += 1.0f;
+  rects[TEX_ID_DOT].y += 1.0f;
+  rects[TEX_ID_DOT].width -= 2.0f;
+  rects[TEX_ID_DOT].height -= 2.0f;
+
+  const float aw = (float)list->atlas.width;
+  const float ah = (float)list->atlas.height;
+  for (int i = 0; i < TEX_ID_COUNT; ++i)
+  {
+    list->uv[i] = (Rectangle){rects[i].x / aw, rects[i].y / ah,
+                              rects[i].width / aw, rects[i].height / ah};
+    if (!addGameTextureIntoList(list, rects[i], i))
+    {
+      return false;
+    }
+    list->tail->tex = list->atlas;
+    list->tail->uv = list->uv[i];
+  }
+  TraceLog(LOG_INFO, "[Textures] Particle atlas %ix%i with %i images",
+           list->atlas.width, list->atlas.height, TEX_ID_COUNT);
+  return true;
+}
+
+/**
+ * @brief Frees a GameTexture node. The atlas is owned by the list.
  *
  * @param tex Pointer to the GameTexture node to destroy.
  */
@@ -84,10 +198,6 @@ void destroyGameTexture(GameTexture *tex)
   {
     return;
   }
-  if (tex->tex.id != 0)
-  {
-    UnloadTexture(tex->tex);
-  }
   free(tex);
 }
 
@@ -109,12 +219,19 @@ void destroyTexturesList(GameTextures *list)
     destroyGameTexture(cur);
     cur = next;
   }
+  if (list->atlas.id != 0)
+  {
+    UnloadTexture(list->atlas);
+  }
   free(list);
 }
 
 /**
  * @brief Creates and initializes a new GameTextures list.
  *
+ * Loads every particle texture, packs them into a single atlas and fills the
+ * UV table, so particle renderers can share one GL texture.
+ *
  * @return Pointer to the newly created GameTextures list, or NULL on failure.
  */
 GameTextures *createGameTexturesList(void)
@@ -124,15 +241,12 @@ GameTextures *createGameTexturesList(void)
     return NULL;
   list->home = NULL;
   list->tail = NULL;
+  list->atlas = (Texture2D){0};
 
-  for (int i = 0; i < (int)(sizeof(TEX_PATHS) / sizeof(TEX_PATHS[0]));
-       ++i)
+  if (!buildParticleAtlas(list))
   {
-    if (!addGameTextureIntoList(list, TEX_PATHS[i], i))
-    {
-      destroyTexturesList(list);
-      return NULL;
-    }
+    destroyTexturesList(list);
+    return NULL;
   }
   return list;
 }
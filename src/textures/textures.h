@@ -7,15 +7,23 @@
 #define TEX_ID_FIRE_STREAK 1
 #define TEX_ID_GLOW 2
 #define TEX_ID_SMOKE_SOFT 3
+#define TEX_ID_DOT 4
+#define TEX_ID_COUNT 5
 
 /**
  * @brief Node in a doubly linked list containing a texture and its ID.
+ *
+ * All particle textures are packed into one atlas at load time, so `tex` is
+ * the shared atlas texture (owned by the GameTextures list) and `src`/`uv`
+ * describe the sub-image inside it.
  */
 typedef struct GameTexture
 {
   struct GameTexture *next; /// Pointer to the next texture in the list.
   struct GameTexture *prev; /// Pointer to the previous texture in the list.
-  Texture2D tex;            /// The actual texture data.
+  Texture2D tex;            /// Atlas texture containing the image.
+  Rectangle src;            /// Sub-rectangle inside the atlas (pixels).
+  Rectangle uv;             /// Sub-rectangle inside the atlas (0..1).
   int id;                   /// Unique identifier for the texture.
 } GameTexture;
 
@@ -24,32 +32,34 @@ typedef struct GameTexture
  */
 typedef struct GameTextures
 {
-  GameTexture *home; /// Pointer to the first texture in the list.
-  GameTexture *tail; /// Pointer to the last texture in the list.
+  GameTexture *home;         /// Pointer to the first texture in the list.
+  GameTexture *tail;         /// Pointer to the last texture in the list.
+  Texture2D atlas;           /// Packed atlas with all particle textures.
+  Rectangle uv[TEX_ID_COUNT]; /// UV rectangle of each texture, by ID.
 } GameTextures;
 
 /**
- * @brief Creates and initializes a new GameTexture node.
- *
- * Loads the texture from the specified path and assigns the given ID.
+ * @brief Frees all textures and nodes in the GameTextures list.
  *
- * @param path Path to the texture file.
- * @param id Unique identifier for the texture.
- * @param prev Pointer to the previous GameTexture node (can be NULL).
- * @return Pointer to the newly created GameTexture node, or NULL on failure.
+ * @param list Pointer to the GameTextures list to destroy.
  */
 void destroyTexturesList(GameTextures *list);
 
 /**
  * @brief Creates and initializes a new GameTextures list.
  *
+ * Loads every particle texture, packs them into a single atlas and fills the
+ * UV table, so particle renderers can share one GL texture.
+ *
  * @return Pointer to the newly created GameTextures list, or NULL on failure.
  */
 GameTextures *createGameTexturesList(void);
 
 /**
- * @brief Frees all textures and nodes in the GameTextures list.
+ * @brief Retrieves a texture node by its unique ID.
  *
- * @param list Pointer to the GameTextures list to destroy.
+ * @param list Pointer to the GameTextures list.
+ * @param id The unique identifier of the texture to retrieve.
+ * @return Pointer to the GameTexture node with the specified ID, or NULL if not found.
  */
-GameTexture *getGameTextureById(GameTextures *list, int id);
\ No newline at end of file
+GameTexture *getGameTextureById(GameTextures *list, int id);
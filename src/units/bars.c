@@ -1,4 +1,6 @@
 #include "bars.h"
+#include "../game/clock.h"
+#include "../utils/resolution.h"
 #include "player.h"
 #include "raylib.h"
 #include "unit.h"
@@ -9,25 +11,22 @@
 #include <stdlib.h>
 
 /**
- * @brief Draws health and energy bars above all units in the provided list.
+ * @brief Draws health and energy bars above the live units in the provided
+ * list.
  *
  * Each unit's health and energy are represented as colored bars positioned
- * above the unit in 3D space, oriented to face the camera.
+ * above the unit in 3D space, oriented to face the camera. Dying units have
+ * no bars.
  *
  * @param list Pointer to the UnitList containing units to draw bars for.
  * @param camera Pointer to the active Camera3D for view/projection.
  */
 void drawUnitsStateBars(UnitList *list, Camera3D *camera)
 {
-  UnitNode *node = list->head;
-  for (int i = 0; i < list->length; i += 1)
+  for (uint16_t i = 0; i < list->live_count; i += 1)
   {
-    if (!node)
-    {
-      break;
-    }
-    drawUnitStateBars(&node->self, camera);
-    node = node->next;
+    uint16_t slot = list->live[i];
+    drawUnitStateBars(&list->units[slot], &list->cold[slot], camera);
   }
 }
 
@@ -38,13 +37,14 @@ void drawUnitsStateBars(UnitList *list, Camera3D *camera)
  * to face the camera. Health is shown in red, energy in blue.
  *
  * @param bounding_box The bounding box above which to draw the bars.
- * @param state Pointer to the UnitState containing health and energy info.
+ * @param health_rate Health left, 0 to 1.
+ * @param energy_rate Energy left, 0 to 1.
  * @param camera Pointer to the active Camera3D for view/projection.
  */
-void drawStateBars(BoundingBox bounding_box, UnitState *state,
-                   Camera3D *camera)
+void drawStateBars(BoundingBox bounding_box, float health_rate,
+                   float energy_rate, Camera3D *camera)
 {
-  if (state == NULL || camera == NULL)
+  if (camera == NULL)
   {
     return;
   }
@@ -53,19 +53,20 @@ void drawStateBars(BoundingBox bounding_box, UnitState *state,
                          bounding_box.max.y,
                          (bounding_box.min.z + bounding_box.max.z) * 0.5f};
 
-  Vector2 screenTop = GetWorldToScreen(worldCenter, *camera);
+  Vector2 screenTop =
+      GetWorldToScreenEx(worldCenter, *camera, render_width, render_height);
 
   Vector3 worldLeft = {bounding_box.min.x, bounding_box.max.y, worldCenter.z};
   Vector3 worldRight = {bounding_box.max.x, bounding_box.max.y, worldCenter.z};
-  Vector2 screenLeft = GetWorldToScreen(worldLeft, *camera);
-  Vector2 screenRight = GetWorldToScreen(worldRight, *camera);
+  Vector2 screenLeft =
+      GetWorldToScreenEx(worldLeft, *camera, render_width, render_height);
+  Vector2 screenRight =
+      GetWorldToScreenEx(worldRight, *camera, render_width, render_height);
   float bar_width_px = fabsf(screenRight.x - screenLeft.x);
 
   int x = (int)(screenTop.x - bar_width_px / 2.0f);
   int y = (int)(screenTop.y - STATE_BAR_Y_OFFSET);
 
-  float health_rate = (float)state->health / (float)state->init_health;
-  float energy_rate = (float)state->energy / (float)state->init_energy;
   DrawRectangle(x, y, (int)(bar_width_px * health_rate), STATE_BAR_HEIGHT, RED);
   DrawRectangle(x, y - STATE_BAR_HEIGHT - 1, (int)(bar_width_px * energy_rate),
                 STATE_BAR_HEIGHT, BLUE);
@@ -78,27 +79,30 @@ void drawStateBars(BoundingBox bounding_box, UnitState *state,
  * the camera. Health is shown in green, energy in blue.
  *
  * @param unit Pointer to the Unit for which to draw the bars.
+ * @param cold Pointer to the cold record of the unit.
  * @param camera Pointer to the active Camera3D for view/projection.
  */
-void drawUnitStateBars(Unit *unit, Camera3D *camera)
+void drawUnitStateBars(Unit *unit, UnitCold *cold, Camera3D *camera)
 {
-  if (unit == NULL || camera == NULL)
+  if (unit == NULL || cold == NULL || camera == NULL)
   {
     return;
   }
 
-  double current = GetTime();
+  double current = clockNow();
 
   bool hit = current > STATE_BAR_HIT_SEN_TIME &&
-             current - unit->state.hit_time < STATE_BAR_HIT_SEN_TIME;
+             current - cold->hit_time < STATE_BAR_HIT_SEN_TIME;
 
   if (!hit)
   {
     return;
   }
 
-  BoundingBox bounding_box = getUnitBoundingBox(unit);
-  drawStateBars(bounding_box, &unit->state, camera);
+  BoundingBox bounding_box = getUnitBoundingBox(unit, cold);
+  drawStateBars(bounding_box,
+                (float)unit->state.health / (float)cold->init_health,
+                (float)unit->state.energy / (float)cold->init_energy, camera);
 }
 
 void drawPlayerStateBars(Player *player, Camera3D *camera)
@@ -108,7 +112,7 @@ void drawPlayerStateBars(Player *player, Camera3D *camera)
     return;
   }
 
-  double current = GetTime();
+  double current = clockNow();
 
   bool hit = current > STATE_BAR_HIT_SEN_TIME &&
              current - player->state.hit_time < STATE_BAR_HIT_SEN_TIME;
@@ -120,5 +124,8 @@ void drawPlayerStateBars(Player *player, Camera3D *camera)
 
   BoundingBox bounding_box = getPlayerBoundingBox(player);
 
-  drawStateBars(bounding_box, &player->state, camera);
+  drawStateBars(bounding_box,
+                (float)player->state.health / (float)player->state.init_health,
+                (float)player->state.energy / (float)player->state.init_energy,
+                camera);
 }
@@ -13,10 +13,12 @@
 #define STATE_BAR_Y_OFFSET 12
 
 /**
- * @brief Draws health and energy bars above all units in the provided list.
+ * @brief Draws health and energy bars above the live units in the provided
+ * list.
  *
  * Each unit's health and energy are represented as colored bars positioned
- * above the unit in 3D space, oriented to face the camera.
+ * above the unit in 3D space, oriented to face the camera. Dying units have
+ * no bars.
  *
  * @param list Pointer to the UnitList containing units to draw bars for.
  * @param camera Pointer to the active Camera3D for view/projection.
@@ -30,9 +32,10 @@ void drawUnitsStateBars(UnitList *list, Camera3D *camera);
  * the camera. Health is shown in green, energy in blue.
  *
  * @param unit Pointer to the Unit for which to draw the bars.
+ * @param cold Pointer to the cold record of the unit.
  * @param camera Pointer to the active Camera3D for view/projection.
  */
-void drawUnitStateBars(Unit *unit, Camera3D *camera);
+void drawUnitStateBars(Unit *unit, UnitCold *cold, Camera3D *camera);
 
 /**
  * @brief Draws health and energy bars above the player unit.
@@ -2,8 +2,27 @@
 
 #include "explosion.h"
 #include "raymath.h"
+#include "../render/billboard.h"
+#include "../render/fillrate.h"
+#include "../render/particlelod.h"
+#include "../utils/packed.h"
+#include "../utils/profiler.h"
+#include "../utils/vecmath.h"
 #include "rlgl.h"
 #include <math.h>
+#include <stdlib.h>
+
+/// Fire particles of a full burst.
+#define EXP_FIRE_COUNT 100
+
+/// Smoke particles of a full burst.
+#define EXP_SMOKE_COUNT 80
+
+/// Spark particles of a full burst.
+#define EXP_SPARK_COUNT 60
+
+// Draw the per-particle glow halos.
+bool explosion_halos_enabled = true;
 
 // Simple random float in [a, b]
 static inline float frand(float a, float b)
@@ -21,20 +40,68 @@ static inline Vector3 randInSphere(float vmin, float vmax)
   return (Vector3){r * st * cosf(th), r * ct, r * st * sinf(th)};
 }
 
+/**
+ * @brief Returns the color of a particle at the given age.
+ *
+ * @param kind Particle type.
+ * @param t Elapsed fraction of the lifespan, 0..1.
+ * @return Fire and sparks cool from yellow to red, smoke fades out.
+ */
+Color expParticleColor(ExpKind kind, float t)
+{
+  if (kind == EXP_FIRE || kind == EXP_SPARK)
+  {
+    float hue = 50.0f + (5.0f - 50.0f) * t;
+    Color c = ColorFromHSV(hue, 0.95f, 1.0f);
+    unsigned char a = (unsigned char)(255.0f * powf(1.0f - t, 0.4f));
+    return (Color){c.r, c.g, c.b, a};
+  }
+  unsigned char a = (unsigned char)(200.0f * (1.0f - t));
+  int g = (int)(160 + 20 * t);
+  return (Color){(unsigned char)g, (unsigned char)g, (unsigned char)g, a};
+}
+
+/**
+ * @brief Encodes a freshly spawned particle into the compact layout.
+ *
+ * @param q Particle to fill.
+ * @param kind Particle type.
+ * @param pos Spawn position.
+ * @param vel Initial velocity.
+ * @param size Initial size.
+ * @param rot Rotation in degrees.
+ * @param ttl Total lifespan in seconds.
+ * @param color Initial color.
+ */
+static void expParticleInit(ExpParticle *q, ExpKind kind, Vector3 pos,
+                            Vector3 vel, float size, float rot, float ttl,
+                            Color color)
+{
+  float motion[4] = {vel.x, vel.y, vel.z, size};
+  q->pos = pos;
+  floatToHalf4(motion, q->motion);
+  q->life = (uint16_t)PACKED_LIFE_FULL;
+  q->ttl = floatToHalf(ttl);
+  q->rot = packRotation(rot);
+  q->kind = (uint8_t)kind;
+  q->color = color;
+}
+
 /**
  * @brief Creates and initializes a new BulletExplosion instance.
  *
  * This function sets up a BulletExplosion with default parameters for
- * gravity, damping, back drift, and particle carry factors. The provided
- * textures for fire, smoke, and glow are assigned to the explosion.
+ * gravity, damping, back drift, and particle carry factors. Fire, smoke and
+ * glow are sub-rectangles of the shared particle atlas.
  *
- * @param fire Texture for fire particles.
- * @param smoke Texture for smoke particles.
- * @param glow Texture for glow halo (optional).
+ * @param atlas Particle atlas containing all explosion textures.
+ * @param fire Sub-rectangle of the fire texture in the atlas.
+ * @param smoke Sub-rectangle of the smoke texture in the atlas.
+ * @param glow Sub-rectangle of the glow halo (zero width disables it).
  * @return A fully initialized BulletExplosion object.
  */
-BulletExplosion newBulletExplosion(Texture2D fire, Texture2D smoke,
-                                   Texture2D glow)
+BulletExplosion newBulletExplosion(Texture2D atlas, Rectangle fire,
+                                   Rectangle smoke, Rectangle glow)
 {
   BulletExplosion e = {0};
   e.active = false;
@@ -49,9 +116,10 @@ BulletExplosion newBulletExplosion(Texture2D fire, Texture2D smoke,
   e.carryFire = 0.20f;
   e.carrySpark = 0.10f;
 
-  e.texFire = fire;
-  e.texSmoke = smoke;
-  e.texGlow = glow;
+  e.atlas = atlas;
+  e.srcFire = fire;
+  e.srcSmoke = smoke;
+  e.srcGlow = glow;
   return e;
 }
 
@@ -76,50 +144,50 @@ void bulletExplosionSpawnAt(BulletExplosion *e, Vector3 origin,
   Vector3 forward =
       Vector3Normalize(Vector3Subtract(cam->target, cam->position));
 
+  // distant bursts spawn fewer particles (see render/particlelod.h)
+  ParticleLod lod = particleLodBegin(cam);
+  float rate = particleLodSpawnScale(&lod, origin, 0.5f);
+  int nFire = (int)((float)EXP_FIRE_COUNT * rate);
+  int nSmoke = (int)((float)EXP_SMOKE_COUNT * rate);
+  int nSpark = (int)((float)EXP_SPARK_COUNT * rate);
+  profilerCount(PROFILE_PARTICLES_UNSPAWNED,
+                EXP_FIRE_COUNT + EXP_SMOKE_COUNT + EXP_SPARK_COUNT - nFire -
+                    nSmoke - nSpark);
+
   // FIRE
-  int nFire = 100;
   for (int i = 0; i < nFire && e->count < EXP_MAX; ++i)
   {
-    ExpParticle *q = &e->p[e->count++];
-    q->kind = EXP_FIRE;
-    q->pos = origin;
-    q->vel = Vector3Add(randInSphere(6.0f, 11.0f), Vector3Scale(forward, 2.0f));
-    q->size = frand(0.25f, 0.9f);
-    q->rot = frand(0, 360);
-    q->ttl = frand(0.25f, 0.45f);
-    q->life = q->ttl;
-    q->color = (Color){255, 230, 140, 255};
+    Vector3 vel =
+        Vector3Add(randInSphere(6.0f, 11.0f), Vector3Scale(forward, 2.0f));
+    float size = frand(0.25f, 0.9f);
+    float rot = frand(0, 360);
+    float ttl = frand(0.25f, 0.45f);
+    expParticleInit(&e->p[e->count++], EXP_FIRE, origin, vel, size, rot, ttl,
+                    (Color){255, 230, 140, 255});
   }
 
   // SMOKE
-  int nSmoke = 80;
   for (int i = 0; i < nSmoke && e->count < EXP_MAX; ++i)
   {
-    ExpParticle *q = &e->p[e->count++];
-    q->kind = EXP_SMOKE;
-    q->pos = origin;
-    q->vel = Vector3Add(randInSphere(1.5f, 4.0f), Vector3Scale(forward, 1.5f));
-    q->size = frand(0.35f, 1.0f);
-    q->rot = frand(0, 360);
-    q->ttl = frand(0.9f, 1.6f);
-    q->life = q->ttl;
-    q->color = (Color){180, 180, 180, 220};
+    Vector3 vel =
+        Vector3Add(randInSphere(1.5f, 4.0f), Vector3Scale(forward, 1.5f));
+    float size = frand(0.35f, 1.0f);
+    float rot = frand(0, 360);
+    float ttl = frand(0.9f, 1.6f);
+    expParticleInit(&e->p[e->count++], EXP_SMOKE, origin, vel, size, rot, ttl,
+                    (Color){180, 180, 180, 220});
   }
 
   // SPARKS
-  int nSpark = 60;
   for (int i = 0; i < nSpark && e->count < EXP_MAX; ++i)
   {
-    ExpParticle *q = &e->p[e->count++];
-    q->kind = EXP_SPARK;
-    q->pos = origin;
-    q->vel =
+    Vector3 vel =
         Vector3Add(randInSphere(10.0f, 16.0f), Vector3Scale(forward, 2.5f));
-    q->size = frand(0.08f, 0.7f);
-    q->rot = frand(0, 360);
-    q->ttl = frand(0.35f, 0.7f);
-    q->life = q->ttl;
-    q->color = (Color){255, 200, 60, 255};
+    float size = frand(0.08f, 0.7f);
+    float rot = frand(0, 360);
+    float ttl = frand(0.35f, 0.7f);
+    expParticleInit(&e->p[e->count++], EXP_SPARK, origin, vel, size, rot, ttl,
+                    (Color){255, 200, 60, 255});
   }
 }
 
@@ -149,48 +217,44 @@ void bulletExplosionUpdate(BulletExplosion *e, Vector3 origin, float dt,
   Vector3 originDelta = Vector3Subtract(origin, e->last_origin);
   e->last_origin = origin;
 
+  // Velocity and size share one vector: the size lane gets no gravity, a
+  // damping of 1 and no drift.
+  Vec4 gravity = vec4Set(0.0f, e->gravityY * dt, 0.0f, 0.0f);
+  Vec4 damping = vec4Set(e->damping, e->damping, e->damping, 1.0f);
+  Vec4 push = vec4FromVector3(Vector3Scale(drift, dt), 0.0f);
+  Vec4 shift = vec4FromVector3(originDelta, 0.0f);
+  Vec4 step = vec4Splat(dt);
+
   int w = 0;
   for (int r = 0; r < e->count; ++r)
   {
     ExpParticle *q = &e->p[r];
+    float motion[4];
+    halfToFloat4(q->motion, motion);
 
     // gravity + damping + scene back drift
-    q->vel.y += e->gravityY * dt;
-    q->vel = Vector3Scale(q->vel, e->damping);
-    q->vel = Vector3Add(q->vel, Vector3Scale(drift, dt));
+    Vec4 vel = vec4MulAdd(vec4Add(vec4Load(motion), gravity), damping, push);
 
     // carry by moving ship (smoke follows more than fire/sparks)
     float carry = (q->kind == EXP_SMOKE)  ? e->carrySmoke
                   : (q->kind == EXP_FIRE) ? e->carryFire
                                           : e->carrySpark;
-    q->pos = Vector3Add(q->pos, Vector3Scale(originDelta, carry));
+    Vec4 pos = vec4MulAdd(shift, vec4Splat(carry),
+                          vec4FromVector3(q->pos, 0.0f));
 
     // integrate position and size
-    q->pos = Vector3Add(q->pos, Vector3Scale(q->vel, dt));
+    q->pos = vec4ToVector3(vec4MulAdd(vel, step, pos));
+    vec4Store(vel, motion);
     if (q->kind == EXP_SMOKE)
-      q->size += 0.35f * dt;
+      motion[3] += 0.35f * dt;
     if (q->kind == EXP_FIRE)
-      q->size -= 0.15f * dt;
+      motion[3] -= 0.15f * dt;
 
     // lifetime / color
-    q->life -= dt;
-    if (q->life > 0)
+    if (packedLifeStep(&q->life, dt, halfToFloat(q->ttl)))
     {
-      float t = 1.0f - (q->life / q->ttl); // 0..1
-      if (q->kind == EXP_FIRE || q->kind == EXP_SPARK)
-      {
-        float hue = 50.0f + (5.0f - 50.0f) * t;
-        Color c = ColorFromHSV(hue, 0.95f, 1.0f);
-        unsigned char a = (unsigned char)(255.0f * powf(1.0f - t, 0.4f));
-        q->color = (Color){c.r, c.g, c.b, a};
-      }
-      else
-      {
-        unsigned char a = (unsigned char)(200.0f * (1.0f - t));
-        int g = (int)(160 + 20 * t);
-        q->color =
-            (Color){(unsigned char)g, (unsigned char)g, (unsigned char)g, a};
-      }
+      q->color = expParticleColor((ExpKind)q->kind, packedLifeAge(q->life));
+      floatToHalf4(motion, q->motion);
       e->p[w++] = *q;
     }
   }
@@ -199,60 +263,195 @@ void bulletExplosionUpdate(BulletExplosion *e, Vector3 origin, float dt,
     e->active = false;
 }
 
+/**
+ * @brief Draws or queues one smoke billboard.
+ *
+ * @param e Pointer to the BulletExplosion instance.
+ * @param cam The Camera3D used for rendering the scene.
+ * @param basis Billboard basis of the camera.
+ * @param alpha Transparent pass queue; drawn directly when NULL.
+ * @param uv Normalized smoke rectangle in the atlas.
+ * @param pos Quad center.
+ * @param size Quad side length.
+ * @param rot Rotation in degrees.
+ * @param color Quad color.
+ */
+static void drawSmokeQuad(const BulletExplosion *e, const Camera3D *cam,
+                          const BillboardBasis *basis,
+                          AlphaParticleQueue *alpha, Rectangle uv, Vector3 pos,
+                          float size, float rot, Color color)
+{
+  Vector2 quad = (Vector2){size, size};
+  if (alpha)
+  {
+    alphaQueuePush(alpha, e->atlas.id, pos, quad, rot, uv, color);
+  }
+  else
+  {
+    billboardQuad(basis, pos, quad, rot, uv, color);
+  }
+  profilerCountParticle(cam, pos, size);
+}
+
+/**
+ * @brief Normalizes a sub-rectangle of the atlas to texture coordinates.
+ */
+static Rectangle atlasUv(const BulletExplosion *e, Rectangle src)
+{
+  return (Rectangle){src.x / (float)e->atlas.width,
+                     src.y / (float)e->atlas.height,
+                     src.width / (float)e->atlas.width,
+                     src.height / (float)e->atlas.height};
+}
+
+/**
+ * @brief Draws one additive fire or spark billboard and its glow halo.
+ *
+ * @param e Pointer to the BulletExplosion instance.
+ * @param cam The Camera3D used for rendering the scene.
+ * @param basis Billboard basis of the camera.
+ * @param pos Quad center.
+ * @param size Quad side length.
+ * @param rot Rotation in degrees.
+ * @param color Quad color.
+ */
+static void drawFireQuad(const BulletExplosion *e, const Camera3D *cam,
+                         const BillboardBasis *basis, Vector3 pos, float size,
+                         float rot, Color color)
+{
+  billboardQuad(basis, pos, (Vector2){size, size}, rot,
+                atlasUv(e, e->srcFire), color);
+  profilerCountParticle(cam, pos, size);
+  if (explosion_halos_enabled && e->srcGlow.width > 0.0f)
+  {
+    float gs = size * 1.6f;
+    Color gcol = (Color){255, 255, 255, (unsigned char)(color.a * 0.35f)};
+    billboardQuad(basis, pos, (Vector2){gs, gs}, 0.0f,
+                  atlasUv(e, e->srcGlow), gcol);
+    profilerCountParticle(cam, pos, gs);
+  }
+}
+
 /**
  * @brief Renders all active explosion particles using the specified camera.
  *
  * This function draws each particle as a billboarded quad using the
- * appropriate texture based on its type (fire, smoke, spark). The blending
- * mode is set to alpha for smoke and additive for fire/sparks and glow.
+ * appropriate texture based on its type (fire, smoke, spark). Smoke is
+ * alpha-blended and queued for the depth-sorted transparent pass; fire,
+ * sparks and glow are additive and drawn right away. Sub-pixel particles are
+ * skipped and tiny ones merged (see render/particlelod.h).
  *
  * @param e Pointer to the BulletExplosion instance.
  * @param cam The Camera3D used for rendering the scene.
+ * @param alpha Transparent pass queue; smoke is drawn unsorted when NULL.
  */
-void bulletExplosionDraw(BulletExplosion *e, Camera3D cam)
+void bulletExplosionDraw(BulletExplosion *e, Camera3D cam,
+                         AlphaParticleQueue *alpha)
 {
   if (!e || e->count == 0)
     return;
 
-  Rectangle sFire = {0, 0, (float)e->texFire.width, (float)e->texFire.height};
-  Rectangle sSmoke = {0, 0, (float)e->texSmoke.width,
-                      (float)e->texSmoke.height};
-  Rectangle sGlow = {0, 0, (float)e->texGlow.width, (float)e->texGlow.height};
-  Vector3 up = (Vector3){0, 1, 0};
+  ParticleLod lod = particleLodBegin(&cam);
+  BillboardBasis basis = billboardBasis(&cam);
+  ParticleMerge merge = {0};
+  Vector3 pos;
+  float size;
+  Color color;
 
-  // smoke first (alpha)
-  BeginBlendMode(BLEND_ALPHA);
+  profilerGpuBegin(PROFILE_GPU_EXPLOSIONS);
+  // smoke (alpha): sorted with every other emitter's smoke
+  Rectangle smoke_uv = atlasUv(e, e->srcSmoke);
+  if (!alpha)
+  {
+    fillRateBlendBegin(BLEND_ALPHA);
+    billboardBegin(e->atlas.id);
+  }
   for (int i = 0; i < e->count; ++i)
     if (e->p[i].kind == EXP_SMOKE)
     {
       ExpParticle *q = &e->p[i];
-      Vector2 size = (Vector2){q->size, q->size};
-      Vector2 org = (Vector2){q->size * 0.5f, q->size * 0.5f};
-      DrawBillboardPro(cam, e->texSmoke, sSmoke, q->pos, up, size, org, q->rot,
-                       q->color);
+      float q_size = halfToFloat(q->motion[3]);
+      switch (particleLodFilter(&lod, &merge, q->pos, q_size, q->color))
+      {
+      case PARTICLE_LOD_DRAW:
+        drawSmokeQuad(e, &cam, &basis, alpha, smoke_uv, q->pos, q_size,
+                      unpackRotation(q->rot), q->color);
+        break;
+      case PARTICLE_LOD_MERGED:
+        particleMergeTake(&merge, &pos, &size, &color);
+        drawSmokeQuad(e, &cam, &basis, alpha, smoke_uv, pos, size, 0.0f,
+                      color);
+        break;
+      default:
+        break;
+      }
     }
-  EndBlendMode();
+  if (merge.count > 0)
+  {
+    particleMergeTake(&merge, &pos, &size, &color);
+    drawSmokeQuad(e, &cam, &basis, alpha, smoke_uv, pos, size, 0.0f, color);
+  }
+  if (!alpha)
+  {
+    billboardEnd();
+    fillRateBlendEnd();
+  }
 
   // fire/sparks + halo (additive)
-  BeginBlendMode(BLEND_ADDITIVE);
+  fillRateBlendBegin(BLEND_ADDITIVE);
+  billboardBegin(e->atlas.id);
   for (int i = 0; i < e->count; ++i)
     if (e->p[i].kind != EXP_SMOKE)
     {
       ExpParticle *q = &e->p[i];
-      Vector2 size = (Vector2){q->size, q->size};
-      Vector2 org = (Vector2){q->size * 0.5f, q->size * 0.5f};
-      DrawBillboardPro(cam, e->texFire, sFire, q->pos, up, size, org, q->rot,
-                       q->color);
-      if (e->texGlow.id)
+      float q_size = halfToFloat(q->motion[3]);
+      switch (particleLodFilter(&lod, &merge, q->pos, q_size, q->color))
       {
-        float gs = q->size * 1.6f;
-        Vector2 gsz = (Vector2){gs, gs};
-        Vector2 gor = (Vector2){gs * 0.5f, gs * 0.5f};
-        Color gcol =
-            (Color){255, 255, 255, (unsigned char)(q->color.a * 0.35f)};
-        DrawBillboardPro(cam, e->texGlow, sGlow, q->pos, up, gsz, gor, 0.0f,
-                         gcol);
+      case PARTICLE_LOD_DRAW:
+        drawFireQuad(e, &cam, &basis, q->pos, q_size,
+                     unpackRotation(q->rot), q->color);
+        break;
+      case PARTICLE_LOD_MERGED:
+        particleMergeTake(&merge, &pos, &size, &color);
+        drawFireQuad(e, &cam, &basis, pos, size, 0.0f, color);
+        break;
+      default:
+        break;
       }
     }
-  EndBlendMode();
+  if (merge.count > 0)
+  {
+    particleMergeTake(&merge, &pos, &size, &color);
+    drawFireQuad(e, &cam, &basis, pos, size, 0.0f, color);
+  }
+  billboardEnd();
+  fillRateBlendEnd();
+  profilerGpuEnd(PROFILE_GPU_EXPLOSIONS);
+}
+
+/**
+ * @brief Registers a one-frame point light for a burning explosion.
+ *
+ * The intensity follows the share of fire and spark particles still alive,
+ * so the light fades together with the visible flash.
+ *
+ * @param e Pointer to the BulletExplosion instance.
+ * @param lights Pointer to the light manager (may be NULL).
+ */
+void bulletExplosionEmitLight(const BulletExplosion *e, LightManager *lights)
+{
+  if (!e || !lights || e->count == 0)
+    return;
+
+  int burning = 0;
+  for (int i = 0; i < e->count; ++i)
+    if (e->p[i].kind != EXP_SMOKE)
+      burning++;
+  if (burning == 0)
+    return;
+
+  float share =
+      fminf((float)burning / (float)(EXP_FIRE_COUNT + EXP_SPARK_COUNT), 1.0f);
+  lightsAddFrameLight(lights, e->last_origin, (Color){255, 170, 80, 255},
+                      3.0f * share, 14.0f);
 }
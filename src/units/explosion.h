@@ -1,10 +1,16 @@
 // explosion.h
 
 #pragma once
+#include "../render/alphaqueue.h"
+#include "../render/lights.h"
 #include "raylib.h"
+#include <stdint.h>
 
 #define EXP_MAX 256
 
+// Draw the per-particle glow halos; turned off while bloom provides glow.
+extern bool explosion_halos_enabled;
+
 /**
  * @brief Different kinds of explosion particles.
  */
@@ -16,15 +22,18 @@ typedef enum
 } ExpKind;
 
 /**
- * @brief Represents a single explosion particle.
+ * @brief Represents a single explosion particle in 32 bytes, two per cache
+ * line (see utils/packed.h for the encodings).
  */
 typedef struct
 {
-  Vector3 pos, vel; /// position and velocity
-  float size, rot;  /// size and rotation
-  float life, ttl;  /// remaining life and total lifespan
-  ExpKind kind;     /// particle type (fire, smoke, spark)
-  Color color;      /// color with alpha
+  Vector3 pos;        /// position
+  uint16_t motion[4]; /// half floats: velocity xyz, size
+  uint16_t life;      /// remaining life, PACKED_LIFE_FULL at spawn
+  uint16_t ttl;       /// half float total lifespan (seconds)
+  uint8_t rot;        /// rotation index, 256 steps per turn
+  uint8_t kind;       /// ExpKind (fire, smoke, spark)
+  Color color;        /// color with alpha
 } ExpParticle;
 
 /**
@@ -43,21 +52,23 @@ typedef struct
   float carrySmoke;       /// how much smoke follows moving ship [0..1]
   float carryFire;        /// how much fire follows
   float carrySpark;       /// how much sparks follow
-  Texture2D texFire;      /// fire texture
-  Texture2D texSmoke;     /// smoke texture
-  Texture2D texGlow;      // optional halo
+  Texture2D atlas;        /// particle atlas shared by all textures below
+  Rectangle srcFire;      /// fire sub-rectangle in the atlas
+  Rectangle srcSmoke;     /// smoke sub-rectangle in the atlas
+  Rectangle srcGlow;      /// optional halo (zero width = no halo)
 } BulletExplosion;
 
 /**
  * @brief Creates and initializes a new BulletExplosion instance.
  *
- * @param fire Texture for fire particles.
- * @param smoke Texture for smoke particles.
- * @param glow Texture for glow/halo effect (can be white).
+ * @param atlas Particle atlas containing all explosion textures.
+ * @param fire Sub-rectangle of the fire texture in the atlas.
+ * @param smoke Sub-rectangle of the smoke texture in the atlas.
+ * @param glow Sub-rectangle of the glow/halo texture (zero width disables).
  * @return A fully initialized BulletExplosion object.
  */
-BulletExplosion newBulletExplosion(Texture2D fire, Texture2D smoke,
-                                   Texture2D glow);
+BulletExplosion newBulletExplosion(Texture2D atlas, Rectangle fire,
+                                   Rectangle smoke, Rectangle glow);
 /**
  * @brief Spawns a burst of explosion particles at the specified origin.
  *
@@ -92,10 +103,36 @@ void bulletExplosionUpdate(BulletExplosion *e, Vector3 origin, float dt,
  * using the appropriate texture based on the particle type. It also applies
  * color and transparency effects based on the particle's remaining life.
  *
+ * Smoke is alpha-blended and goes into the shared transparent pass, where it
+ * is depth-sorted against every other emitter; additive fire and sparks are
+ * order-independent and drawn immediately.
+ *
  * @param e Pointer to the BulletExplosion instance.
  * @param cam The Camera3D used for rendering the scene.
+ * @param alpha Transparent pass queue; smoke is drawn unsorted when NULL.
+ */
+void bulletExplosionDraw(BulletExplosion *e, Camera3D cam,
+                         AlphaParticleQueue *alpha);
+
+/**
+ * @brief Registers a one-frame point light for a burning explosion.
+ *
+ * The intensity follows the share of fire and spark particles still alive,
+ * so the light fades together with the visible flash.
+ *
+ * @param e Pointer to the BulletExplosion instance.
+ * @param lights Pointer to the light manager (may be NULL).
+ */
+void bulletExplosionEmitLight(const BulletExplosion *e, LightManager *lights);
+
+/**
+ * @brief Returns the color of a particle at the given age.
+ *
+ * @param kind Particle type.
+ * @param t Elapsed fraction of the lifespan, 0..1.
+ * @return Fire and sparks cool from yellow to red, smoke fades out.
  */
-void bulletExplosionDraw(BulletExplosion *e, Camera3D cam);
+Color expParticleColor(ExpKind kind, float t);
 
 /**
  * @brief Frees all memory used by the BulletExplosion instance.
@@ -5,9 +5,15 @@
  */
 #include "player.h"
 #include "../bullets/bullets.h"
+#include "../game/clock.h"
+#include "../game/events.h"
+#include "../game/input.h"
 #include "../game/levels.h"
+#include "../render/debugdraw.h"
+#include "../render/fillrate.h"
 #include "../textures/textures.h"
 #include "../utils/debug.h"
+#include "../utils/vecmath.h"
 #include "unit.h"
 #include <raylib.h>
 #include <raymath.h>
@@ -90,7 +96,7 @@ PlayerVisualState newPlayerVisualState()
 PlayerMovement newPlayerMovement()
 {
   PlayerMovement movement;
-  movement.last_key_press = GetTime();
+  movement.last_key_press = clockNow();
   movement.acceleration = 0;
   movement.direction_x_key = 0;
   movement.direction_z_key = 0;
@@ -160,22 +166,22 @@ Player *newPlayer(float max_x, float max_y, float max_z, float offset_z,
   player->render = newPlayerRender(max_x, max_y, max_z, offset_z);
   player->model = model;
   player->bullets = bullets;
-  player->hit = NULL;
+  player->hit = SPRITE_ANIM_NONE;
   player->explosion_bullet = newBulletExplosion(
-      tex_fire_soft->tex, tex_smoke_soft->tex, tex_glow->tex);
+      textures->atlas, tex_fire_soft->src, tex_smoke_soft->src, tex_glow->src);
   return player;
 }
 
 // Returns true if the movement direction has changed since the last frame.
 bool directionChanged(Player *player)
 {
-  return (IsKeyDown(KEY_LEFT) &&
+  return (inputDown(INPUT_LEFT) &&
           player->render.movement.direction_x_key != KEY_LEFT) ||
-         (IsKeyDown(KEY_RIGHT) &&
+         (inputDown(INPUT_RIGHT) &&
           player->render.movement.direction_x_key != KEY_RIGHT) ||
-         (IsKeyDown(KEY_UP) &&
+         (inputDown(INPUT_UP) &&
           player->render.movement.direction_z_key != KEY_UP) ||
-         (IsKeyDown(KEY_DOWN) &&
+         (inputDown(INPUT_DOWN) &&
           player->render.movement.direction_z_key != KEY_DOWN);
 }
 
@@ -202,10 +208,10 @@ void updatePlayer(Player *player, Level *level, GameTextures *textures)
   PlayerPosition *position = &player->render.position;
   BulletList *bullets = player->bullets;
 
-  double current_time = GetTime();
+  double current_time = clockNow();
   double elapsed_last_bullet_spawn = current_time - bullets->last_spawn;
 
-  if (IsKeyDown(KEY_SPACE) &&
+  if (inputDown(INPUT_FIRE) &&
       elapsed_last_bullet_spawn > level->player.bullet_delay_spawn)
   {
     Bullet bullet =
@@ -220,8 +226,8 @@ void updatePlayer(Player *player, Level *level, GameTextures *textures)
     insertBulletIntoList(player->bullets, bullet);
     bullets->last_spawn = current_time;
   }
-  if (!(IsKeyDown(KEY_LEFT) || IsKeyDown(KEY_RIGHT) || IsKeyDown(KEY_UP) ||
-        IsKeyDown(KEY_DOWN)))
+  if (!(inputDown(INPUT_LEFT) || inputDown(INPUT_RIGHT) || inputDown(INPUT_UP) ||
+        inputDown(INPUT_DOWN)))
   {
     if (state->rotate_x != 0)
     {
@@ -266,7 +272,7 @@ void updatePlayer(Player *player, Level *level, GameTextures *textures)
     movement->acceleration = ACCELERATION_MAX;
   }
 
-  if (IsKeyDown(KEY_LEFT))
+  if (inputDown(INPUT_LEFT))
   {
     position->x -= movement->acceleration;
     movement->direction_x_key = KEY_LEFT;
@@ -275,7 +281,7 @@ void updatePlayer(Player *player, Level *level, GameTextures *textures)
                           ? -state->max_rotate_z
                           : state->rotate_z;
   }
-  if (IsKeyDown(KEY_RIGHT))
+  if (inputDown(INPUT_RIGHT))
   {
     position->x += movement->acceleration;
     movement->direction_x_key = KEY_RIGHT;
@@ -286,7 +292,7 @@ void updatePlayer(Player *player, Level *level, GameTextures *textures)
   }
   position->x =
       copysignf(fminf(fabsf(position->x), fabsf(position->max_x)), position->x);
-  if (IsKeyDown(KEY_UP))
+  if (inputDown(INPUT_UP))
   {
     position->z -= movement->acceleration;
     movement->direction_z_key = KEY_UP;
@@ -295,7 +301,7 @@ void updatePlayer(Player *player, Level *level, GameTextures *textures)
                           ? state->max_rotate_x
                           : state->rotate_x;
   }
-  if (IsKeyDown(KEY_DOWN))
+  if (inputDown(INPUT_DOWN))
   {
     position->z += movement->acceleration;
     movement->direction_z_key = KEY_DOWN;
@@ -329,38 +335,16 @@ BoundingBox getPlayerBoundingBox(Player *player)
   Vector3 pos = {render->position.x, render->position.y,
                  render->position.z + render->position.offset_z};
 
-  const float hx = box->by_x * 0.5f;
-  const float hy = box->by_y * 0.5f;
-  const float hz = box->by_z * 0.5f;
-
-  Vector3 corners[8] = {
-      {-hx, -hy, -hz},
-      {-hx, -hy, hz},
-      {-hx, hy, -hz},
-      {-hx, hy, hz},
-      {hx, -hy, -hz},
-      {hx, -hy, hz},
-      {hx, hy, -hz},
-      {hx, hy, hz},
-  };
+  const Vector3 half = {box->by_x * 0.5f, box->by_y * 0.5f, box->by_z * 0.5f};
 
   float rx = render->state.rotate_x;
   float ry = render->state.rotate_y;
   float rz = render->state.rotate_z;
 
-  Matrix R = MatrixRotateXYZ((Vector3){rx, ry, rz});
+  AffineMatrix R = affineRotateXYZ((Vector3){rx, ry, rz});
+  R.w = vec4FromVector3(pos, 0.0f);
 
-  Vector3 p0 = Vector3Add(Vector3Transform(corners[0], R), pos);
-  BoundingBox world = {.min = p0, .max = p0};
-
-  for (int i = 1; i < 8; ++i)
-  {
-    Vector3 pw = Vector3Add(Vector3Transform(corners[i], R), pos);
-    world.min = Vector3Min(world.min, pw);
-    world.max = Vector3Max(world.max, pw);
-  }
-
-  return world;
+  return affineTransformBox(&R, Vector3Negate(half), half);
 }
 
 /**
@@ -368,24 +352,27 @@ BoundingBox getPlayerBoundingBox(Player *player)
  *
  * This function updates the player's state, applies hit effects if the
  * player was recently hit, and draws the player's 3D model with appropriate
- * transformations. It also handles rendering of explosion effects and debug
- * bounding boxes if enabled.
+ * transformations. It also advances the hit explosion, drawn later by
+ * drawPlayerEffects, and draws debug bounding boxes if enabled.
  *
  * @param player Pointer to the Player instance to render.
  * @param level Pointer to the current Level containing player parameters.
  * @param textures Pointer to the GameTextures for rendering effects.
  * @param camera Pointer to the active Camera3D for view/projection.
  * @param sprites Pointer to the SpriteSheetList for hit animations.
+ * @param anims Pointer to the pool playing the hit animation.
+ * @param lights Pointer to the light manager (explosion lights, shading).
  */
 void drawPlayer(Player *player, Level *level, GameTextures *textures,
-                Camera3D *camera, SpriteSheetList *sprites)
+                Camera3D *camera, SpriteSheetList *sprites,
+                SpriteAnimPool *anims, LightManager *lights)
 {
   if (!player)
     return;
   updatePlayer(player, level, textures);
 
-  float dt = GetFrameTime();
-  double current = GetTime();
+  float dt = clockDelta();
+  double current = clockNow();
   bool hit = current > BULLET_HIT_SEN_TIME &&
              current - player->state.hit_time < BULLET_HIT_SEN_TIME;
 
@@ -395,16 +382,13 @@ void drawPlayer(Player *player, Level *level, GameTextures *textures,
   if (hit)
   {
     setShipModelColor(player->model, RED);
-    if (!player->hit)
-    {
-      player->hit = newSpriteSheetState(&sprites->tail->self, 1, 3.0f, 0.1f);
-    }
-    dropSpriteSheetState(player->hit);
+    spriteAnimRestartIfIdle(anims, &player->hit, &sprites->tail->self, pos, 1,
+                            3.0f, 0.1f, current);
     bulletExplosionSpawnAt(&player->explosion_bullet, pos, camera);
   }
   bulletExplosionUpdate(&player->explosion_bullet, pos, dt, camera);
-  bulletExplosionDraw(&player->explosion_bullet, *camera);
-  drawSpriteSheetState(player->hit, *camera, pos);
+  bulletExplosionEmitLight(&player->explosion_bullet, lights);
+  spriteAnimSetPosition(anims, player->hit, pos);
 
   Matrix transform = MatrixTranslate(pos.x, pos.y, pos.z);
 
@@ -419,22 +403,40 @@ void drawPlayer(Player *player, Level *level, GameTextures *textures,
   result = MatrixMultiply(result, transform);
   Model model = player->model->model;
   model.transform = result;
+  bindShipModelShader(player->model, lights, pos, hit, false);
+  fillRateModelBegin(model.materials[0].shader.id);
   DrawModel(model, (Vector3){0, 0, 0}, 1.0f, WHITE);
+  fillRateModelEnd();
   if (hit)
   {
     setShipModelColor(player->model, WHITE);
   }
-  if (is_debug_mode)
+  if (debug_draw_layers != 0)
   {
-    if (is_debug_mode && player->model->box_model)
-    {
-      Model box_model = *player->model->box_model;
-      box_model.transform = result;
-      DrawModel(box_model, (Vector3){0, 0, 0}, 1.0f, RED);
-    }
+    debugDrawBox(DEBUG_LAYER_AABB, getPlayerBoundingBox(player), GREEN);
+    debugDrawLabel(DEBUG_LAYER_LABELS, pos,
+                   TextFormat("hp %u en %u", player->state.health,
+                              player->state.energy),
+                   WHITE);
   }
 }
 
+/**
+ * @brief Draws the player's hit explosion; call after every opaque draw of
+ * the frame.
+ *
+ * @param player Pointer to the Player instance.
+ * @param camera Pointer to the active Camera3D for view/projection.
+ * @param alpha Transparent pass queue receiving explosion smoke.
+ */
+void drawPlayerEffects(Player *player, Camera3D *camera,
+                       AlphaParticleQueue *alpha)
+{
+  if (!player)
+    return;
+  bulletExplosionDraw(&player->explosion_bullet, *camera, alpha);
+}
+
 /**
  * @brief Frees the memory allocated for a Player instance.
  *
@@ -479,8 +481,8 @@ bool isPlayerOnFireLine(Unit *enemy, Player *player, float factor)
  * @brief Iterates through enemy units and makes them fire at the player if
  * aligned.
  *
- * This function checks each enemy unit in the provided list to see if the
- * player is within its firing line. If so, and if the unit is able to fire
+ * This function checks each alive enemy unit in the provided list to see if
+ * the player is within its firing line. If so, and if the unit is able to fire
  * based on its cooldown, it spawns a bullet aimed at the player's current
  * position.
  *
@@ -493,85 +495,61 @@ bool isPlayerOnFireLine(Unit *enemy, Player *player, float factor)
 void selectUnitsToFire(UnitList *list, Player *player,
                        Level *level, float factor, GameTextures *textures)
 {
-  UnitNode *node = list->head;
-  for (int i = 0; i < list->length; i += 1)
+  for (uint16_t i = 0; i < list->live_count; i += 1)
   {
-    if (!node)
+    Unit *unit = &list->units[list->live[i]];
+    if (unit->lifecycle != UNIT_ALIVE)
     {
-      break;
+      continue;
     }
-    if (isPlayerOnFireLine(&node->self, player, factor) &&
-        isUnitAbleToFire(list, &node->self))
+    if (isPlayerOnFireLine(unit, player, factor) &&
+        isUnitAbleToFire(list, unit))
     {
-      spawnUnitShoot(player->bullets, &node->self, player->render.position.x,
+      spawnUnitShoot(player->bullets, unit, getUnitCold(list, unit),
+                     player->render.position.x,
                      player->render.position.z +
                          player->render.position.offset_z,
                      level, textures);
     }
-    node = node->next;
   }
 }
 
 /**
- * @brief Checks for collisions between player and enemy bullets, applying
- * damage if hit.
+ * @brief Applies an enemy bullet hit found by the collision query to the
+ * player.
  *
- * This function iterates through the global bullet list, checking for
- * collisions with the player's bounding box. If a collision is detected,
- * the bullet is marked as inactive, and the player's health and energy are
- * reduced based on the bullet's parameters. The function also updates the
- * game statistics to record the hit.
+ * Queues the bullet for destruction, reduces the player's health and energy
+ * based on the bullet's parameters and emits a GAME_EVENT_PLAYER_HIT.
  *
  * @param player Pointer to the Player instance.
- * @param bullets Pointer to the global BulletList containing all bullets.
- * @param stat Pointer to the GameStat for recording hits.
+ * @param bullets Pointer to the global BulletList owning the bullet.
+ * @param node Pointer to the node of the bullet.
  */
-void checkBulletHitsPlayer(Player *player, BulletList *bullets,
-                           GameStat *stat)
+void applyBulletHitToPlayer(Player *player, BulletList *bullets,
+                            BulletNode *node)
 {
-  if (!player || !bullets || !stat)
+  Bullet *bullet = &node->self;
+  BulletPosition position = bulletPositionAt(bullet, bullets->tick);
+  destroyBulletLater(bullets, node);
+  if (player->state.health > 0)
   {
-    return;
+    player->state.health =
+        (player->state.health > bullet->params.health)
+            ? (uint8_t)(player->state.health - bullet->params.health)
+            : 0u;
   }
-
-  BoundingBox playerBox = getPlayerBoundingBox(player);
-
-  BulletNode *node = bullets->head;
-  while (node)
+  if (player->state.energy > 0)
   {
-    Bullet *bullet = &node->self;
-    if (!bullet->alive || bullet->owner != BULLET_OWNER_UNIT)
-    {
-      node = node->next;
-      continue;
-    }
-
-    BoundingBox bulletBox = getBulletBoundingBox(bullet);
-
-    if (CheckCollisionBoxes(playerBox, bulletBox))
-    {
-      bullet->alive = false;
-      if (player->state.health > 0)
-      {
-        player->state.health =
-            (player->state.health > bullet->params.health)
-                ? (uint8_t)(player->state.health - bullet->params.health)
-                : 0u;
-      }
-      if (player->state.energy > 0)
-      {
-        player->state.energy =
-            (player->state.energy > bullet->params.energy)
-                ? (uint8_t)(player->state.energy - bullet->params.energy)
-                : 0u;
-      }
-      player->state.hit_time = GetTime();
-      addShootIntoGameStat(stat);
-      TraceLog(LOG_INFO, "[Player] HIT! health = %u", player->state.health);
-    }
-
-    node = node->next;
+    player->state.energy =
+        (player->state.energy > bullet->params.energy)
+            ? (uint8_t)(player->state.energy - bullet->params.energy)
+            : 0u;
   }
-
-  removeBullets(bullets);
+  player->state.hit_time = clockNow();
+  gameEventEmit((GameEvent){
+      .type = GAME_EVENT_PLAYER_HIT,
+      .owner = (uint8_t)bullet->owner,
+      .value = player->state.health,
+      .subject = ENTITY_NONE,
+      .position = (Vector3){position.x, position.y, position.z}});
 }
@@ -78,7 +78,7 @@ typedef struct Player
   ShipModel *model;                 /// Pointer to the 3D model used for drawing.
   BulletList *bullets;              /// Reference to the global bullet list used for firing.
   BulletExplosion explosion_bullet; /// Explosion effect when hit.
-  SpriteSheetState *hit;            /// Hit animation state.
+  SpriteAnimHandle hit;             /// Hit animation handle.
 } Player;
 
 /**
@@ -127,17 +127,31 @@ BoundingBox getPlayerBoundingBox(Player *player);
  *
  * This function updates the player's state, applies hit effects if the
  * player was recently hit, and draws the player's 3D model with appropriate
- * transformations. It also handles rendering of explosion effects and debug
- * bounding boxes if enabled.
+ * transformations. It also advances the hit explosion, drawn later by
+ * drawPlayerEffects, and draws debug bounding boxes if enabled.
  *
  * @param player Pointer to the Player instance to render.
  * @param level Pointer to the current Level containing player parameters.
  * @param textures Pointer to the GameTextures for rendering effects.
  * @param camera Pointer to the active Camera3D for view/projection.
  * @param sprites Pointer to the SpriteSheetList for hit animations.
+ * @param anims Pointer to the pool playing the hit animation.
+ * @param lights Pointer to the light manager (explosion lights, shading).
  */
 void drawPlayer(Player *player, Level *level, GameTextures *textures,
-                Camera3D *camera, SpriteSheetList *sprites);
+                Camera3D *camera, SpriteSheetList *sprites,
+                SpriteAnimPool *anims, LightManager *lights);
+
+/**
+ * @brief Draws the player's hit explosion; call after every opaque draw of
+ * the frame.
+ *
+ * @param player Pointer to the Player instance.
+ * @param camera Pointer to the active Camera3D for view/projection.
+ * @param alpha Transparent pass queue receiving explosion smoke.
+ */
+void drawPlayerEffects(Player *player, Camera3D *camera,
+                       AlphaParticleQueue *alpha);
 
 /**
  * @brief Frees the memory allocated for the player instance.
@@ -167,19 +181,18 @@ void selectUnitsToFire(UnitList *list, Player *player,
                        Level *level, float factor, GameTextures *textures);
 
 /**
- * @brief Checks for collisions between player and enemy bullets, applying
- * damage if hit.
+ * @brief Applies an enemy bullet hit found by the collision query to the
+ * player.
  *
- * This function iterates through the global bullet list, checking for
- * collisions with the player's bounding box. If a collision is detected,
- * the bullet is marked as inactive, and the player's health and energy are
- * reduced based on the bullet's parameters. The function also updates the
- * game statistics to record the hit.
+ * The bullet is queued for destruction, the player's health and energy are
+ * reduced based on the bullet's parameters, and a GAME_EVENT_PLAYER_HIT is
+ * emitted.
  *
  * @param player Pointer to the Player instance.
- * @param bullets Pointer to the global BulletList containing all bullets.
- * @param stat Pointer to the GameStat for recording hits.
+ * @param bullets Pointer to the global BulletList owning the bullet.
+ * @param node Pointer to the node of the bullet.
  */
-void checkBulletHitsPlayer(Player *player, BulletList *bullets, GameStat *stat);
+void applyBulletHitToPlayer(Player *player, BulletList *bullets,
+                            BulletNode *node);
 
 #endif
\ No newline at end of file
@@ -5,13 +5,20 @@
  */
 #include "unit.h"
 #include "../bullets/bullets.h"
+#include "../game/clock.h"
+#include "../game/events.h"
 #include "../game/levels.h"
 #include "../game/stat.h"
 #include "../models/models.h"
+#include "../render/debugdraw.h"
+#include "../render/fillrate.h"
+#include "../render/quality.h"
 #include "../movement/movement.h"
 #include "../sprites/sprites.h"
 #include "../textures/textures.h"
 #include "../utils/debug.h"
+#include "../utils/profiler.h"
+#include "../utils/vecmath.h"
 #include "raylib.h"
 #include <math.h>
 #include <raymath.h>
@@ -20,6 +27,7 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 /// Default width (in world units) assigned to all units.
 #define DEFAULT_UNIT_WIDTH 6.0f
@@ -73,8 +81,8 @@ UnitPosition newUnitPosition()
 }
 
 /**
- * @brief Creates a UnitRender structure with default visibility, size, and
- * movement action, based on a given position.
+ * @brief Creates a UnitRender structure with no movement offset, based on a
+ * given position.
  *
  * @param position Initial world position of the unit.
  * @return A fully initialized UnitRender structure.
@@ -83,10 +91,7 @@ UnitRender newUnitRender(UnitPosition position)
 {
   UnitRender render;
   render.position = position;
-  render.size = newUnitSize();
-  render.action = newMovementAction();
-  render.last_frame = 0;
-  render.visible = true;
+  render.offset = (MovementOffset){0.0f, 0.0f, 0.0f};
   return render;
 }
 
@@ -109,16 +114,47 @@ UnitState newUnitState()
 }
 
 /**
- * @brief Constructs a new Unit object with specified type and model.
+ * @brief Initializes and returns UnitVitals with full health and energy.
+ *
+ * @return UnitVitals with default health and energy.
+ */
+UnitVitals newUnitVitals()
+{
+  UnitVitals vitals;
+  vitals.health = DEFAULT_UNIT_HEALTH;
+  vitals.energy = DEFAULT_UNIT_ENERGY;
+  return vitals;
+}
+
+/**
+ * @brief Constructs the hot record of a new unit with specified type.
  *
  * Initializes the internal state, position, and render configuration using
  * default values.
  *
  * @param ty Type of the unit (e.g., player or enemy).
- * @param model Pointer to the ship model used for rendering this unit.
  * @return A fully constructed Unit structure.
  */
-Unit newUnit(UnitType ty, ShipModel *model, GameTextures *textures)
+Unit newUnit(UnitType ty)
+{
+  Unit unit;
+  unit.type = ty;
+  unit.state = newUnitVitals();
+  unit.render = newUnitRender(newUnitPosition());
+  unit.visible = true;
+  unit.handle = ENTITY_NONE;
+  unit.lifecycle = UNIT_SPAWNING;
+  return unit;
+}
+
+/**
+ * @brief Constructs the cold record of a new unit.
+ *
+ * @param model Pointer to the ship model used for rendering this unit.
+ * @param textures Pointer to the game textures for effects.
+ * @return A fully constructed UnitCold structure.
+ */
+UnitCold newUnitCold(ShipModel *model, GameTextures *textures)
 {
   GameTexture *tex_fire_soft = getGameTextureById(textures, TEX_ID_FIRE_SOFT);
   if (tex_fire_soft == NULL)
@@ -138,118 +174,140 @@ Unit newUnit(UnitType ty, ShipModel *model, GameTextures *textures)
     TraceLog(LOG_ERROR, "Fail to find texture: %i", TEX_ID_GLOW);
     exit(1);
   }
-  Unit unit;
-  unit.type = ty;
-  unit.state = newUnitState();
-  unit.render = newUnitRender(newUnitPosition());
-  unit.model = model;
-  unit.explosion_effect = NULL;
-  unit.hit = NULL;
-  unit.explosion_bullet = newBulletExplosion(
-      tex_fire_soft->tex, tex_smoke_soft->tex, tex_glow->tex);
-  return unit;
+  UnitCold cold;
+  cold.model = model;
+  cold.action = newMovementAction();
+  cold.size = newUnitSize();
+  cold.init_health = DEFAULT_UNIT_HEALTH;
+  cold.init_energy = DEFAULT_UNIT_ENERGY;
+  cold.last_frame = 0;
+  cold.hit_time = 0.0;
+  cold.last_shoot = 0.0;
+  cold.explosion_effect = SPRITE_ANIM_NONE;
+  cold.hit = SPRITE_ANIM_NONE;
+  cold.explosion_bullet = newBulletExplosion(
+      textures->atlas, tex_fire_soft->src, tex_smoke_soft->src, tex_glow->src);
+  return cold;
 }
 
 /**
- * @brief Creates a new UnitNode with proper grid-based positioning.
- *
- * Automatically assigns column and line (ln) indices based on the previous node
- * and positions the unit accordingly in a grid layout.
+ * @brief Places a unit in the formation grid, in the cell after the
+ * previously inserted unit.
  *
- * @param prev Pointer to the previous node in the list, or NULL if first.
- * @param unit The Unit instance to store.
+ * @param unit Pointer to the unit to place.
+ * @param prev Pointer to the previously inserted unit, or NULL if first.
  * @param max_col Maximum number of columns in the grid.
  * @param mid_x Horizontal center for centering the grid.
  * @param z_offset Offset to apply to the Z position of the unit.
- * @return Pointer to the allocated UnitNode, or NULL on failure.
  */
-UnitNode *newUnitNode(UnitNode *prev, Unit unit, uint16_t max_col,
+static void placeUnit(Unit *unit, const Unit *prev, uint16_t max_col,
                       float mid_x, float z_offset)
 {
-  UnitNode *node = malloc(sizeof(UnitNode));
-  if (!node)
-  {
-    return NULL;
-  }
   uint16_t prev_ln;
   if (prev)
   {
-    unit.render.position.col = prev->self.render.position.col + 1;
-    prev_ln = prev->self.render.position.ln;
+    unit->render.position.col = prev->render.position.col + 1;
+    prev_ln = prev->render.position.ln;
   }
   else
   {
-    unit.render.position.col = 0;
+    unit->render.position.col = 0;
     prev_ln = 0;
   }
-  if (unit.render.position.col == max_col)
+  if (unit->render.position.col == max_col)
   {
-    unit.render.position.ln = prev_ln + 1;
-    unit.render.position.col = 0;
+    unit->render.position.ln = prev_ln + 1;
+    unit->render.position.col = 0;
   }
   else
   {
-    unit.render.position.ln = prev_ln;
+    unit->render.position.ln = prev_ln;
   }
-  unit.render.position.x =
-      (DEFAULT_UNIT_WIDTH + UNIT_SPACE_HORIZONTAL) * unit.render.position.col -
+  unit->render.position.x =
+      (DEFAULT_UNIT_WIDTH + UNIT_SPACE_HORIZONTAL) * unit->render.position.col -
       mid_x;
-  unit.render.position.z =
-      (DEFAULT_UNIT_HEIGHT + UNIT_SPACE_VERTICAL) * unit.render.position.ln -
+  unit->render.position.z =
+      (DEFAULT_UNIT_HEIGHT + UNIT_SPACE_VERTICAL) * unit->render.position.ln -
       z_offset;
-  unit.render.position.y = 0.0f;
-  node->next = NULL;
-  node->prev = prev;
-  node->self = unit;
-  return node;
+  unit->render.position.y = 0.0f;
+}
+
+/**
+ * @brief Releases the slot of a unit.
+ *
+ * @param unit Pointer to the unit to release.
+ */
+static void releaseUnit(Unit *unit)
+{
+  unit->handle = ENTITY_NONE;
 }
 
 /**
- * @brief Destroys a single UnitNode, including its movement action.
+ * @brief Adds a slot to a unit set, keeping the set in ascending order.
  *
- * @param node Pointer to the node to destroy.
+ * @param set Slots of the set.
+ * @param count Number of slots in the set; incremented.
+ * @param slot Slot to add.
  */
-void destroyUnitNode(UnitNode *node)
+static void unitSetInsert(uint16_t *set, uint16_t *count, uint16_t slot)
 {
-  if (node != NULL)
+  uint16_t at = *count;
+  while (at > 0 && set[at - 1] > slot)
   {
-    destroyMovementAction(node->self.render.action);
-    if (node->self.explosion_effect)
-    {
-      destroySpriteSheetState(node->self.explosion_effect);
-    }
-    if (node->self.hit)
+    at--;
+  }
+  memmove(&set[at + 1], &set[at], (size_t)(*count - at) * sizeof(uint16_t));
+  set[at] = slot;
+  *count += 1;
+}
+
+/**
+ * @brief Removes a slot from a unit set, keeping the order of the others.
+ *
+ * @param set Slots of the set.
+ * @param count Number of slots in the set; decremented when found.
+ * @param slot Slot to remove.
+ */
+static void unitSetRemove(uint16_t *set, uint16_t *count, uint16_t slot)
+{
+  for (uint16_t i = 0; i < *count; i++)
+  {
+    if (set[i] == slot)
     {
-      destroySpriteSheetState(node->self.hit);
+      memmove(&set[i], &set[i + 1],
+              (size_t)(*count - i - 1) * sizeof(uint16_t));
+      *count -= 1;
+      return;
     }
-    free(node);
   }
 }
 
 /**
  * @brief Updates the falling animation of a destroyed unit.
  *
- * If the unit's health is zero, its Y and Z positions are adjusted to simulate
+ * If the unit is dying, its Y and Z positions are adjusted to simulate
  * falling. Rotation and oscillation are also applied. When it falls out of
  * range, it's marked invisible.
  *
  * @param unit Pointer to the unit to update.
+ * @param cold Pointer to the cold record of the unit.
  * @param deltaTime Time elapsed since last frame.
  */
-void updateDestroyedUnitFall(Unit *unit, float deltaTime)
+void updateDestroyedUnitFall(Unit *unit, UnitCold *cold, float deltaTime)
 {
-  if (!unit || unit->state.health > 0)
+  if (!unit || !cold || unit->lifecycle != UNIT_DYING)
     return;
 
-  MovementAction *action = unit->render.action;
+  MovementAction *action = &cold->action;
+  MovementOffset *offset = &unit->render.offset;
   UnitPosition *position = &unit->render.position;
 
   position->y -= 40.0f * deltaTime;
 
   position->z -= 50.0f * deltaTime;
 
-  float time = (float) GetTime(); 
-  action->x = 2.5f * sinf(time * 5.0f);
+  float time = (float)clockNow(); 
+  offset->x = 2.5f * sinf(time * 5.0f);
 
   action->rotate_x = 0.0f;
   action->rotate_y = 10.0f;
@@ -261,27 +319,44 @@ void updateDestroyedUnitFall(Unit *unit, float deltaTime)
   {
     action->angle -= 360.0f;
   }
-  if (fabsf(position->z + position->z_offset + action->z) >
+  if (fabsf(position->z + position->z_offset + offset->z) >
       fabsf(position->z_max_area))
   {
-    unit->render.visible = false;
+    unit->visible = false;
   }
 }
 
+/**
+ * @brief Returns the world position of the unit's center, movement included.
+ */
+static Vector3 getUnitCenter(const Unit *unit)
+{
+  const UnitPosition *position = &unit->render.position;
+  const MovementOffset *offset = &unit->render.offset;
+  return (Vector3){position->x + offset->x, position->y + offset->y,
+                   position->z + position->z_offset + offset->z};
+}
+
 /**
  * @brief Renders the unit's model, explosion effects, and hit animations.
  *
  * Handles the drawing of the unit's 3D model, applying hit effects and
  * explosion animations as necessary. Also manages movement updates and debug
- * bounding box rendering.
+ * bounding box rendering. The hit explosion is advanced here and drawn later
+ * by drawUnitsEffects.
  *
  * @param unit Pointer to the Unit to draw.
+ * @param cold Pointer to the cold record of the unit.
  * @param camera Pointer to the active Camera3D for view/projection.
  * @param sprites Pointer to the SpriteSheetList containing explosion models.
+ * @param anims Pointer to the pool playing hit/explosion animations.
+ * @param lights Pointer to the light manager (explosion lights, shading).
  */
-void drawUnit(Unit *unit, Camera3D *camera, SpriteSheetList *sprites)
+void drawUnit(Unit *unit, UnitCold *cold, Camera3D *camera,
+              SpriteSheetList *sprites, SpriteAnimPool *anims,
+              LightManager *lights)
 {
-  if (!unit)
+  if (!unit || !cold)
   {
     return;
   }
@@ -296,68 +371,76 @@ void drawUnit(Unit *unit, Camera3D *camera, SpriteSheetList *sprites)
       unit->render.position.z_offset = 0;
     }
   }
-  double current = GetTime();
+  if (unit->lifecycle == UNIT_SPAWNING && unit->render.position.z_offset >= 0)
+  {
+    unit->lifecycle = UNIT_ALIVE;
+  }
+  double current = clockNow();
   bool hit = current > BULLET_HIT_SEN_TIME &&
-             current - unit->state.hit_time < BULLET_HIT_SEN_TIME;
-  MovementAction *action = unit->render.action;
-  float dt = GetFrameTime();
+             current - cold->hit_time < BULLET_HIT_SEN_TIME;
+  MovementAction *action = &cold->action;
+  MovementOffset *offset = &unit->render.offset;
+  float dt = clockDelta();
   Vector3 origin =
-      (Vector3){position->x + action->x, position->y + action->y + 2.0f,
-                position->z + position->z_offset + action->z + 2.0f};
+      (Vector3){position->x + offset->x, position->y + offset->y + 2.0f,
+                position->z + position->z_offset + offset->z + 2.0f};
   if (hit)
   {
-    setShipModelColor(unit->model, RED);
-    if (!unit->hit)
-    {
-      unit->hit = newSpriteSheetState(&sprites->tail->self, 1, 3.0f, 0.1f);
-    }
-    dropSpriteSheetState(unit->hit);
-    bulletExplosionSpawnAt(&unit->explosion_bullet, origin, camera);
+    setShipModelColor(cold->model, RED);
+    spriteAnimRestartIfIdle(anims, &cold->hit, &sprites->tail->self, origin, 1,
+                            3.0f, 0.1f, current);
+    bulletExplosionSpawnAt(&cold->explosion_bullet, origin, camera);
   }
-  bulletExplosionUpdate(&unit->explosion_bullet,
-                        (Vector3){position->x + action->x,
-                                  position->y + action->y,
-                                  position->z + position->z_offset + action->z},
+  bulletExplosionUpdate(&cold->explosion_bullet,
+                        (Vector3){position->x + offset->x,
+                                  position->y + offset->y,
+                                  position->z + position->z_offset + offset->z},
                         dt, camera);
-  bulletExplosionDraw(&unit->explosion_bullet, *camera);
-  drawSpriteSheetState(unit->hit, *camera, origin);
-  if (unit->state.health == 0)
+  bulletExplosionEmitLight(&cold->explosion_bullet, lights);
+  spriteAnimSetPosition(anims, cold->hit, origin);
+  if (unit->lifecycle == UNIT_DYING)
   {
-    updateDestroyedUnitFall(unit, GetFrameTime());
-    if (!unit->explosion_effect)
-    {
-      unit->explosion_effect =
-          newSpriteSheetState(&sprites->head->self, 3, 20.0f, 1.0f);
-    }
-    if (unit->explosion_effect)
-    {
-      drawSpriteSheetState(
-          unit->explosion_effect, *camera,
-          (Vector3){position->x + action->x, position->y + action->y,
-                    position->z + position->z_offset + action->z});
-    }
+    updateDestroyedUnitFall(unit, cold, clockDelta());
+    // The animation itself is started by applyEventsToUnits on the kill
+    spriteAnimSetPosition(anims, cold->explosion_effect,
+                          getUnitCenter(unit));
   }
   else
   {
-    iterateMovementAction(action, (float)unit->state.energy /
-                                      (float)unit->state.init_energy);
-  }
-  DrawModelEx(unit->model->model,
-              (Vector3){position->x + action->x, position->y + action->y,
-                        position->z + position->z_offset + action->z},
+    iterateMovementAction(action, offset,
+                          (float)unit->state.energy /
+                              (float)cold->init_energy);
+  }
+  bindShipModelShader(cold->model, lights,
+                      (Vector3){position->x + offset->x,
+                                position->y + offset->y,
+                                position->z + position->z_offset + offset->z},
+                      hit, qualityBakesShipLighting());
+  fillRateModelBegin(cold->model->model.materials[0].shader.id);
+  DrawModelEx(cold->model->model,
+              (Vector3){position->x + offset->x, position->y + offset->y,
+                        position->z + position->z_offset + offset->z},
               (Vector3){action->rotate_x, action->rotate_y, action->rotate_z},
               action->angle, (Vector3){1, 1, 1}, hit ? RED : WHITE);
+  fillRateModelEnd();
   if (hit)
   {
-    setShipModelColor(unit->model, WHITE);
+    setShipModelColor(cold->model, WHITE);
   }
-  if (is_debug_mode && unit->model->box_model)
+  if (debug_draw_layers != 0)
   {
-    DrawModelEx(*unit->model->box_model,
-                (Vector3){position->x + action->x, position->y + action->y,
-                          position->z + position->z_offset + action->z},
-                (Vector3){action->rotate_x, action->rotate_y, action->rotate_z},
-                action->angle, (Vector3){1, 1, 1}, RED);
+    debugDrawBox(DEBUG_LAYER_AABB, getUnitBoundingBox(unit, cold), RED);
+    // Formation slot the unit moves around
+    float cell_w = DEFAULT_UNIT_WIDTH + UNIT_SPACE_HORIZONTAL;
+    float cell_h = DEFAULT_UNIT_HEIGHT + UNIT_SPACE_VERTICAL;
+    debugDrawCell(DEBUG_LAYER_CELLS,
+                  (Vector3){position->x - cell_w / 2, 0.0f,
+                            position->z + position->z_offset - cell_h / 2},
+                  cell_w, cell_h, DARKGREEN);
+    debugDrawLabel(DEBUG_LAYER_LABELS, origin,
+                   TextFormat("%u:%u hp %u", position->ln, position->col,
+                              unit->state.health),
+                   WHITE);
   }
 }
 
@@ -369,56 +452,69 @@ void drawUnit(Unit *unit, Camera3D *camera, SpriteSheetList *sprites)
  * box.
  *
  * @param unit Pointer to the unit.
+ * @param cold Pointer to the cold record of the unit (extents, rotation).
  * @return A BoundingBox in world coordinates.
  */
-BoundingBox getUnitBoundingBox(Unit *unit)
+BoundingBox getUnitBoundingBox(const Unit *unit, const UnitCold *cold)
 {
-  ShipBoundingBox *box = &unit->model->box;
-  UnitRender *render = &unit->render;
-  MovementAction *action = render->action;
+  const ShipBoundingBox *box = &cold->model->box;
+  const MovementAction *action = &cold->action;
 
-  float x = render->position.x + (action ? action->x : 0);
-  float y = render->position.y + (action ? action->y : 0);
-  float z =
-      render->position.z + (action ? action->z : 0) + render->position.z_offset;
+  Vector3 position = getUnitCenter(unit);
 
-  Vector3 position = {x, y, z};
+  Vector3 half = {box->by_x / 2, box->by_y / 2, box->by_z / 2};
 
-  BoundingBox local = {.min = {-box->by_x / 2, -box->by_y / 2, -box->by_z / 2},
-                       .max = {box->by_x / 2, box->by_y / 2, box->by_z / 2}};
+  // Rotate X, then Z, then Y, then move into place
+  AffineMatrix transform = affineTranslate(position);
+  AffineMatrix rotX = affineRotateX(DEG2RAD * action->rotate_x);
+  AffineMatrix rotZ = affineRotateZ(DEG2RAD * action->rotate_z);
+  AffineMatrix rotY = affineRotateY(DEG2RAD * action->rotate_y);
+  AffineMatrix rotXZ = affineThen(&rotX, &rotZ);
+  AffineMatrix rotAll = affineThen(&rotXZ, &rotY);
+  transform = affineThen(&rotAll, &transform);
 
-  Matrix transform = MatrixTranslate(position.x, position.y, position.z);
-  if (action)
+  return affineTransformBox(&transform, Vector3Negate(half), half);
+}
+
+/**
+ * @brief Allocates an empty UnitList with room for a number of units.
+ *
+ * @param capacity Number of slots in the hot and cold tables.
+ * @return Pointer to the allocated UnitList, or NULL on failure.
+ */
+UnitList *newUnitTables(int capacity)
+{
+  if (capacity < 0 || capacity > ENTITY_TABLE_MAX)
   {
-    Matrix rotX = MatrixRotateX(DEG2RAD * action->rotate_x);
-    Matrix rotZ = MatrixRotateZ(DEG2RAD * action->rotate_z);
-    Matrix rotY = MatrixRotateY(DEG2RAD * action->rotate_y);
-    Matrix rotAll = MatrixMultiply(MatrixMultiply(rotX, rotZ), rotY);
-    transform = MatrixMultiply(rotAll, transform);
+    return NULL;
   }
-
-  Vector3 corners[8] = {
-      {local.min.x, local.min.y, local.min.z},
-      {local.min.x, local.min.y, local.max.z},
-      {local.min.x, local.max.y, local.min.z},
-      {local.min.x, local.max.y, local.max.z},
-      {local.max.x, local.min.y, local.min.z},
-      {local.max.x, local.min.y, local.max.z},
-      {local.max.x, local.max.y, local.min.z},
-      {local.max.x, local.max.y, local.max.z},
-  };
-
-  BoundingBox world = {.min = Vector3Transform(corners[0], transform),
-                       .max = Vector3Transform(corners[0], transform)};
-
-  for (int i = 1; i < 8; i++)
+  UnitList *list = malloc(sizeof(UnitList));
+  if (!list)
   {
-    Vector3 transformed = Vector3Transform(corners[i], transform);
-    world.min = Vector3Min(world.min, transformed);
-    world.max = Vector3Max(world.max, transformed);
+    return NULL;
   }
-
-  return world;
+  // calloc(0) may return NULL; an empty list still gets one slot.
+  size_t slots = capacity ? (size_t)capacity : 1;
+  list->length = 0;
+  list->capacity = (uint16_t)capacity;
+  list->tail = NULL;
+  list->live_count = 0;
+  list->dying_count = 0;
+  list->units = calloc(slots, sizeof(Unit));
+  list->cold = calloc(slots, sizeof(UnitCold));
+  list->live = calloc(slots, sizeof(uint16_t));
+  list->dying = calloc(slots, sizeof(uint16_t));
+  if (!list->units || !list->cold || !list->live || !list->dying ||
+      !entityTableInit(&list->handles))
+  {
+    free(list->units);
+    free(list->cold);
+    free(list->live);
+    free(list->dying);
+    free(list);
+    return NULL;
+  }
+  return list;
 }
 
 /**
@@ -438,152 +534,218 @@ BoundingBox getUnitBoundingBox(Unit *unit)
 UnitList *newUnitList(int count, ShipModel *model, uint16_t max_col,
                       float z_offset, GameTextures *textures)
 {
-  UnitList *units = malloc(sizeof(UnitList));
+  UnitList *units = newUnitTables(count);
   if (!units)
   {
     return NULL;
   }
-  units->length = 0;
-  units->head = NULL;
-  units->tail = NULL;
   float unit_full_width = DEFAULT_UNIT_WIDTH + UNIT_SPACE_HORIZONTAL;
 
   float mid_x = (unit_full_width * max_col) / 2.0f - unit_full_width / 2.0f;
   for (int i = count - 1; i >= 0; i -= 1)
   {
-    insertToUnitList(units, newUnit(UNIT_TYPE_ENEMY, model, textures), max_col,
-                     mid_x, z_offset);
+    insertToUnitList(units, newUnit(UNIT_TYPE_ENEMY),
+                     newUnitCold(model, textures), max_col, mid_x, z_offset);
     TraceLog(LOG_INFO, "[Units] Added unit %i", i);
   }
   return units;
 }
 
 /**
- * @brief Removes units from the list that are no longer visible (e.g.,
- * destroyed and fallen).
+ * @brief Returns the cold record of a unit stored in the list.
+ *
+ * @param list Pointer to the UnitList owning the unit.
+ * @param unit Pointer to the hot record of the unit.
+ * @return Pointer to the cold record in the same slot.
+ */
+UnitCold *getUnitCold(UnitList *list, const Unit *unit)
+{
+  return &list->cold[unit - list->units];
+}
+
+/**
+ * @brief Queues a unit for destruction at the end of the tick.
+ *
+ * @param list Pointer to the UnitList owning the unit.
+ * @param unit Pointer to the unit.
+ */
+void destroyUnitLater(UnitList *list, Unit *unit)
+{
+  if (!list || !unit)
+  {
+    return;
+  }
+  entityDestroyLater(&list->handles, unit->handle);
+}
+
+/**
+ * @brief Resolves a unit handle.
  *
- * Frees memory for removed nodes and updates list pointers and length.
+ * @param list Pointer to the UnitList that issued the handle.
+ * @param handle Handle of the unit.
+ * @return The unit, or NULL once the unit has been destroyed.
+ */
+Unit *resolveUnit(UnitList *list, EntityHandle handle)
+{
+  return list ? entityResolve(&list->handles, handle) : NULL;
+}
+
+/**
+ * @brief Destroys the units queued during the tick (destroyed and fallen).
+ *
+ * Drains the destroy queue in one pass: each queued unit releases its slot,
+ * which iteration skips from then on.
  *
  * @param list Pointer to the UnitList to modify.
  */
 void removeUnits(UnitList *list)
 {
-  UnitNode *node = list->head;
-  while (node)
+  Unit *unit;
+  while ((unit = entityTakeDestroyed(&list->handles)))
   {
-    UnitNode *next = node->next;
-
-    if (!node->self.render.visible)
+    if (unit == list->tail)
+    {
+      list->tail = NULL;
+    }
+    uint16_t slot = (uint16_t)(unit - list->units);
+    if (unit->lifecycle == UNIT_DYING || unit->lifecycle == UNIT_DEAD)
+    {
+      unitSetRemove(list->dying, &list->dying_count, slot);
+    }
+    else
     {
-      if (node == list->head)
-      {
-        list->head = node->next;
-      }
-
-      if (node == list->tail)
-      {
-        list->tail = node->prev;
-      }
-
-      if (node->prev)
-      {
-        node->prev->next = node->next;
-      }
-      if (node->next)
-      {
-        node->next->prev = node->prev;
-      }
-
-      destroyUnitNode(node);
-      list->length--;
-
-      TraceLog(LOG_INFO, "[Units] in list: %i", list->length);
+      unitSetRemove(list->live, &list->live_count, slot);
     }
+    releaseUnit(unit);
+    list->length--;
 
-    node = next;
+    TraceLog(LOG_INFO, "[Units] in list: %i", list->length);
   }
 }
 
 /**
- * @brief Frees all memory used by the UnitList and its nodes.
- *
- * Resets head, tail, and length to initial state.
+ * @brief Frees all memory used by the UnitList, its units and the list
+ * itself.
  *
- * @param list Pointer to the UnitList to destroy.
+ * @param list Pointer to the UnitList to destroy. Safe to pass NULL.
  */
 void destroyUnitList(UnitList *list)
 {
-  UnitNode *node = list->head;
-  while (node)
+  if (!list)
   {
-    UnitNode *next = node->next;
-    destroyUnitNode(node);
-    node = next;
+    return;
   }
-  list->head = list->tail = NULL;
-  list->length = 0;
+  for (uint16_t i = 0; i < list->handles.used; i++)
+  {
+    if (list->units[i].handle != ENTITY_NONE)
+    {
+      releaseUnit(&list->units[i]);
+    }
+  }
+  entityTableFree(&list->handles);
+  free(list->units);
+  free(list->cold);
+  free(list->live);
+  free(list->dying);
+  free(list);
 }
 
 /**
- * @brief Inserts a new unit into the UnitList, assigning grid position and
- * links.
+ * @brief Inserts a new unit into the next free slot of the UnitList and
+ * assigns its grid position.
  *
  * @param list Pointer to the list.
- * @param unit Unit instance to insert.
+ * @param unit Hot record of the unit to insert.
+ * @param cold Cold record of the unit to insert.
  * @param max_col Grid column limit.
  * @param mid_x Center offset for positioning units horizontally.
  * @param z_offset Vertical placement offset along Z.
  */
-void insertToUnitList(UnitList *list, Unit unit, uint16_t max_col,
-                      float mid_x, float z_offset)
+void insertToUnitList(UnitList *list, Unit unit, UnitCold cold,
+                      uint16_t max_col, float mid_x, float z_offset)
 {
-  UnitNode *node =
-      newUnitNode(list->tail, unit, max_col, mid_x, z_offset);
-  if (!node)
+  uint16_t index = entityNextSlot(&list->handles);
+  if (index >= list->capacity)
   {
+    TraceLog(LOG_WARNING, "[Units] list is full (%u units)", list->capacity);
     return;
   }
-  if (list->length == 0)
-  {
-    list->head = list->tail = node;
-  }
-  else
+  Unit *slot = &list->units[index];
+  unit.handle = entityAcquire(&list->handles, slot);
+  if (unit.handle == ENTITY_NONE)
   {
-    list->tail->next = node;
-    node->prev = list->tail;
-    list->tail = node;
+    return;
   }
+  placeUnit(&unit, list->tail, max_col, mid_x, z_offset);
+  *slot = unit;
+  list->cold[index] = cold;
+  list->tail = slot;
   list->length += 1;
+  unitSetInsert(list->live, &list->live_count, index);
 }
 
 /**
- * @brief Draws all units in the list and removes any that are no longer
- * visible.
+ * @brief Draws all units in the list and queues the dying ones that fell
+ * out of the scene for destruction at the end of the tick.
  *
  * @param list Pointer to the UnitList to draw.
  * @param camera Pointer to the active Camera3D for view/projection.
  * @param sprites Pointer to the SpriteSheetList containing explosion models.
+ * @param anims Pointer to the pool playing hit/explosion animations.
+ * @param lights Pointer to the light manager (explosion lights, shading).
+ */
+void drawUnits(UnitList *list, Camera3D *camera, SpriteSheetList *sprites,
+               SpriteAnimPool *anims, LightManager *lights)
+{
+  for (uint16_t i = 0; i < list->handles.used; i += 1)
+  {
+    Unit *unit = &list->units[i];
+    if (unit->handle == ENTITY_NONE)
+    {
+      continue;
+    }
+    drawUnit(unit, &list->cold[i], camera, sprites, anims, lights);
+  }
+  for (uint16_t i = 0; i < list->dying_count; i += 1)
+  {
+    Unit *unit = &list->units[list->dying[i]];
+    if (unit->lifecycle == UNIT_DYING && !unit->visible)
+    {
+      unit->lifecycle = UNIT_DEAD;
+      destroyUnitLater(list, unit);
+    }
+  }
+}
+
+/**
+ * @brief Draws the hit explosions of all units.
+ *
+ * Called after every opaque draw of the frame, so the explosions can go to
+ * the reduced-resolution effects target (see effects.h).
+ *
+ * @param list Pointer to the UnitList to draw.
+ * @param camera Pointer to the active Camera3D for view/projection.
+ * @param alpha Transparent pass queue receiving explosion smoke.
  */
-void drawUnits(UnitList *list, Camera3D *camera, SpriteSheetList *sprites)
+void drawUnitsEffects(UnitList *list, Camera3D *camera,
+                      AlphaParticleQueue *alpha)
 {
-  UnitNode *node = list->head;
-  for (int i = 0; i < list->length; i += 1)
+  for (uint16_t i = 0; i < list->handles.used; i += 1)
   {
-    if (!node)
+    if (list->units[i].handle == ENTITY_NONE)
     {
-      break;
+      continue;
     }
-    drawUnit(&node->self, camera, sprites);
-    node = node->next;
+    bulletExplosionDraw(&list->cold[i].explosion_bullet, *camera, alpha);
   }
-  removeUnits(list);
 }
 
 /**
  * @brief Determines if a unit is able to fire based on its position in the
  * formation.
  *
- * A unit can fire if it is in front of all other units in its column.
+ * A unit can fire if it is alive and in front of all other live units in its
+ * column.
  *
  * @param list Pointer to the UnitList containing all units.
  * @param unit Pointer to the specific unit to check.
@@ -591,7 +753,7 @@ void drawUnits(UnitList *list, Camera3D *camera, SpriteSheetList *sprites)
  */
 bool isUnitAbleToFire(UnitList *list, Unit *unit)
 {
-  if (!list || !unit)
+  if (!list || !unit || unit->lifecycle != UNIT_ALIVE)
   {
     return false;
   }
@@ -599,103 +761,114 @@ bool isUnitAbleToFire(UnitList *list, Unit *unit)
   {
     return true;
   }
-  UnitNode *node = list->head;
-  for (int i = 0; i < list->length; i += 1)
+  for (uint16_t i = 0; i < list->live_count; i += 1)
   {
-    if (!node)
-    {
-      break;
-    }
-    if (unit->render.position.col == node->self.render.position.col &&
-        unit->render.position.ln < node->self.render.position.ln)
+    const Unit *other = &list->units[list->live[i]];
+    if (unit->render.position.col == other->render.position.col &&
+        unit->render.position.ln < other->render.position.ln)
     {
       return false;
     }
-    node = node->next;
   }
   unit->render.position.in_front = true;
   return true;
 }
 
 /**
- * @brief Checks for collisions between bullets and a single unit.
+ * @brief Applies a bullet hit found by the collision query to a unit.
  *
- * If a bullet hits the unit, it reduces health and energy, marks the bullet
- * as inactive, and updates the game statistics.
+ * Reduces health and energy and queues the bullet for destruction. Emits a
+ * GAME_EVENT_HIT, followed by a GAME_EVENT_KILL when the hit destroyed the
+ * unit; the unit then leaves the live set for the dying one. A unit that
+ * already died earlier in the tick ignores the hit.
  *
- * @param unit Pointer to the unit to check for hits.
- * @param bullets Pointer to the BulletList containing all active bullets.
- * @param stat Pointer to the GameStat structure to update on hits.
+ * @param list Pointer to the UnitList owning the unit.
+ * @param unit Pointer to the unit that was hit.
+ * @param bullets Pointer to the BulletList owning the bullet.
+ * @param node Pointer to the node of the bullet.
  */
-void checkBulletHitsUnit(Unit *unit, BulletList *bullets, GameStat *stat)
+void applyBulletHitToUnit(UnitList *list, Unit *unit, BulletList *bullets,
+                          BulletNode *node)
 {
-  if (!unit || !bullets)
+  if (unit->lifecycle != UNIT_SPAWNING && unit->lifecycle != UNIT_ALIVE)
+  {
     return;
-
-  BoundingBox unitBox = getUnitBoundingBox(unit);
-
-  BulletNode *node = bullets->head;
-  while (node)
+  }
+  Bullet *bullet = &node->self;
+  destroyBulletLater(bullets, node);
+  if (unit->state.health > 0)
+  {
+    unit->state.health =
+        (unit->state.health > bullet->params.health)
+            ? (uint8_t)(unit->state.health - bullet->params.health)
+            : 0u;
+  }
+  if (unit->state.energy > 0)
+  {
+    unit->state.energy =
+        (unit->state.energy > bullet->params.energy)
+            ? (uint8_t)(unit->state.energy - bullet->params.energy)
+            : 0u;
+  }
+  getUnitCold(list, unit)->hit_time = clockNow();
+  GameEvent event = {.type = GAME_EVENT_HIT,
+                     .owner = (uint8_t)bullet->owner,
+                     .value = unit->state.health,
+                     .subject = unit->handle,
+                     .position = getUnitCenter(unit)};
+  gameEventEmit(event);
+  if (unit->state.health == 0)
   {
-    Bullet *bullet = &node->self;
-    if (!bullet->alive || bullet->owner != BULLET_OWNER_PLAYER)
-    {
-      node = node->next;
-      continue;
-    }
-
-    BoundingBox bulletBox = getBulletBoundingBox(bullet);
-
-    if (CheckCollisionBoxes(unitBox, bulletBox))
-    {
-      bullet->alive = false;
-      if (unit->state.health > 0)
-      {
-        unit->state.health =
-            (unit->state.health > bullet->params.health)
-                ? (uint8_t)(unit->state.health - bullet->params.health)
-                : 0u;
-      }
-      if (unit->state.energy > 0)
-      {
-        unit->state.energy =
-            (unit->state.energy > bullet->params.energy)
-                ? (uint8_t)(unit->state.energy - bullet->params.energy)
-                : 0u;
-      }
-      unit->state.hit_time = GetTime();
-      addHitIntoGameStat(stat);
-      TraceLog(LOG_INFO, "[Units] HIT! health = %u", unit->state.health);
-    }
-
-    node = node->next;
+    uint16_t slot = (uint16_t)(unit - list->units);
+    unit->lifecycle = UNIT_DYING;
+    unitSetRemove(list->live, &list->live_count, slot);
+    unitSetInsert(list->dying, &list->dying_count, slot);
+    event.type = GAME_EVENT_KILL;
+    gameEventEmit(event);
   }
 }
 
 /**
- * @brief Checks for bullet collisions against all units in the list.
+ * @brief Effects consumer of the event queue: starts the destruction
+ * animation and explosion light of every unit killed by the events.
  *
- * Iterates through each unit and checks for hits with bullets. Updates game
- * statistics accordingly and removes inactive bullets after processing.
- *
- * @param units Pointer to the UnitList containing all units.
- * @param bullets Pointer to the BulletList containing all active bullets.
- * @param stat Pointer to the GameStat structure to update on hits.
+ * @param list Pointer to the UnitList the events refer to.
+ * @param events Events of the current tick.
+ * @param count Number of events.
+ * @param sprites Pointer to the SpriteSheetList containing explosion models.
+ * @param anims Pointer to the pool playing the animations.
+ * @param lights Pointer to the light manager receiving explosion lights.
  */
-void checkBulletHitsUnits(UnitList *units, BulletList *bullets,
-                          GameStat *stat)
+void applyEventsToUnits(UnitList *list, const GameEvent *events, size_t count,
+                        SpriteSheetList *sprites, SpriteAnimPool *anims,
+                        LightManager *lights)
 {
-  if (!units || !bullets || !stat)
+  if (!list || !events)
   {
     return;
   }
-  UnitNode *node = units->head;
-  while (node)
+  double current = clockNow();
+  for (size_t i = 0; i < count; i++)
   {
-    checkBulletHitsUnit(&node->self, bullets, stat);
-    node = node->next;
+    if (events[i].type != GAME_EVENT_KILL)
+    {
+      continue;
+    }
+    Unit *unit = resolveUnit(list, events[i].subject);
+    if (!unit)
+    {
+      continue;
+    }
+    UnitCold *cold = getUnitCold(list, unit);
+    if (cold->explosion_effect != SPRITE_ANIM_NONE)
+    {
+      continue;
+    }
+    Vector3 center = getUnitCenter(unit);
+    cold->explosion_effect = spriteAnimStart(
+        anims, &sprites->head->self, center, 3, 20.0f, 1.0f, current);
+    lightsSpawn(lights, center, (Color){255, 150, 60, 255}, 4.0f, 18.0f, 0.8f);
   }
-  removeBullets(bullets);
 }
 
 /**
@@ -704,16 +877,18 @@ void checkBulletHitsUnits(UnitList *units, BulletList *bullets,
  *
  * @param bullets Pointer to the BulletList to add the new bullet to.
  * @param unit Pointer to the Unit that is shooting.
+ * @param cold Pointer to the cold record of the unit (time of the last shot).
  * @param target_x X coordinate of the target position.
  * @param target_z Z coordinate of the target position.
  * @param level Pointer to the current Level for bullet parameters.
  * @param textures Pointer to GameTextures for bullet appearance.
  */
-void spawnUnitShoot(BulletList *bullets, Unit *unit, float target_x,
-                    float target_z, Level *level, GameTextures *textures)
+void spawnUnitShoot(BulletList *bullets, Unit *unit, UnitCold *cold,
+                    float target_x, float target_z, Level *level,
+                    GameTextures *textures)
 {
-  double current_time = GetTime();
-  double elapsed_last_bullet_spawn = current_time - unit->state.last_shoot;
+  double current_time = clockNow();
+  double elapsed_last_bullet_spawn = current_time - cold->last_shoot;
 
   if (elapsed_last_bullet_spawn > level->units.bullet_delay_spawn)
   {
@@ -727,6 +902,6 @@ void spawnUnitShoot(BulletList *bullets, Unit *unit, float target_x,
         BULLET_OWNER_UNIT, target_x, target_z, level->units.bullet_acceleration,
         level->units.bullet_init_speed, textures);
     insertBulletIntoList(bullets, bullet);
-    unit->state.last_shoot = current_time;
+    cold->last_shoot = current_time;
   }
-}
\ No newline at end of file
+}
@@ -9,9 +9,11 @@
 
 #include "../bullets/bullets.h"
 #include "../game/levels.h"
-#include "../game/stat.h"
+#include "../game/events.h"
 #include "../models/models.h"
 #include "../movement/movement.h"
+#include "../render/lights.h"
+#include "../sprites/animation.h"
 #include "../sprites/sprites.h"
 #include "../textures/textures.h"
 #include "explosion.h"
@@ -29,7 +31,23 @@ typedef enum UnitType
 } UnitType;
 
 /**
- * @brief Holds state information for a unit, including health and energy.
+ * @brief Lifecycle of an enemy unit.
+ *
+ * Spawning and alive units are "live": they take part in collision and AI.
+ * A dying unit is only drawn (falling wreck, explosion) until it leaves the
+ * scene and becomes dead; dead units are freed at the end of the tick.
+ */
+typedef enum UnitLifecycle
+{
+  UNIT_SPAWNING = 0, /// Flying into the formation; can be hit, does not fire.
+  UNIT_ALIVE,        /// In the formation.
+  UNIT_DYING,        /// Destroyed, visual only.
+  UNIT_DEAD          /// Fallen out of the scene, queued for destruction.
+} UnitLifecycle;
+
+/**
+ * @brief Holds state information for the player, including health and
+ * energy.
  */
 typedef struct UnitState
 {
@@ -41,6 +59,16 @@ typedef struct UnitState
   double last_shoot;   /// Time of the last bullet spawn.
 } UnitState;
 
+/**
+ * @brief Current health and energy of an enemy unit: the part of its state
+ * a hit changes. The rest of it lives in the cold record.
+ */
+typedef struct UnitVitals
+{
+  uint8_t health; /// Current health value.
+  uint8_t energy; /// Current energy or stamina.
+} UnitVitals;
+
 /**
  * @brief Stores 3D position and grid mapping information for a unit.
  */
@@ -66,33 +94,49 @@ typedef struct UnitSize
 } UnitSize;
 
 /**
- * @brief Combines rendering data and movement logic for a unit.
+ * @brief Where a unit is: its place in the formation and the offset of its
+ * movement around it.
  */
 typedef struct UnitRender
 {
   UnitPosition position; /// Current 3D position and grid placement.
-  UnitSize size;         /// Dimensions used for model scaling and collisions.
-  MovementAction
-      *action;         /// Pointer to the active movement action (can be NULL).
-  uint32_t last_frame; /// Last frame number for animation or update timing.
-  bool visible;        /// Visibility flag for rendering.
+  MovementOffset offset; /// Displacement of the movement action.
 } UnitRender;
 
 /**
- * @brief Represents a complete in-game unit, including type, state, rendering,
- * and model.
+ * @brief Hot part of an in-game unit: everything simulation and collision
+ * read every tick, packed into one cache line (56 bytes on x86-64).
  */
 typedef struct Unit
 {
-  UnitType type;                      /// Type of the unit (player or enemy).
-  UnitState state;                    /// Health and energy state.
-  UnitRender render;                  /// Rendering and positioning data.
-  ShipModel *model;                   /// 3D model used to render this unit.
-  SpriteSheetState *explosion_effect; /// Explosion animation state.
-  BulletExplosion explosion_bullet;   /// Explosion effect when hit.
-  SpriteSheetState *hit;              /// Hit animation state.
+  UnitRender render;       /// Position and movement offset.
+  EntityHandle handle;     /// Handle of the unit, ENTITY_NONE for a free slot.
+  UnitType type;           /// Type of the unit (player or enemy).
+  UnitLifecycle lifecycle; /// Spawning, alive, dying or dead.
+  UnitVitals state;        /// Health and energy.
+  bool visible;            /// Visibility flag for rendering.
 } Unit;
 
+/**
+ * @brief Cold part of an in-game unit: the model, the rest of the movement
+ * and state, and the effects, only touched while the unit is drawn, fires or
+ * is hit. Stored in a side table indexed by the same slot as the hot record.
+ */
+typedef struct UnitCold
+{
+  ShipModel *model;                  /// 3D model used to render this unit.
+  MovementAction action;             /// Speed, direction and rotation.
+  UnitSize size;                     /// Dimensions used for model scaling.
+  uint8_t init_health;               /// Initial health value.
+  uint8_t init_energy;               /// Initial energy or stamina.
+  uint32_t last_frame;               /// Last frame number for animation.
+  double hit_time;                   /// Timestamp of the last hit taken.
+  double last_shoot;                 /// Time of the last bullet spawn.
+  SpriteAnimHandle explosion_effect; /// Destruction animation handle.
+  SpriteAnimHandle hit;              /// Hit animation handle.
+  BulletExplosion explosion_bullet;  /// Explosion effect when hit.
+} UnitCold;
+
 /**
  * @brief Creates a new default UnitSize.
  * @return A UnitSize struct with predefined dimensions.
@@ -119,72 +163,102 @@ UnitRender newUnitRender(UnitPosition position);
 UnitState newUnitState();
 
 /**
- * @brief Constructs a new Unit with specified type and model.
+ * @brief Initializes and returns new UnitVitals with default values.
+ * @return UnitVitals with full health and default energy.
+ */
+UnitVitals newUnitVitals();
+
+/**
+ * @brief Constructs the hot record of a new unit with specified type.
  *
  * Initializes internal state, position, and render configuration using
  * default values.
  *
  * @param ty Type of the unit (e.g., player or enemy).
+ * @return A fully constructed Unit structure.
+ */
+Unit newUnit(UnitType ty);
+
+/**
+ * @brief Constructs the cold record of a new unit.
+ *
  * @param model Pointer to the ship model used for rendering this unit.
  * @param textures Pointer to the game textures for effects.
- * @return A fully constructed Unit structure.
+ * @return A fully constructed UnitCold structure.
  */
-Unit newUnit(UnitType ty, ShipModel *model, GameTextures *textures);
+UnitCold newUnitCold(ShipModel *model, GameTextures *textures);
 
 /**
  * @brief Computes the bounding box of the given unit for collision or
  * debugging.
  *
  * @param unit Pointer to the unit.
+ * @param cold Pointer to the cold record of the unit (extents, rotation).
  * @return BoundingBox structure that encloses the unit.
  */
-BoundingBox getUnitBoundingBox(Unit *unit);
+BoundingBox getUnitBoundingBox(const Unit *unit, const UnitCold *cold);
 
 /**
- * @brief Doubly-linked list node for storing a single unit.
- */
-typedef struct UnitNode
-{
-  struct UnitNode *prev; /// Pointer to the previous node.
-  struct UnitNode *next; /// Pointer to the next node.
-  Unit self;             /// The actual unit instance.
-} UnitNode;
-
-/**
- * @brief A list of UnitNodes, supporting dynamic collections of units.
+ * @brief A fixed-capacity collection of units.
+ *
+ * Hot records live in one array and cold records in a parallel one; both
+ * are indexed by the slot of the unit handle. Slots are handed out in
+ * insertion order, so walking the hot array from slot 0 up to
+ * `handles.used` (skipping free slots) visits the units in formation order.
+ *
+ * The slots of live (spawning and alive) units and of dying units are also
+ * kept in two sets, each in ascending slot order. Collision and AI walk the
+ * live set only; a unit moves to the dying set when it is destroyed.
  */
 typedef struct
 {
-  UnitNode *head;  /// Pointer to the first node.
-  UnitNode *tail;  /// Pointer to the last node.
-  uint16_t length; /// Number of nodes in the list.
+  Unit *units;          /// Hot records, indexed by slot.
+  UnitCold *cold;       /// Cold records, indexed by slot.
+  Unit *tail;           /// Last inserted unit, anchors the formation grid.
+  uint16_t length;      /// Number of units, dying ones included.
+  uint16_t capacity;    /// Slots in both tables.
+  uint16_t *live;       /// Slots of spawning and alive units.
+  uint16_t live_count;  /// Entries in live.
+  uint16_t *dying;      /// Slots of dying units.
+  uint16_t dying_count; /// Entries in dying.
+  EntityTable handles;  /// Unit handles and the end-of-tick destroy queue.
 } UnitList;
 
 /**
- * @brief Creates and initializes a new UnitNode.
+ * @brief Returns the cold record of a unit stored in the list.
  *
- * @param prev Pointer to the previous node.
- * @param unit The unit instance to store in this node.
- * @param max_col Maximum column index (used for positioning).
- * @param mid_x Horizontal center of the field.
- * @param z_offset Offset along Z axis for spacing or layering.
- * @return Pointer to the newly allocated UnitNode.
+ * @param list Pointer to the UnitList owning the unit.
+ * @param unit Pointer to the hot record of the unit.
+ * @return Pointer to the cold record in the same slot.
  */
-UnitNode *newUnitNode(UnitNode *prev, Unit unit, uint16_t max_col,
-                      float mid_x, float z_offset);
+UnitCold *getUnitCold(UnitList *list, const Unit *unit);
 
 /**
  * @brief Renders the unit's model, explosion effects, and hit animations.
  *
  * Handles the drawing of the unit's 3D model, applying hit effects and
  * explosion animations as necessary. Also manages movement updates and debug
- * bounding box rendering.
+ * bounding box rendering. The hit explosion is advanced here and drawn later
+ * by drawUnitsEffects.
  *
  * @param unit Pointer to the Unit to draw.
+ * @param cold Pointer to the cold record of the unit.
  * @param camera Pointer to the active Camera3D for view/projection.
  * @param sprites Pointer to the SpriteSheetList containing explosion models.
+ * @param anims Pointer to the pool playing hit/explosion animations.
+ * @param lights Pointer to the light manager (explosion lights, shading).
  */
-void drawUnit(Unit *unit, Camera3D *camera, SpriteSheetList *sprites);
+void drawUnit(Unit *unit, UnitCold *cold, Camera3D *camera,
+              SpriteSheetList *sprites, SpriteAnimPool *anims,
+              LightManager *lights);
+
+/**
+ * @brief Allocates an empty UnitList with room for a number of units.
+ *
+ * @param capacity Number of slots in the hot and cold tables.
+ * @return Pointer to the allocated UnitList, or NULL on failure.
+ */
+UnitList *newUnitTables(int capacity);
 
 /**
  * @brief Creates and populates a UnitList with a specified number of enemy
@@ -204,35 +278,72 @@ UnitList *newUnitList(int count, ShipModel *model, uint16_t max_col,
                       float z_offset, GameTextures *textures);
 
 /**
- * @brief Frees all memory used by the unit list and its nodes.
+ * @brief Frees all memory used by the unit list and its units, including
+ * the list itself.
  *
- * @param list Pointer to the UnitList to destroy.
+ * @param list Pointer to the UnitList to destroy. Safe to pass NULL.
  */
 void destroyUnitList(UnitList *list);
 
 /**
- * @brief Inserts a new unit into the end of the UnitList.
+ * @brief Inserts a new unit into the next free slot of the UnitList.
  *
  * @param list Pointer to the list to insert into.
- * @param unit Unit to be inserted.
+ * @param unit Hot record of the unit to be inserted.
+ * @param cold Cold record of the unit to be inserted.
  * @param max_col Grid column limit (used for positioning).
  * @param mid_x Center X position used for horizontal centering.
  * @param z_offset Z-axis placement offset.
  */
-void insertToUnitList(UnitList *list, Unit unit, uint16_t max_col,
-                      float mid_x, float z_offset);
+void insertToUnitList(UnitList *list, Unit unit, UnitCold cold,
+                      uint16_t max_col, float mid_x, float z_offset);
 
 /**
  * @brief Renders all units in the list.
  *
  * @param list Pointer to the list of units.
+ * @param camera Pointer to the active Camera3D for view/projection.
+ * @param sprites Pointer to the SpriteSheetList containing explosion models.
+ * @param anims Pointer to the pool playing hit/explosion animations.
+ * @param lights Pointer to the light manager (explosion lights, shading).
+ */
+void drawUnits(UnitList *list, Camera3D *camera, SpriteSheetList *sprites,
+               SpriteAnimPool *anims, LightManager *lights);
+
+/**
+ * @brief Draws the hit explosions of all units; call after every opaque
+ * draw of the frame.
+ *
+ * @param list Pointer to the list of units.
+ * @param camera Pointer to the active Camera3D for view/projection.
+ * @param alpha Transparent pass queue receiving explosion smoke.
  */
-void drawUnits(UnitList *list, Camera3D *camera, SpriteSheetList *sprites);
+void drawUnitsEffects(UnitList *list, Camera3D *camera,
+                      AlphaParticleQueue *alpha);
 
 /**
- * @brief Removes all units from the list and resets the structure.
+ * @brief Queues a unit for destruction at the end of the tick.
  *
- * @param list Pointer to the UnitList to clear.
+ * @param list Pointer to the UnitList owning the unit.
+ * @param unit Pointer to the unit.
+ */
+void destroyUnitLater(UnitList *list, Unit *unit);
+
+/**
+ * @brief Resolves a unit handle.
+ *
+ * @param list Pointer to the UnitList that issued the handle.
+ * @param handle Handle of the unit.
+ * @return The unit, or NULL once the unit has been destroyed.
+ */
+Unit *resolveUnit(UnitList *list, EntityHandle handle);
+
+/**
+ * @brief Destroys the units queued during the tick in one pass.
+ *
+ * Call once at the end of the tick.
+ *
+ * @param list Pointer to the UnitList.
  */
 void removeUnits(UnitList *list);
 
@@ -249,14 +360,33 @@ void removeUnits(UnitList *list);
 bool isUnitAbleToFire(UnitList *list, Unit *unit);
 
 /**
- * @brief Checks for collisions between bullets and enemy units.
+ * @brief Applies a bullet hit found by the collision query to a unit:
+ * damage and bullet destruction. Emits GAME_EVENT_HIT and, when the unit
+ * was destroyed, GAME_EVENT_KILL and moves it to the dying set. Hits on a
+ * unit that is no longer live are ignored and leave the bullet flying.
  *
- * If a collision is detected, unit and bullet states are updated accordingly.
+ * @param list Pointer to the UnitList owning the unit.
+ * @param unit Pointer to the unit that was hit.
+ * @param bullets Pointer to the BulletList owning the bullet.
+ * @param node Pointer to the node of the bullet.
+ */
+void applyBulletHitToUnit(UnitList *list, Unit *unit, BulletList *bullets,
+                          BulletNode *node);
+
+/**
+ * @brief Effects consumer of the event queue: starts the destruction
+ * animation and explosion light of every unit killed by the events.
  *
- * @param units Pointer to the UnitList containing targets.
- * @param bullets Pointer to the BulletList to check against.
+ * @param list Pointer to the UnitList the events refer to.
+ * @param events Events of the current tick.
+ * @param count Number of events.
+ * @param sprites Pointer to the SpriteSheetList containing explosion models.
+ * @param anims Pointer to the pool playing the animations.
+ * @param lights Pointer to the light manager receiving explosion lights.
  */
-void checkBulletHitsUnits(UnitList *units, BulletList *bullets, GameStat *stat);
+void applyEventsToUnits(UnitList *list, const GameEvent *events, size_t count,
+                        SpriteSheetList *sprites, SpriteAnimPool *anims,
+                        LightManager *lights);
 
 /**
  * @brief Spawns a bullet from the unit aimed at the specified target.
@@ -266,12 +396,14 @@ void checkBulletHitsUnits(UnitList *units, BulletList *bullets, GameStat *stat);
  *
  * @param bullets Pointer to the BulletList to insert the new bullet into.
  * @param unit Pointer to the Unit that is shooting.
+ * @param cold Pointer to the cold record of the unit (time of the last shot).
  * @param target_x X coordinate of the target in world space.
  * @param target_z Z coordinate of the target in world space.
  * @param level Pointer to the current Level containing unit parameters.
  * @param textures Pointer to the GameTextures for bullet creation.
  */
-void spawnUnitShoot(BulletList *bullets, Unit *unit, float target_x,
-                    float target_z, Level *level, GameTextures *textures);
+void spawnUnitShoot(BulletList *bullets, Unit *unit, UnitCold *cold,
+                    float target_x, float target_z, Level *level,
+                    GameTextures *textures);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,175 @@
+/**
+ * @file arena.c
+ * @brief Implements the per-frame scratch allocator.
+ */
+#include "arena.h"
+#include "raylib.h"
+#include <assert.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @brief Internal arena state.
+ */
+typedef struct FrameArena
+{
+  unsigned char *buffers[FRAME_ARENA_MAX_BUFFERS]; /// One per frame in flight.
+  int buffer_count;                                /// Buffers in rotation.
+  int current;                                     /// Buffer of this frame.
+  size_t budget;                                   /// Bytes per buffer.
+  size_t used;                                     /// Bytes used this frame.
+  size_t peak;                                     /// High-water mark.
+  uint64_t frame;                                  /// Frames begun.
+  bool overflowed;                                 /// Budget hit this frame.
+} FrameArena;
+
+static FrameArena arena = {0};
+
+// Returned by frameFormat when the arena is exhausted.
+static char empty_string[1] = {0};
+
+/**
+ * @brief Allocates the arena buffers; calling it again replaces them.
+ *
+ * @param budget Bytes available per frame.
+ * @param buffers Buffers to rotate through, 1..FRAME_ARENA_MAX_BUFFERS.
+ * @return False when memory ran out; allocations then fail.
+ */
+bool frameArenaInit(size_t budget, int buffers)
+{
+  frameArenaShutdown();
+  if (buffers < 1)
+  {
+    buffers = 1;
+  }
+  if (buffers > FRAME_ARENA_MAX_BUFFERS)
+  {
+    buffers = FRAME_ARENA_MAX_BUFFERS;
+  }
+  for (int i = 0; i < buffers; i++)
+  {
+    arena.buffers[i] = aligned_alloc(FRAME_ARENA_ALIGN,
+                                     (budget + FRAME_ARENA_ALIGN - 1) &
+                                         ~(size_t)(FRAME_ARENA_ALIGN - 1));
+    if (!arena.buffers[i])
+    {
+      TraceLog(LOG_ERROR, "[FrameArena] cannot allocate %zu KiB",
+               budget / 1024);
+      frameArenaShutdown();
+      return false;
+    }
+  }
+  arena.buffer_count = buffers;
+  arena.budget = budget;
+  TraceLog(LOG_INFO, "[FrameArena] %zu KiB per frame, %d buffer(s)",
+           budget / 1024, buffers);
+  return true;
+}
+
+/**
+ * @brief Frees the arena buffers.
+ */
+void frameArenaShutdown(void)
+{
+  for (int i = 0; i < FRAME_ARENA_MAX_BUFFERS; i++)
+  {
+    free(arena.buffers[i]);
+    arena.buffers[i] = NULL;
+  }
+  arena.buffer_count = 0;
+  arena.budget = 0;
+  arena.used = 0;
+}
+
+/**
+ * @brief Starts a new frame: switches to the next buffer and releases
+ * everything allocated from it.
+ */
+void frameArenaBegin(void)
+{
+  arena.frame++;
+  if (arena.buffer_count > 0)
+  {
+    arena.current = (arena.current + 1) % arena.buffer_count;
+  }
+  arena.used = 0;
+  arena.overflowed = false;
+}
+
+/**
+ * @brief Allocates transient memory valid until the buffer comes round
+ * again; asserts when the frame budget is exceeded.
+ *
+ * @param size Bytes to allocate.
+ * @return FRAME_ARENA_ALIGN-aligned uninitialized memory, or NULL.
+ */
+void *frameAlloc(size_t size)
+{
+  size_t offset = (arena.used + FRAME_ARENA_ALIGN - 1) &
+                  ~(size_t)(FRAME_ARENA_ALIGN - 1);
+  if (arena.buffer_count == 0 || size > arena.budget ||
+      offset > arena.budget - size)
+  {
+    if (!arena.overflowed)
+    {
+      arena.overflowed = true;
+      TraceLog(LOG_ERROR,
+               "[FrameArena] frame %llu exceeds its %zu KiB budget "
+               "(%zu B used, %zu B requested)",
+               (unsigned long long)arena.frame, arena.budget / 1024,
+               arena.used, size);
+      assert(!"frame arena budget exceeded");
+    }
+    return NULL;
+  }
+  arena.used = offset + size;
+  if (arena.used > arena.peak)
+  {
+    arena.peak = arena.used;
+  }
+  return arena.buffers[arena.current] + offset;
+}
+
+/**
+ * @brief Formats a string into the arena.
+ *
+ * @param format printf-style format.
+ * @return The formatted string, or an empty string when out of memory.
+ */
+char *frameFormat(const char *format, ...)
+{
+  va_list args;
+  va_start(args, format);
+  int length = vsnprintf(NULL, 0, format, args);
+  va_end(args);
+  if (length < 0)
+  {
+    return empty_string;
+  }
+  char *text = frameAlloc((size_t)length + 1);
+  if (!text)
+  {
+    return empty_string;
+  }
+  va_start(args, format);
+  vsnprintf(text, (size_t)length + 1, format, args);
+  va_end(args);
+  return text;
+}
+
+/**
+ * @brief Returns the number of frames begun so far.
+ */
+uint64_t frameArenaFrame(void)
+{
+  return arena.frame;
+}
+
+/**
+ * @brief Returns current usage, high-water mark and budget.
+ */
+FrameArenaStats frameArenaStats(void)
+{
+  return (FrameArenaStats){arena.used, arena.peak, arena.budget};
+}
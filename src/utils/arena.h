@@ -0,0 +1,91 @@
+/**
+ * @file arena.h
+ * @brief Declares the per-frame scratch allocator: a linear (bump) arena for
+ * transient data such as sort buffers, debug draw queues and formatted
+ * strings. Everything allocated during a frame is released at once when the
+ * next frame begins; there is no per-allocation free.
+ */
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/// Bytes one frame may allocate from the arena.
+#define FRAME_ARENA_BUDGET ((size_t)2 << 20)
+
+/// Alignment of every allocation (fits SIMD loads).
+#define FRAME_ARENA_ALIGN 16
+
+/// Most buffers the arena can rotate through.
+#define FRAME_ARENA_MAX_BUFFERS 2
+
+/**
+ * @brief Usage figures of the arena.
+ */
+typedef struct FrameArenaStats
+{
+  size_t used;   /// Bytes allocated so far in the current frame.
+  size_t peak;   /// Largest frame since start-up (high-water mark).
+  size_t budget; /// Bytes available per frame.
+} FrameArenaStats;
+
+/**
+ * @brief Allocates the arena buffers.
+ *
+ * With two buffers consecutive frames allocate from different memory, so a
+ * render thread can still read what the previous frame produced while the
+ * next one is simulated. The game renders on the main thread and uses one.
+ * Calling it again replaces the previous buffers.
+ *
+ * @param budget Bytes available per frame.
+ * @param buffers Buffers to rotate through, 1..FRAME_ARENA_MAX_BUFFERS.
+ * @return False when memory ran out; allocations then fail.
+ */
+bool frameArenaInit(size_t budget, int buffers);
+
+/**
+ * @brief Frees the arena buffers.
+ */
+void frameArenaShutdown(void);
+
+/**
+ * @brief Starts a new frame: switches to the next buffer and releases
+ * everything allocated from it. Call once at the start of every frame.
+ */
+void frameArenaBegin(void);
+
+/**
+ * @brief Allocates transient memory valid until the next frameArenaBegin
+ * (or the one after it with two buffers).
+ *
+ * Exceeding the frame budget is a bug: it is logged and asserted. Builds
+ * with NDEBUG get NULL back and the caller skips the work.
+ *
+ * @param size Bytes to allocate.
+ * @return FRAME_ARENA_ALIGN-aligned uninitialized memory, or NULL.
+ */
+void *frameAlloc(size_t size);
+
+/**
+ * @brief Formats a string into the arena, like TextFormat but without a
+ * limit on length or on strings alive at the same time.
+ *
+ * @param format printf-style format.
+ * @return The formatted string, or an empty string when out of memory.
+ */
+char *frameFormat(const char *format, ...);
+
+/**
+ * @brief Returns the number of frames begun so far, so frame queues can
+ * tell that their arena memory has been released.
+ */
+uint64_t frameArenaFrame(void);
+
+/**
+ * @brief Returns current usage, high-water mark and budget.
+ */
+FrameArenaStats frameArenaStats(void);
+
+#endif
@@ -0,0 +1,222 @@
+/**
+ * @file handles.c
+ * @brief Implements generational entity handles and the deferred
+ * destruction queue.
+ */
+#include "handles.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Builds a handle from a slot index and its generation.
+ */
+static EntityHandle makeHandle(uint16_t index, uint16_t generation)
+{
+  return ((EntityHandle)generation << 16) | (EntityHandle)(index + 1u);
+}
+
+/**
+ * @brief Extracts the slot index of a non-empty handle.
+ */
+static uint16_t handleIndex(EntityHandle handle)
+{
+  return (uint16_t)((handle & 0xffffu) - 1u);
+}
+
+/**
+ * @brief Resizes every per-slot array of the table.
+ *
+ * @param table Table to grow.
+ * @param capacity New number of slots.
+ * @return False when memory ran out; the table is left usable.
+ */
+static bool growEntityTable(EntityTable *table, uint16_t capacity)
+{
+  void **items = realloc(table->items, capacity * sizeof(void *));
+  if (!items)
+  {
+    return false;
+  }
+  table->items = items;
+  uint16_t *generations =
+      realloc(table->generations, capacity * sizeof(uint16_t));
+  if (!generations)
+  {
+    return false;
+  }
+  table->generations = generations;
+  uint8_t *doomed = realloc(table->doomed, capacity * sizeof(uint8_t));
+  if (!doomed)
+  {
+    return false;
+  }
+  table->doomed = doomed;
+  uint16_t *free_slots = realloc(table->free, capacity * sizeof(uint16_t));
+  if (!free_slots)
+  {
+    return false;
+  }
+  table->free = free_slots;
+  EntityHandle *queue = realloc(table->queue, capacity * sizeof(EntityHandle));
+  if (!queue)
+  {
+    return false;
+  }
+  table->queue = queue;
+  size_t added = (size_t)(capacity - table->capacity);
+  memset(table->items + table->capacity, 0, added * sizeof(void *));
+  memset(table->generations + table->capacity, 0, added * sizeof(uint16_t));
+  memset(table->doomed + table->capacity, 0, added * sizeof(uint8_t));
+  table->capacity = capacity;
+  return true;
+}
+
+/**
+ * @brief Allocates the slots of an empty table.
+ *
+ * @param table Table to initialize.
+ * @return False when memory ran out.
+ */
+bool entityTableInit(EntityTable *table)
+{
+  memset(table, 0, sizeof(*table));
+  if (!growEntityTable(table, ENTITY_TABLE_INITIAL))
+  {
+    entityTableFree(table);
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Frees the slots; handles issued by the table stop resolving.
+ *
+ * @param table Table to release.
+ */
+void entityTableFree(EntityTable *table)
+{
+  free(table->items);
+  free(table->generations);
+  free(table->doomed);
+  free(table->free);
+  free(table->queue);
+  memset(table, 0, sizeof(*table));
+}
+
+/**
+ * @brief Assigns a slot to an entity.
+ *
+ * @param table Table to allocate from.
+ * @param item Entity to register.
+ * @return Handle of the entity, or ENTITY_NONE when no slot is left.
+ */
+EntityHandle entityAcquire(EntityTable *table, void *item)
+{
+  uint16_t index;
+  if (table->free_count > 0)
+  {
+    index = table->free[--table->free_count];
+  }
+  else
+  {
+    if (table->used == table->capacity)
+    {
+      uint32_t capacity = table->capacity ? table->capacity * 2u
+                                          : ENTITY_TABLE_INITIAL;
+      if (capacity > ENTITY_TABLE_MAX)
+      {
+        capacity = ENTITY_TABLE_MAX;
+      }
+      if (capacity == table->capacity ||
+          !growEntityTable(table, (uint16_t)capacity))
+      {
+        return ENTITY_NONE;
+      }
+    }
+    index = table->used++;
+  }
+  table->items[index] = item;
+  table->doomed[index] = 0;
+  return makeHandle(index, table->generations[index]);
+}
+
+/**
+ * @brief Returns the slot the next entityAcquire will use.
+ *
+ * @param table Table to allocate from.
+ * @return Slot index.
+ */
+uint16_t entityNextSlot(const EntityTable *table)
+{
+  return table->free_count > 0 ? table->free[table->free_count - 1]
+                               : table->used;
+}
+
+/**
+ * @brief Looks an entity up.
+ *
+ * @param table Table that issued the handle.
+ * @param handle Handle to resolve.
+ * @return The entity, or NULL for stale and empty handles.
+ */
+void *entityResolve(const EntityTable *table, EntityHandle handle)
+{
+  if (handle == ENTITY_NONE)
+  {
+    return NULL;
+  }
+  uint16_t index = handleIndex(handle);
+  if (index >= table->used ||
+      table->generations[index] != (uint16_t)(handle >> 16))
+  {
+    return NULL;
+  }
+  return table->items[index];
+}
+
+/**
+ * @brief Queues an entity for destruction at the end of the tick.
+ *
+ * @param table Table that issued the handle.
+ * @param handle Entity to destroy.
+ */
+void entityDestroyLater(EntityTable *table, EntityHandle handle)
+{
+  if (!entityResolve(table, handle))
+  {
+    return;
+  }
+  uint16_t index = handleIndex(handle);
+  if (table->doomed[index])
+  {
+    return;
+  }
+  table->doomed[index] = 1;
+  table->queue[table->queue_count++] = handle;
+}
+
+/**
+ * @brief Takes the next queued entity and frees its slot.
+ *
+ * @param table Table to drain.
+ * @return The entity, or NULL when the queue is empty.
+ */
+void *entityTakeDestroyed(EntityTable *table)
+{
+  while (table->queue_count > 0)
+  {
+    EntityHandle handle = table->queue[--table->queue_count];
+    void *item = entityResolve(table, handle);
+    if (!item)
+    {
+      continue;
+    }
+    uint16_t index = handleIndex(handle);
+    table->items[index] = NULL;
+    table->doomed[index] = 0;
+    table->generations[index]++;
+    table->free[table->free_count++] = index;
+    return item;
+  }
+  return NULL;
+}
@@ -0,0 +1,113 @@
+/**
+ * @file handles.h
+ * @brief Declares generational entity handles and a deferred destruction
+ * queue for units and bullets.
+ *
+ * A handle packs a slot index and the slot generation, the same way sprite
+ * animation handles do (see sprites/animation.h). Freeing an entity bumps
+ * the generation, so handles kept elsewhere stop resolving instead of
+ * dangling. Entities are not freed while the frame is running: they are
+ * queued and released together at the end of the tick.
+ */
+#ifndef HANDLES_H
+#define HANDLES_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/// Handle value that never refers to an entity.
+#define ENTITY_NONE 0u
+
+/// Slots allocated when a table is created; it doubles when full.
+#define ENTITY_TABLE_INITIAL 64
+
+/// Largest number of slots (the index is stored in 16 bits).
+#define ENTITY_TABLE_MAX 65535
+
+/**
+ * @brief Handle of an entity: slot index + 1 (low 16 bits) and slot
+ * generation (high 16 bits).
+ */
+typedef uint32_t EntityHandle;
+
+/**
+ * @brief Slot table resolving handles to entities, with the queue of
+ * entities waiting to be destroyed at the end of the tick.
+ */
+typedef struct EntityTable
+{
+  void **items;          /// Entity of each slot, NULL when free.
+  uint16_t *generations; /// Generation of each slot.
+  uint8_t *doomed;       /// Slot is queued for destruction.
+  uint16_t *free;        /// Stack of free slot indices.
+  uint16_t free_count;   /// Entries in `free`.
+  uint16_t used;         /// Slots handed out at least once.
+  uint16_t capacity;     /// Allocated slots.
+  EntityHandle *queue;   /// Handles to destroy at the end of the tick.
+  uint16_t queue_count;  /// Entries in `queue`.
+} EntityTable;
+
+/**
+ * @brief Allocates the slots of an empty table.
+ *
+ * @param table Table to initialize.
+ * @return False when memory ran out.
+ */
+bool entityTableInit(EntityTable *table);
+
+/**
+ * @brief Frees the slots; handles issued by the table stop resolving.
+ *
+ * @param table Table to release.
+ */
+void entityTableFree(EntityTable *table);
+
+/**
+ * @brief Assigns a slot to an entity.
+ *
+ * @param table Table to allocate from.
+ * @param item Entity to register.
+ * @return Handle of the entity, or ENTITY_NONE when no slot is left.
+ */
+EntityHandle entityAcquire(EntityTable *table, void *item);
+
+/**
+ * @brief Returns the slot the next entityAcquire will use, so callers can
+ * keep entity data in arrays indexed by slot.
+ *
+ * @param table Table to allocate from.
+ * @return Slot index; equal to the number of slots in use when the table
+ * has to grow first.
+ */
+uint16_t entityNextSlot(const EntityTable *table);
+
+/**
+ * @brief Looks an entity up.
+ *
+ * @param table Table that issued the handle.
+ * @param handle Handle to resolve.
+ * @return The entity, or NULL for stale and empty handles.
+ */
+void *entityResolve(const EntityTable *table, EntityHandle handle);
+
+/**
+ * @brief Queues an entity for destruction at the end of the tick. Queuing
+ * the same entity twice is harmless.
+ *
+ * @param table Table that issued the handle.
+ * @param handle Entity to destroy.
+ */
+void entityDestroyLater(EntityTable *table, EntityHandle handle);
+
+/**
+ * @brief Takes the next queued entity and frees its slot.
+ *
+ * Call in a loop at the end of the tick; the caller unlinks and frees the
+ * returned entity.
+ *
+ * @param table Table to drain.
+ * @return The entity, or NULL when the queue is empty.
+ */
+void *entityTakeDestroyed(EntityTable *table);
+
+#endif
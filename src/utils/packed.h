@@ -0,0 +1,253 @@
+/**
+ * @file packed.h
+ * @brief Compact particle storage: IEEE 754 half-floats (binary16), life
+ * normalised to 16 bits and rotation as an 8-bit index.
+ *
+ * Half-float conversion uses F16C on x86-64 when the compiler targets it (-mf16c, see Makefile),
+ * the native conversion instructions on aarch64 and a portable bit-level
+ * conversion otherwise. All paths round to nearest even, so results do not
+ * depend on the build.
+ */
+#ifndef PACKED_H
+#define PACKED_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__F16C__)
+#include <immintrin.h>
+#define HALF_SIMD_NAME "F16C"
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define HALF_SIMD_NAME "NEON"
+#else
+#define HALF_SIMD_NAME "scalar"
+#endif
+
+/// Normalised life of a freshly spawned particle.
+#define PACKED_LIFE_FULL 65535u
+
+/// Rotation steps per full turn.
+#define PACKED_ROT_STEPS 256.0f
+
+/**
+ * @brief Converts a half-float to float without SIMD.
+ *
+ * @param h Half-float bits.
+ * @return The same value as a float.
+ */
+static inline float halfToFloatScalar(uint16_t h)
+{
+  uint32_t sign = (uint32_t)(h & 0x8000u) << 16;
+  uint32_t exponent = (h >> 10) & 0x1fu;
+  uint32_t mantissa = h & 0x3ffu;
+  uint32_t bits;
+  if (exponent == 0x1fu)
+  {
+    bits = sign | 0x7f800000u | (mantissa << 13); // inf / NaN
+  }
+  else if (exponent != 0)
+  {
+    bits = sign | ((exponent + 112u) << 23) | (mantissa << 13);
+  }
+  else if (mantissa == 0)
+  {
+    bits = sign; // +-0
+  }
+  else
+  {
+    // subnormal half: normalise into a float exponent
+    exponent = 113u;
+    while ((mantissa & 0x400u) == 0)
+    {
+      mantissa <<= 1;
+      exponent--;
+    }
+    bits = sign | (exponent << 23) | ((mantissa & 0x3ffu) << 13);
+  }
+  float f;
+  memcpy(&f, &bits, sizeof(f));
+  return f;
+}
+
+/**
+ * @brief Converts a float to a half-float without SIMD, rounding to nearest
+ * even; values out of range become infinity.
+ *
+ * @param f Value to convert.
+ * @return Half-float bits.
+ */
+static inline uint16_t floatToHalfScalar(float f)
+{
+  uint32_t bits;
+  memcpy(&bits, &f, sizeof(bits));
+  uint16_t sign = (uint16_t)((bits >> 16) & 0x8000u);
+  uint32_t exponent = (bits >> 23) & 0xffu;
+  uint32_t mantissa = bits & 0x7fffffu;
+  if (exponent == 0xffu)
+  {
+    return (uint16_t)(sign | 0x7c00u | (mantissa ? 0x200u : 0u));
+  }
+  int e = (int)exponent - 112;
+  if (e >= 0x1f)
+  {
+    return (uint16_t)(sign | 0x7c00u);
+  }
+  if (e <= 0)
+  {
+    if (e < -10)
+    {
+      return sign;
+    }
+    // subnormal half: shift the implicit bit in, then round
+    mantissa |= 0x800000u;
+    uint32_t shift = (uint32_t)(14 - e);
+    uint32_t half = mantissa >> shift;
+    uint32_t rest = mantissa & ((1u << shift) - 1u);
+    uint32_t midpoint = 1u << (shift - 1u);
+    if (rest > midpoint || (rest == midpoint && (half & 1u)))
+    {
+      half++;
+    }
+    return (uint16_t)(sign | half);
+  }
+  uint32_t half = ((uint32_t)e << 10) | (mantissa >> 13);
+  uint32_t rest = mantissa & 0x1fffu;
+  if (rest > 0x1000u || (rest == 0x1000u && (half & 1u)))
+  {
+    half++; // may carry into the exponent, up to infinity
+  }
+  return (uint16_t)(sign | half);
+}
+
+/**
+ * @brief Converts a half-float to float.
+ *
+ * @param h Half-float bits.
+ * @return The same value as a float.
+ */
+static inline float halfToFloat(uint16_t h)
+{
+#if defined(__F16C__)
+  return _cvtsh_ss(h);
+#else
+  return halfToFloatScalar(h);
+#endif
+}
+
+/**
+ * @brief Converts a float to a half-float, rounding to nearest even.
+ *
+ * @param f Value to convert.
+ * @return Half-float bits.
+ */
+static inline uint16_t floatToHalf(float f)
+{
+#if defined(__F16C__)
+  return (uint16_t)_cvtss_sh(f, _MM_FROUND_TO_NEAREST_INT);
+#else
+  return floatToHalfScalar(f);
+#endif
+}
+
+/**
+ * @brief Converts four packed half-floats to floats in one instruction
+ * where available.
+ *
+ * @param in Four half-floats.
+ * @param out Four floats (out).
+ */
+static inline void halfToFloat4(const uint16_t in[4], float out[4])
+{
+#if defined(__F16C__)
+  __m128i packed = _mm_loadl_epi64((const __m128i *)(const void *)in);
+  _mm_storeu_ps(out, _mm_cvtph_ps(packed));
+#elif defined(__aarch64__)
+  float16x4_t packed = vreinterpret_f16_u16(vld1_u16(in));
+  vst1q_f32(out, vcvt_f32_f16(packed));
+#else
+  for (int i = 0; i < 4; i++)
+  {
+    out[i] = halfToFloatScalar(in[i]);
+  }
+#endif
+}
+
+/**
+ * @brief Converts four floats to packed half-floats in one instruction
+ * where available, rounding to nearest even.
+ *
+ * @param in Four floats.
+ * @param out Four half-floats (out).
+ */
+static inline void floatToHalf4(const float in[4], uint16_t out[4])
+{
+#if defined(__F16C__)
+  __m128i packed = _mm_cvtps_ph(_mm_loadu_ps(in), _MM_FROUND_TO_NEAREST_INT);
+  _mm_storel_epi64((__m128i *)(void *)out, packed);
+#elif defined(__aarch64__)
+  float16x4_t packed = vcvt_f16_f32(vld1q_f32(in));
+  vst1_u16(out, vreinterpret_u16_f16(packed));
+#else
+  for (int i = 0; i < 4; i++)
+  {
+    out[i] = floatToHalfScalar(in[i]);
+  }
+#endif
+}
+
+/**
+ * @brief Quantizes a rotation in degrees to an 8-bit index.
+ *
+ * @param degrees Rotation in degrees, 0..360.
+ * @return Rotation index, 256 steps per turn.
+ */
+static inline uint8_t packRotation(float degrees)
+{
+  return (uint8_t)((int)(degrees * (PACKED_ROT_STEPS / 360.0f) + 0.5f) & 0xff);
+}
+
+/**
+ * @brief Expands an 8-bit rotation index.
+ *
+ * @param rot Rotation index.
+ * @return Rotation in degrees.
+ */
+static inline float unpackRotation(uint8_t rot)
+{
+  return (float)rot * (360.0f / PACKED_ROT_STEPS);
+}
+
+/**
+ * @brief Advances a normalised life by dt seconds.
+ *
+ * @param life Remaining life, PACKED_LIFE_FULL at spawn (in/out).
+ * @param dt Elapsed time in seconds.
+ * @param ttl Total lifespan in seconds.
+ * @return False when the particle has expired.
+ */
+static inline bool packedLifeStep(uint16_t *life, float dt, float ttl)
+{
+  float step = dt / ttl * (float)PACKED_LIFE_FULL + 0.5f;
+  if (step >= (float)*life)
+  {
+    *life = 0;
+    return false;
+  }
+  *life = (uint16_t)(*life - (uint16_t)step);
+  return *life > 0;
+}
+
+/**
+ * @brief Returns the elapsed fraction of a normalised life.
+ *
+ * @param life Remaining life.
+ * @return 0 at spawn, approaching 1 at expiry.
+ */
+static inline float packedLifeAge(uint16_t life)
+{
+  return 1.0f - (float)life / (float)PACKED_LIFE_FULL;
+}
+
+#endif
@@ -0,0 +1,518 @@
+#if defined(__linux__)
+#define _DEFAULT_SOURCE // syscall() for perf events
+#endif
+/**
+ * @file profiler.c
+ * @brief Implements CPU section timing, GPU timer queries and counters with
+ * an overlay and a CSV trace.
+ */
+#include "profiler.h"
+#include "../render/gl.h"
+#include "raylib.h"
+#include "raymath.h"
+#include "resolution.h"
+#include "rlgl.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/// Weight of the newest frame in the moving averages.
+#define PROFILE_SMOOTHING 0.05
+
+// Global flag: the profiler overlay is visible.
+bool is_profiler_enabled = false;
+
+/**
+ * @brief GPU queries issued during one frame, waiting to be read back.
+ */
+typedef struct ProfileGpuFrame
+{
+  GLuint queries[PROFILE_GPU_MAX_INTERVALS * 2]; /// Start/end timestamps.
+  unsigned char pass[PROFILE_GPU_MAX_INTERVALS]; /// Pass of each interval.
+  int count;                                     /// Intervals issued.
+  bool pending;                                  /// Results not read yet.
+  bool ended;                                    /// CPU times are stored.
+  uint64_t frame;                                /// Frame number.
+  double cpu_ms[PROFILE_SECTION_COUNT];          /// CPU sections of the frame.
+} ProfileGpuFrame;
+
+/**
+ * @brief Internal profiler state.
+ */
+typedef struct Profiler
+{
+  double started[PROFILE_SECTION_COUNT];      /// Start time of open sections.
+  double frame_ms[PROFILE_SECTION_COUNT];     /// Time spent this frame.
+  double avg_ms[PROFILE_SECTION_COUNT];       /// Smoothed section times.
+  double counters[PROFILE_COUNTER_COUNT];     /// Counters of this frame.
+  double avg_counters[PROFILE_COUNTER_COUNT]; /// Smoothed counters.
+  uint64_t frame;                             /// Current frame number.
+  int gpu_support;                  /// 0 unknown, 1 timer queries, -1 none.
+  bool gpu_recording;               /// Queries are issued this frame.
+  ProfileGpuFrame gpu[PROFILE_GPU_LATENCY]; /// In-flight frames.
+  ProfileGpuFrame *gpu_current;     /// Frame receiving queries.
+  int gpu_open;                     /// Open interval, -1 when none.
+  ProfileGpuPass gpu_stack[PROFILE_GPU_MAX_DEPTH]; /// Nested passes.
+  int gpu_depth;                    /// Entries in gpu_stack.
+  double avg_gpu_ms[PROFILE_GPU_PASS_COUNT]; /// Smoothed pass times.
+  uint64_t gpu_dropped;             /// Frames whose results came too late.
+  FILE *trace;                      /// CSV trace, NULL when disabled.
+} Profiler;
+
+static Profiler profiler = {.gpu_open = -1};
+
+static const char *section_names[PROFILE_SECTION_COUNT] = {
+    "frame", "scene", "post", "hud"};
+
+static const char *gpu_pass_names[PROFILE_GPU_PASS_COUNT] = {
+    "ships", "bullets", "trails", "explosions",
+    "sprites", "transparent", "hud", "post"};
+
+/**
+ * @brief Parses command-line arguments to check for the --profile flag.
+ *
+ * @param argc The count of command-line arguments.
+ * @param argv The array of command-line argument strings.
+ */
+void checkProfilerFlag(int argc, char *argv[])
+{
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--profile") == 0)
+    {
+      is_profiler_enabled = true;
+    }
+    else if (strcmp(argv[i], "--profile-trace") == 0 && i + 1 < argc &&
+             !profiler.trace)
+    {
+      profiler.trace = fopen(argv[++i], "w");
+      if (!profiler.trace)
+      {
+        TraceLog(LOG_WARNING, "[Profiler] cannot open trace file %s", argv[i]);
+        continue;
+      }
+      fprintf(profiler.trace, "frame");
+      for (int s = 0; s < PROFILE_SECTION_COUNT; s++)
+      {
+        fprintf(profiler.trace, ",cpu_%s_ms", section_names[s]);
+      }
+      for (int p = 0; p < PROFILE_GPU_PASS_COUNT; p++)
+      {
+        fprintf(profiler.trace, ",gpu_%s_ms", gpu_pass_names[p]);
+      }
+      fprintf(profiler.trace, "\n");
+    }
+  }
+}
+
+/**
+ * @brief Checks once for timestamp queries and allocates the query pool.
+ */
+static void gpuInit(void)
+{
+  // Clear stale errors so the probe below is not misread
+  while (glGetError() != GL_NO_ERROR)
+  {
+  }
+  GLint bits = 0;
+  glGetQueryiv(GL_TIMESTAMP, GL_QUERY_COUNTER_BITS, &bits);
+  if (glGetError() != GL_NO_ERROR || bits == 0)
+  {
+    profiler.gpu_support = -1;
+    TraceLog(LOG_WARNING, "[Profiler] GPU timer queries unavailable");
+    return;
+  }
+  for (int i = 0; i < PROFILE_GPU_LATENCY; i++)
+  {
+    glGenQueries(PROFILE_GPU_MAX_INTERVALS * 2, profiler.gpu[i].queries);
+  }
+  profiler.gpu_support = 1;
+}
+
+/**
+ * @brief Writes one trace row; GPU columns stay empty without results.
+ *
+ * @param frame Frame whose CPU (and maybe GPU) times are written.
+ * @param gpu_ms GPU pass times, or NULL when unavailable.
+ */
+static void traceWrite(const ProfileGpuFrame *frame, const double *gpu_ms)
+{
+  if (!profiler.trace)
+  {
+    return;
+  }
+  fprintf(profiler.trace, "%llu", (unsigned long long)frame->frame);
+  for (int s = 0; s < PROFILE_SECTION_COUNT; s++)
+  {
+    fprintf(profiler.trace, ",%.4f", frame->cpu_ms[s]);
+  }
+  for (int p = 0; p < PROFILE_GPU_PASS_COUNT; p++)
+  {
+    if (gpu_ms)
+    {
+      fprintf(profiler.trace, ",%.4f", gpu_ms[p]);
+    }
+    else
+    {
+      fprintf(profiler.trace, ",");
+    }
+  }
+  fprintf(profiler.trace, "\n");
+}
+
+/**
+ * @brief Reads back a frame's queries if the GPU has finished them.
+ *
+ * @param frame Frame to resolve.
+ * @param force Give up instead of waiting when the results are not ready.
+ */
+static void gpuResolve(ProfileGpuFrame *frame, bool force)
+{
+  if (!frame->pending || !frame->ended)
+  {
+    return;
+  }
+  if (frame->count > 0)
+  {
+    GLint available = 0;
+    glGetQueryObjectiv(frame->queries[frame->count * 2 - 1],
+                       GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available)
+    {
+      if (force)
+      {
+        frame->pending = false;
+        profiler.gpu_dropped++;
+        traceWrite(frame, NULL);
+      }
+      return;
+    }
+  }
+  double gpu_ms[PROFILE_GPU_PASS_COUNT] = {0};
+  for (int i = 0; i < frame->count; i++)
+  {
+    GLuint64 start = 0;
+    GLuint64 end = 0;
+    glGetQueryObjectui64v(frame->queries[i * 2], GL_QUERY_RESULT, &start);
+    glGetQueryObjectui64v(frame->queries[i * 2 + 1], GL_QUERY_RESULT, &end);
+    if (end > start)
+    {
+      gpu_ms[frame->pass[i]] += (double)(end - start) / 1.0e6;
+    }
+  }
+  for (int p = 0; p < PROFILE_GPU_PASS_COUNT; p++)
+  {
+    profiler.avg_gpu_ms[p] +=
+        (gpu_ms[p] - profiler.avg_gpu_ms[p]) * PROFILE_SMOOTHING;
+  }
+  frame->pending = false;
+  traceWrite(frame, gpu_ms);
+}
+
+void profilerBeginFrame(void)
+{
+  memset(profiler.frame_ms, 0, sizeof(profiler.frame_ms));
+  memset(profiler.counters, 0, sizeof(profiler.counters));
+  profiler.frame++;
+
+  bool wanted = is_profiler_enabled || profiler.trace;
+  if (wanted && profiler.gpu_support == 0)
+  {
+    gpuInit();
+  }
+  if (profiler.gpu_support == 1)
+  {
+    // Oldest first, so the trace stays in frame order
+    for (uint64_t f = profiler.frame - PROFILE_GPU_LATENCY + 1;
+         f < profiler.frame; f++)
+    {
+      gpuResolve(&profiler.gpu[f % PROFILE_GPU_LATENCY], false);
+    }
+  }
+  ProfileGpuFrame *current = &profiler.gpu[profiler.frame % PROFILE_GPU_LATENCY];
+  // Still not ready after PROFILE_GPU_LATENCY frames: drop rather than stall
+  gpuResolve(current, true);
+  current->frame = profiler.frame;
+  current->count = 0;
+  current->ended = false;
+  profiler.gpu_recording = wanted && profiler.gpu_support == 1;
+  current->pending = profiler.gpu_recording;
+  profiler.gpu_current = current;
+  profiler.gpu_open = -1;
+  profiler.gpu_depth = 0;
+  profilerBegin(PROFILE_FRAME);
+}
+
+void profilerEndFrame(void)
+{
+  profilerEnd(PROFILE_FRAME);
+  for (int i = 0; i < PROFILE_SECTION_COUNT; i++)
+  {
+    profiler.avg_ms[i] +=
+        (profiler.frame_ms[i] - profiler.avg_ms[i]) * PROFILE_SMOOTHING;
+  }
+  for (int i = 0; i < PROFILE_COUNTER_COUNT; i++)
+  {
+    profiler.avg_counters[i] +=
+        (profiler.counters[i] - profiler.avg_counters[i]) * PROFILE_SMOOTHING;
+  }
+  ProfileGpuFrame *current = profiler.gpu_current;
+  if (!current)
+  {
+    return;
+  }
+  memcpy(current->cpu_ms, profiler.frame_ms, sizeof(current->cpu_ms));
+  current->ended = true;
+  if (!current->pending)
+  {
+    traceWrite(current, NULL);
+  }
+  profiler.gpu_recording = false;
+}
+
+/**
+ * @brief Starts a timed interval for a pass in the current frame.
+ */
+static void gpuOpen(ProfileGpuPass pass)
+{
+  ProfileGpuFrame *frame = profiler.gpu_current;
+  if (frame->count == PROFILE_GPU_MAX_INTERVALS)
+  {
+    profiler.gpu_open = -1;
+    return;
+  }
+  int i = frame->count++;
+  frame->pass[i] = (unsigned char)pass;
+  glQueryCounter(frame->queries[i * 2], GL_TIMESTAMP);
+  profiler.gpu_open = i;
+}
+
+/**
+ * @brief Ends the open interval, if any.
+ */
+static void gpuClose(void)
+{
+  if (profiler.gpu_open < 0)
+  {
+    return;
+  }
+  glQueryCounter(profiler.gpu_current->queries[profiler.gpu_open * 2 + 1],
+                 GL_TIMESTAMP);
+  profiler.gpu_open = -1;
+}
+
+void profilerGpuBegin(ProfileGpuPass pass)
+{
+  // The pass stack is kept without timing too: it names the current pass
+  if (profiler.gpu_depth < PROFILE_GPU_MAX_DEPTH)
+  {
+    profiler.gpu_stack[profiler.gpu_depth++] = pass;
+  }
+  if (!profiler.gpu_recording)
+  {
+    return;
+  }
+  rlDrawRenderBatchActive();
+  gpuClose();
+  gpuOpen(pass);
+}
+
+void profilerGpuEnd(ProfileGpuPass pass)
+{
+  (void)pass;
+  if (profiler.gpu_depth > 0)
+  {
+    profiler.gpu_depth--;
+  }
+  if (!profiler.gpu_recording)
+  {
+    return;
+  }
+  rlDrawRenderBatchActive();
+  gpuClose();
+  if (profiler.gpu_depth > 0)
+  {
+    gpuOpen(profiler.gpu_stack[profiler.gpu_depth - 1]);
+  }
+}
+
+const char *profilerGpuPassName(void)
+{
+  if (profiler.gpu_depth == 0)
+  {
+    return "scene";
+  }
+  return gpu_pass_names[profiler.gpu_stack[profiler.gpu_depth - 1]];
+}
+
+void profilerShutdown(void)
+{
+  if (profiler.gpu_support == 1)
+  {
+    // Collect what is still in flight so the trace ends at the last frame
+    glFinish();
+    for (uint64_t f = profiler.frame + 1;
+         f <= profiler.frame + PROFILE_GPU_LATENCY; f++)
+    {
+      gpuResolve(&profiler.gpu[f % PROFILE_GPU_LATENCY], true);
+    }
+    for (int i = 0; i < PROFILE_GPU_LATENCY; i++)
+    {
+      glDeleteQueries(PROFILE_GPU_MAX_INTERVALS * 2, profiler.gpu[i].queries);
+    }
+    profiler.gpu_support = 0;
+  }
+  if (profiler.trace)
+  {
+    fclose(profiler.trace);
+    profiler.trace = NULL;
+  }
+  if (profiler.gpu_dropped > 0)
+  {
+    TraceLog(LOG_INFO, "[Profiler] %llu frames of GPU timings arrived too late",
+             (unsigned long long)profiler.gpu_dropped);
+  }
+}
+
+#if defined(__linux__)
+// perf event counting cache misses, -1 when closed.
+static int cache_miss_fd = -1;
+#endif
+
+bool profilerCacheMissesBegin(void)
+{
+#if defined(__linux__)
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.size = sizeof(attr);
+  attr.config = PERF_COUNT_HW_CACHE_MISSES;
+  attr.disabled = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  long fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+  if (fd < 0)
+  {
+    return false;
+  }
+  cache_miss_fd = (int)fd;
+  ioctl(cache_miss_fd, PERF_EVENT_IOC_RESET, 0);
+  ioctl(cache_miss_fd, PERF_EVENT_IOC_ENABLE, 0);
+  return true;
+#else
+  return false;
+#endif
+}
+
+long long profilerCacheMissesEnd(void)
+{
+#if defined(__linux__)
+  if (cache_miss_fd < 0)
+  {
+    return -1;
+  }
+  ioctl(cache_miss_fd, PERF_EVENT_IOC_DISABLE, 0);
+  long long misses = -1;
+  if (read(cache_miss_fd, &misses, sizeof(misses)) != (ssize_t)sizeof(misses))
+  {
+    misses = -1;
+  }
+  close(cache_miss_fd);
+  cache_miss_fd = -1;
+  return misses;
+#else
+  return -1;
+#endif
+}
+
+void profilerBegin(ProfileSection section)
+{
+  profiler.started[section] = GetTime();
+}
+
+void profilerEnd(ProfileSection section)
+{
+  profiler.frame_ms[section] +=
+      (GetTime() - profiler.started[section]) * 1000.0;
+}
+
+void profilerCount(ProfileCounter counter, double value)
+{
+  profiler.counters[counter] += value;
+}
+
+void profilerCountParticle(const Camera3D *cam, Vector3 pos, float size)
+{
+  if (!is_profiler_enabled)
+    return;
+
+  float dist = fmaxf(Vector3Distance(cam->position, pos), 0.001f);
+  float focal =
+      (float)render_height / (2.0f * tanf(cam->fovy * 0.5f * DEG2RAD));
+  float side = size * focal / dist;
+  profiler.counters[PROFILE_PARTICLE_QUADS] += 1.0;
+  profiler.counters[PROFILE_PARTICLE_PIXELS] += (double)(side * side);
+}
+
+void profilerDraw(int x, int y, int screen_pixels)
+{
+  if (!is_profiler_enabled)
+    return;
+
+  const int font = 16;
+  const int line = font + 4;
+  int gpu_rows = profiler.gpu_support == 1 ? PROFILE_GPU_PASS_COUNT : 1;
+  int rows = PROFILE_SECTION_COUNT + gpu_rows + 6;
+  DrawRectangle(x - 6, y - 6, 260, rows * line + 8, Fade(BLACK, 0.6f));
+
+  for (int i = 0; i < PROFILE_SECTION_COUNT; i++)
+  {
+    DrawText(TextFormat("%-6s %6.2f ms", section_names[i], profiler.avg_ms[i]),
+             x, y + i * line, font, RAYWHITE);
+  }
+  y += PROFILE_SECTION_COUNT * line;
+  if (profiler.gpu_support == 1)
+  {
+    for (int i = 0; i < PROFILE_GPU_PASS_COUNT; i++)
+    {
+      DrawText(TextFormat("gpu %-11s %6.2f ms", gpu_pass_names[i],
+                          profiler.avg_gpu_ms[i]),
+               x, y + i * line, font, SKYBLUE);
+    }
+  }
+  else
+  {
+    DrawText("gpu timers unavailable", x, y, font, GRAY);
+  }
+  y += gpu_rows * line;
+  DrawText(TextFormat("particles %.0f", profiler.avg_counters[PROFILE_PARTICLE_QUADS]),
+           x, y, font, RAYWHITE);
+  double overdraw =
+      screen_pixels > 0
+          ? profiler.avg_counters[PROFILE_PARTICLE_PIXELS] / screen_pixels
+          : 0.0;
+  DrawText(TextFormat("particle overdraw %.2fx", overdraw), x, y + line,
+           font, RAYWHITE);
+  DrawText(TextFormat("lod culled %.0f merged %.0f",
+                      profiler.avg_counters[PROFILE_PARTICLES_CULLED],
+                      profiler.avg_counters[PROFILE_PARTICLES_MERGED]),
+           x, y + 2 * line, font, RAYWHITE);
+  DrawText(TextFormat("lod unspawned %.1f",
+                      profiler.avg_counters[PROFILE_PARTICLES_UNSPAWNED]),
+           x, y + 3 * line, font, RAYWHITE);
+  DrawText(TextFormat("upload %.1f KiB %.0f draws",
+                      profiler.avg_counters[PROFILE_STREAM_BYTES] / 1024.0,
+                      profiler.avg_counters[PROFILE_STREAM_DRAWS]),
+           x, y + 4 * line, font, RAYWHITE);
+  DrawText(TextFormat("ring stalls %.2f spills %.2f",
+                      profiler.avg_counters[PROFILE_STREAM_STALLS],
+                      profiler.avg_counters[PROFILE_STREAM_SPILLS]),
+           x, y + 5 * line, font, RAYWHITE);
+}
@@ -0,0 +1,177 @@
+/**
+ * @file profiler.h
+ * @brief Declares a lightweight per-frame profiler: named CPU sections,
+ * GPU timer queries per render pass, per-frame counters, an on-screen
+ * overlay and a CSV trace export.
+ */
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "raylib.h"
+#include <stdbool.h>
+
+/// Frames a GPU timing result may take to arrive before it is dropped.
+#define PROFILE_GPU_LATENCY 4
+
+/// Timed GPU intervals per frame; nested passes split their parent.
+#define PROFILE_GPU_MAX_INTERVALS 128
+
+/// Maximum nesting depth of GPU passes.
+#define PROFILE_GPU_MAX_DEPTH 8
+
+/**
+ * @brief Timed sections of a frame.
+ */
+typedef enum ProfileSection
+{
+  PROFILE_FRAME = 0, /// Whole frame, BeginDrawing to EndDrawing.
+  PROFILE_SCENE,     /// 3D scene: simulation and drawing.
+  PROFILE_POST,      /// Post-processing (bloom).
+  PROFILE_HUD,       /// 2D overlays.
+  PROFILE_SECTION_COUNT
+} ProfileSection;
+
+/**
+ * @brief Render passes timed on the GPU.
+ *
+ * Time is exclusive: while a nested pass runs (explosions inside ships,
+ * trails inside bullets) it is not counted for the enclosing pass.
+ */
+typedef enum ProfileGpuPass
+{
+  PROFILE_GPU_SHIPS = 0,   /// Enemy and player ship models.
+  PROFILE_GPU_BULLETS,     /// Bullet meshes.
+  PROFILE_GPU_TRAILS,      /// Bullet trail particles.
+  PROFILE_GPU_EXPLOSIONS,  /// Additive hit explosion particles.
+  PROFILE_GPU_SPRITES,     /// Sprite-sheet animations.
+  PROFILE_GPU_TRANSPARENT, /// Depth-sorted alpha particles (stars, smoke).
+  PROFILE_GPU_HUD,         /// 2D overlays.
+  PROFILE_GPU_POST,        /// Post-processing (bloom).
+  PROFILE_GPU_PASS_COUNT
+} ProfileGpuPass;
+
+/**
+ * @brief Values accumulated over a frame.
+ */
+typedef enum ProfileCounter
+{
+  PROFILE_PARTICLE_QUADS = 0, /// Particle billboards submitted.
+  PROFILE_PARTICLE_PIXELS,    /// Estimated pixels covered by particles.
+  PROFILE_PARTICLES_CULLED,   /// Sub-pixel particles skipped by LOD.
+  PROFILE_PARTICLES_MERGED,   /// Tiny particles folded into merged quads.
+  PROFILE_PARTICLES_UNSPAWNED, /// Spawns saved by distant-emitter LOD.
+  PROFILE_STREAM_BYTES,       /// Vertex bytes written to the stream ring.
+  PROFILE_STREAM_DRAWS,       /// Draw calls issued from the stream ring.
+  PROFILE_STREAM_STALLS,      /// Frames that waited for a ring region.
+  PROFILE_STREAM_SPILLS,      /// Frames whose region overflowed to rlgl.
+  PROFILE_COUNTER_COUNT
+} ProfileCounter;
+
+// Global flag: the profiler overlay is visible (--profile, toggled by F3).
+extern bool is_profiler_enabled;
+
+/**
+ * @brief Parses --profile and --profile-trace <file.csv>.
+ *
+ * The trace gets one row per frame with the CPU sections and, once the
+ * queries have resolved a few frames later, the GPU passes of that frame.
+ *
+ * @param argc The count of command-line arguments.
+ * @param argv The array of command-line argument strings.
+ */
+void checkProfilerFlag(int argc, char *argv[]);
+
+/**
+ * @brief Starts a new frame: resets counters and opens PROFILE_FRAME.
+ */
+void profilerBeginFrame(void);
+
+/**
+ * @brief Closes PROFILE_FRAME and folds this frame into the averages.
+ */
+void profilerEndFrame(void);
+
+/**
+ * @brief Starts timing a section.
+ */
+void profilerBegin(ProfileSection section);
+
+/**
+ * @brief Stops timing a section.
+ */
+void profilerEnd(ProfileSection section);
+
+/**
+ * @brief Starts GPU timing of a render pass.
+ *
+ * Flushes the pending rlgl batch so that only this pass's draws fall inside
+ * the interval. Does nothing while the overlay and the trace are off, or
+ * when the GL context has no timer queries.
+ */
+void profilerGpuBegin(ProfileGpuPass pass);
+
+/**
+ * @brief Stops GPU timing of a render pass and resumes the enclosing one.
+ */
+void profilerGpuEnd(ProfileGpuPass pass);
+
+/**
+ * @brief Name of the innermost open render pass, "scene" outside of any.
+ *
+ * Tracked whether or not the GPU is being timed.
+ */
+const char *profilerGpuPassName(void);
+
+/**
+ * @brief Releases the timer queries and closes the trace file.
+ *
+ * Must be called before the GL context is destroyed.
+ */
+void profilerShutdown(void);
+
+/**
+ * @brief Starts counting hardware cache misses of the calling thread.
+ *
+ * Used by the offline benchmarks; Linux perf events only.
+ *
+ * @return False when the counter is unavailable (other platforms, virtual
+ * machines, or perf_event_paranoid forbids it).
+ */
+bool profilerCacheMissesBegin(void);
+
+/**
+ * @brief Stops the counter started by profilerCacheMissesBegin.
+ *
+ * @return Cache misses since the start, or -1 when nothing was counted.
+ */
+long long profilerCacheMissesEnd(void);
+
+/**
+ * @brief Adds to a counter of the current frame.
+ */
+void profilerCount(ProfileCounter counter, double value);
+
+/**
+ * @brief Counts one particle billboard and the pixels it covers.
+ *
+ * Coverage is estimated from the projected size of the quad, which is enough
+ * to compare overdraw between rendering strategies. Does nothing while the
+ * profiler is hidden.
+ *
+ * @param cam Camera the particle is drawn with.
+ * @param pos Particle center.
+ * @param size Particle side length in world units.
+ */
+void profilerCountParticle(const Camera3D *cam, Vector3 pos, float size);
+
+/**
+ * @brief Draws the averaged sections and counters.
+ *
+ * @param x Screen X position.
+ * @param y Screen Y position.
+ * @param screen_pixels Pixels of the frame, used to express coverage as
+ * overdraw (covered pixels per screen pixel).
+ */
+void profilerDraw(int x, int y, int screen_pixels);
+
+#endif
@@ -9,6 +9,8 @@
 
 int resolution_width = 1600;
 int resolution_height = 1200;
+int render_width = 0;
+int render_height = 0;
 
 bool parse_int(const char *s, int *out)
 {
@@ -74,4 +76,45 @@ void checkResolution(int argc, char *argv[])
       break;
     }
   }
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Parses "--render-size WxH" for offline rendering.
+ *
+ * Any size up to MAX_RENDER_SIDE is accepted, independent of the window.
+ *
+ * @param argc Argument count from main.
+ * @param argv Argument vector from main.
+ */
+void checkRenderSize(int argc, char *argv[])
+{
+  for (int i = 1; i < argc - 1; i++)
+  {
+    if (strcmp(argv[i], "--render-size") != 0)
+      continue;
+
+    char buffer[32];
+    strncpy(buffer, argv[i + 1], sizeof(buffer) - 1);
+    buffer[sizeof(buffer) - 1] = '\0';
+    char *sep = strchr(buffer, 'x');
+    int width, height;
+    if (!sep)
+    {
+      TraceLog(LOG_WARNING, "Invalid render size '%s', expected WxH.", argv[i + 1]);
+      return;
+    }
+    *sep = '\0';
+    if (!parse_int(buffer, &width) || !parse_int(sep + 1, &height) ||
+        width <= 0 || height <= 0 || width > MAX_RENDER_SIDE ||
+        height > MAX_RENDER_SIDE)
+    {
+      TraceLog(LOG_WARNING, "Invalid render size '%s', expected WxH up to %d.",
+               argv[i + 1], MAX_RENDER_SIDE);
+      return;
+    }
+    render_width = width;
+    render_height = height;
+    TraceLog(LOG_INFO, "Setting render size to %dx%d", render_width, render_height);
+    return;
+  }
+}
@@ -5,10 +5,16 @@
 extern int resolution_width;
 extern int resolution_height;
 
+// Size of the frame the game draws into: the window, or the off-screen
+// target when rendering offline (--render-size). Zero until resolved.
+extern int render_width;
+extern int render_height;
+
 // Fixed aspect ratio and resolution bounds
 #define WIDTH_HEIGHT_RATIO 0.75f
 #define MIN_WIDTH 640
 #define MAX_WIDTH 3840
+#define MAX_RENDER_SIDE 8192
 
 /**
  * @brief Parses command-line arguments to set the resolution.
@@ -22,4 +28,14 @@ extern int resolution_height;
  */
 void checkResolution(int argc, char *argv[]);
 
+/**
+ * @brief Parses "--render-size WxH" for offline rendering.
+ *
+ * Any size up to MAX_RENDER_SIDE is accepted, independent of the window.
+ *
+ * @param argc Argument count from main.
+ * @param argv Argument vector from main.
+ */
+void checkRenderSize(int argc, char *argv[]);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,352 @@
+/**
+ * @file vecmath.h
+ * @brief Small 4-wide vector and 3x4 affine matrix layer for simulation hot
+ * paths (bounding boxes, particle integration).
+ *
+ * Uses SSE on x86-64, NEON on aarch64 and plain floats otherwise. Values stay
+ * in registers between calls; convert to raylib's Vector3, Matrix and
+ * BoundingBox only at the raylib API boundary. The conventions follow
+ * raymath, so results match it up to float rounding (checked by make bench).
+ */
+#ifndef VECMATH_H
+#define VECMATH_H
+
+#include "raylib.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#define VECMATH_SIMD_NAME "SSE"
+typedef __m128 Vec4;
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define VECMATH_SIMD_NAME "NEON"
+typedef float32x4_t Vec4;
+#else
+#define VECMATH_SIMD_NAME "scalar"
+/**
+ * @brief Four floats (portable fallback).
+ */
+typedef struct
+{
+  float v[4];
+} Vec4;
+#endif
+
+/**
+ * @brief Affine transform as a 3x4 matrix stored by columns: a point p maps
+ * to x * p.x + y * p.y + z * p.z + w. The fourth lane of every column is
+ * unused. Same mapping as raymath's Vector3Transform.
+ */
+typedef struct
+{
+  Vec4 x; /// Image of the X axis.
+  Vec4 y; /// Image of the Y axis.
+  Vec4 z; /// Image of the Z axis.
+  Vec4 w; /// Translation.
+} AffineMatrix;
+
+/**
+ * @brief Builds a vector from four lanes.
+ */
+static inline Vec4 vec4Set(float x, float y, float z, float w)
+{
+#if defined(__SSE__)
+  return _mm_set_ps(w, z, y, x);
+#elif defined(__aarch64__)
+  float lanes[4] = {x, y, z, w};
+  return vld1q_f32(lanes);
+#else
+  return (Vec4){{x, y, z, w}};
+#endif
+}
+
+/**
+ * @brief Builds a vector with every lane set to s.
+ */
+static inline Vec4 vec4Splat(float s)
+{
+#if defined(__SSE__)
+  return _mm_set1_ps(s);
+#elif defined(__aarch64__)
+  return vdupq_n_f32(s);
+#else
+  return (Vec4){{s, s, s, s}};
+#endif
+}
+
+/**
+ * @brief Loads four floats (no alignment needed).
+ */
+static inline Vec4 vec4Load(const float in[4])
+{
+#if defined(__SSE__)
+  return _mm_loadu_ps(in);
+#elif defined(__aarch64__)
+  return vld1q_f32(in);
+#else
+  return (Vec4){{in[0], in[1], in[2], in[3]}};
+#endif
+}
+
+/**
+ * @brief Stores four floats (no alignment needed).
+ */
+static inline void vec4Store(Vec4 v, float out[4])
+{
+#if defined(__SSE__)
+  _mm_storeu_ps(out, v);
+#elif defined(__aarch64__)
+  vst1q_f32(out, v);
+#else
+  for (int i = 0; i < 4; i++)
+  {
+    out[i] = v.v[i];
+  }
+#endif
+}
+
+/**
+ * @brief Lane-wise a + b.
+ */
+static inline Vec4 vec4Add(Vec4 a, Vec4 b)
+{
+#if defined(__SSE__)
+  return _mm_add_ps(a, b);
+#elif defined(__aarch64__)
+  return vaddq_f32(a, b);
+#else
+  return (Vec4){{a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2],
+                 a.v[3] + b.v[3]}};
+#endif
+}
+
+/**
+ * @brief Lane-wise a - b.
+ */
+static inline Vec4 vec4Sub(Vec4 a, Vec4 b)
+{
+#if defined(__SSE__)
+  return _mm_sub_ps(a, b);
+#elif defined(__aarch64__)
+  return vsubq_f32(a, b);
+#else
+  return (Vec4){{a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2],
+                 a.v[3] - b.v[3]}};
+#endif
+}
+
+/**
+ * @brief Lane-wise a * b.
+ */
+static inline Vec4 vec4Mul(Vec4 a, Vec4 b)
+{
+#if defined(__SSE__)
+  return _mm_mul_ps(a, b);
+#elif defined(__aarch64__)
+  return vmulq_f32(a, b);
+#else
+  return (Vec4){{a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2],
+                 a.v[3] * b.v[3]}};
+#endif
+}
+
+/**
+ * @brief Lane-wise a * b + c, rounded after the product (no fused
+ * multiply-add, so results match the scalar code it replaces).
+ */
+static inline Vec4 vec4MulAdd(Vec4 a, Vec4 b, Vec4 c)
+{
+  return vec4Add(vec4Mul(a, b), c);
+}
+
+/**
+ * @brief Lane-wise absolute value.
+ */
+static inline Vec4 vec4Abs(Vec4 v)
+{
+#if defined(__SSE__)
+  return _mm_andnot_ps(_mm_set1_ps(-0.0f), v);
+#elif defined(__aarch64__)
+  return vabsq_f32(v);
+#else
+  return (Vec4){{fabsf(v.v[0]), fabsf(v.v[1]), fabsf(v.v[2]), fabsf(v.v[3])}};
+#endif
+}
+
+/**
+ * @brief Widens a Vector3 with the given fourth lane.
+ */
+static inline Vec4 vec4FromVector3(Vector3 v, float w)
+{
+  return vec4Set(v.x, v.y, v.z, w);
+}
+
+/**
+ * @brief Drops the fourth lane.
+ */
+static inline Vector3 vec4ToVector3(Vec4 v)
+{
+  float lanes[4];
+  vec4Store(v, lanes);
+  return (Vector3){lanes[0], lanes[1], lanes[2]};
+}
+
+/**
+ * @brief Translation by t.
+ */
+static inline AffineMatrix affineTranslate(Vector3 t)
+{
+  return (AffineMatrix){vec4Set(1.0f, 0.0f, 0.0f, 0.0f),
+                        vec4Set(0.0f, 1.0f, 0.0f, 0.0f),
+                        vec4Set(0.0f, 0.0f, 1.0f, 0.0f),
+                        vec4FromVector3(t, 0.0f)};
+}
+
+/**
+ * @brief Rotation around X by angle radians (as MatrixRotateX).
+ */
+static inline AffineMatrix affineRotateX(float angle)
+{
+  float c = cosf(angle);
+  float s = sinf(angle);
+  return (AffineMatrix){vec4Set(1.0f, 0.0f, 0.0f, 0.0f),
+                        vec4Set(0.0f, c, s, 0.0f), vec4Set(0.0f, -s, c, 0.0f),
+                        vec4Splat(0.0f)};
+}
+
+/**
+ * @brief Rotation around Y by angle radians (as MatrixRotateY).
+ */
+static inline AffineMatrix affineRotateY(float angle)
+{
+  float c = cosf(angle);
+  float s = sinf(angle);
+  return (AffineMatrix){vec4Set(c, 0.0f, -s, 0.0f),
+                        vec4Set(0.0f, 1.0f, 0.0f, 0.0f),
+                        vec4Set(s, 0.0f, c, 0.0f), vec4Splat(0.0f)};
+}
+
+/**
+ * @brief Rotation around Z by angle radians (as MatrixRotateZ).
+ */
+static inline AffineMatrix affineRotateZ(float angle)
+{
+  float c = cosf(angle);
+  float s = sinf(angle);
+  return (AffineMatrix){vec4Set(c, s, 0.0f, 0.0f), vec4Set(-s, c, 0.0f, 0.0f),
+                        vec4Set(0.0f, 0.0f, 1.0f, 0.0f), vec4Splat(0.0f)};
+}
+
+/**
+ * @brief Rotation by Euler angles in radians (as MatrixRotateXYZ).
+ */
+static inline AffineMatrix affineRotateXYZ(Vector3 angle)
+{
+  float cz = cosf(-angle.z);
+  float sz = sinf(-angle.z);
+  float cy = cosf(-angle.y);
+  float sy = sinf(-angle.y);
+  float cx = cosf(-angle.x);
+  float sx = sinf(-angle.x);
+  return (AffineMatrix){
+      vec4Set(cz * cy, cz * sy * sx - sz * cx, cz * sy * cx + sz * sx, 0.0f),
+      vec4Set(sz * cy, sz * sy * sx + cz * cx, sz * sy * cx - cz * sx, 0.0f),
+      vec4Set(-sy, cy * sx, cy * cx, 0.0f), vec4Splat(0.0f)};
+}
+
+/**
+ * @brief Applies the linear part of m to the lanes of v (w ignored).
+ */
+static inline Vec4 affineTransformVector(const AffineMatrix *m, Vec4 v)
+{
+#if defined(__SSE__)
+  Vec4 x = _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
+  Vec4 y = _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+  Vec4 z = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+  return vec4MulAdd(m->z, z, vec4MulAdd(m->y, y, vec4Mul(m->x, x)));
+#elif defined(__aarch64__)
+  Vec4 r = vmulq_laneq_f32(m->x, v, 0);
+  r = vaddq_f32(r, vmulq_laneq_f32(m->y, v, 1));
+  return vaddq_f32(r, vmulq_laneq_f32(m->z, v, 2));
+#else
+  Vec4 r;
+  for (int i = 0; i < 4; i++)
+  {
+    r.v[i] = m->x.v[i] * v.v[0] + m->y.v[i] * v.v[1] + m->z.v[i] * v.v[2];
+  }
+  return r;
+#endif
+}
+
+/**
+ * @brief Maps a point through m.
+ */
+static inline Vec4 affineTransformPoint(const AffineMatrix *m, Vec4 p)
+{
+  return vec4Add(affineTransformVector(m, p), m->w);
+}
+
+/**
+ * @brief Composes two transforms: the result applies first, then second
+ * (as MatrixMultiply(first, second)).
+ */
+static inline AffineMatrix affineThen(const AffineMatrix *first,
+                                      const AffineMatrix *second)
+{
+  return (AffineMatrix){affineTransformVector(second, first->x),
+                        affineTransformVector(second, first->y),
+                        affineTransformVector(second, first->z),
+                        affineTransformPoint(second, first->w)};
+}
+
+/**
+ * @brief Maps a batch of points through m.
+ *
+ * @param m Transform.
+ * @param in Points to map.
+ * @param out Mapped points (out); may alias in.
+ * @param count Number of points.
+ */
+static inline void affineTransformPoints(const AffineMatrix *m,
+                                         const Vector3 *in, Vector3 *out,
+                                         size_t count)
+{
+  for (size_t i = 0; i < count; i++)
+  {
+    Vec4 p = vec4FromVector3(in[i], 1.0f);
+    out[i] = vec4ToVector3(affineTransformPoint(m, p));
+  }
+}
+
+/**
+ * @brief Axis-aligned box enclosing a box after it was mapped through m.
+ *
+ * Maps the center and sums the absolute columns weighted by the half
+ * extents, instead of transforming the eight corners; the result is the
+ * same box.
+ *
+ * @param m Transform.
+ * @param min Minimum corner of the box before the transform.
+ * @param max Maximum corner of the box before the transform.
+ * @return Enclosing box after the transform.
+ */
+static inline BoundingBox affineTransformBox(const AffineMatrix *m,
+                                             Vector3 min, Vector3 max)
+{
+  Vec4 lo = vec4FromVector3(min, 0.0f);
+  Vec4 hi = vec4FromVector3(max, 0.0f);
+  Vec4 half = vec4Splat(0.5f);
+  Vec4 center = affineTransformPoint(m, vec4Mul(vec4Add(lo, hi), half));
+  Vec4 extent = vec4Mul(vec4Sub(hi, lo), half);
+  AffineMatrix span = {vec4Abs(m->x), vec4Abs(m->y), vec4Abs(m->z),
+                       vec4Splat(0.0f)};
+  Vec4 reach = affineTransformVector(&span, extent);
+  return (BoundingBox){
+      vec4ToVector3(vec4Sub(center, reach)),
+      vec4ToVector3(vec4Add(center, reach))};
+}
+
+#endif